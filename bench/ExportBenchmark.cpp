@@ -0,0 +1,486 @@
+// @note Every stage of the export pipeline, one at a time, over synthetic meshes, skeletons and animations. Each stage
+// reports the best of [repetitions] runs, and everything goes to a JSON file to diff between revisions.
+// With MXF_TRACK_ALLOCATIONS (on by default) every stage also gets the peak heap and the allocations of its first run.
+// The peak is the heap in use, so the inputs of the stage are part of it.
+//
+//  ExportBenchmark [--preset quick|full] [--repetitions N] [--threads N] [--label text] [--json path]
+//
+// The full preset goes up to 10M vertices, 500 joints and 100k frames, it needs a few GB of memory.
+// Build: cmake (ExportBenchmark target), `cmake --build build --target benchmark` runs the quick preset
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+
+#include "MeshProcessor.h"
+#include "Triangulator.h"
+#include "SkinWeights.h"
+#include "MOF_Writer.h"
+#include "MAF_Writer.h"
+#include "KeyframeReducer.h"
+#include "AnimationCompressor.h"
+#include "MatrixPalette.h"
+#include "ExportReport.h"
+#include "MemoryTracker.h"
+#include "SyntheticMesh.h"
+#include "SyntheticSkeleton.h"
+
+
+enum class MeshKind { Grid, Seams, NGons };
+
+struct MeshCase
+{
+    const char* name;
+    MeshKind    kind;
+    size_t      vertices;     // Approximate, the grids get rounded to a square
+    int         joints;       // 0 = static
+};
+
+struct SkeletonCase
+{
+    const char* name;
+    int         joints;
+};
+
+struct AnimationCase
+{
+    const char* name;
+    int         joints;       // Root excluded
+    int         frames;
+};
+
+struct Result
+{
+    std::string case_;
+    std::string stage;
+    double      seconds;
+    double      items;        // What the throughput is measured in, see unit
+    const char* unit;
+    size_t      bytes;        // Written by the serialization stages, 0 for the rest
+    size_t      vertices, triangles, joints, frames;
+    uint64_t    peakBytes   = 0;
+    uint64_t    allocations = 0;   // Per call
+};
+
+static std::vector<Result> results;
+
+
+static const MeshCase QUICK_MESHES[] =
+{
+    { "grid_10k",         MeshKind::Grid,    10000,  0 },
+    { "seams_100k",       MeshKind::Seams,  100000,  0 },
+    { "ngons_100k",       MeshKind::NGons,  100000,  0 },
+    { "skinned_100k_64",  MeshKind::Grid,   100000, 64 },
+};
+
+static const MeshCase FULL_MESHES[] =
+{
+    { "grid_10k",          MeshKind::Grid,       10000,   0 },
+    { "grid_100k",         MeshKind::Grid,      100000,   0 },
+    { "grid_1m",           MeshKind::Grid,     1000000,   0 },
+    { "grid_10m",          MeshKind::Grid,    10000000,   0 },
+    { "seams_1m",          MeshKind::Seams,    1000000,   0 },
+    { "ngons_1m",          MeshKind::NGons,    1000000,   0 },
+    { "ngons_10m",         MeshKind::NGons,   10000000,   0 },
+    { "skinned_10k_500",   MeshKind::Grid,       10000, 500 },
+    { "skinned_100k_500",  MeshKind::Grid,      100000, 500 },
+    { "skinned_1m_50",     MeshKind::Seams,    1000000,  50 },
+    { "skinned_10m_1",     MeshKind::Grid,    10000000,   1 },
+};
+
+static const SkeletonCase QUICK_SKELETONS[] = { { "joints_1", 1 }, { "joints_64", 64 }, { "joints_500", 500 } };
+static const SkeletonCase FULL_SKELETONS [] = { { "joints_1", 1 }, { "joints_64", 64 }, { "joints_500", 500 } };
+
+static const AnimationCase QUICK_ANIMATIONS[] =
+{
+    { "anim_64x100",   64,  100 },
+    { "anim_64x1000",  64, 1000 },
+};
+
+static const AnimationCase FULL_ANIMATIONS[] =
+{
+    { "anim_1x100",        1,    100 },
+    { "anim_64x1000",     64,   1000 },
+    { "anim_500x10000",  500,  10000 },
+    { "anim_50x100000",   50, 100000 },
+};
+
+
+// Best time of one call to function, out of [repetitions] runs of [inner] calls each, into result.seconds.
+// The memory comes from the first run, the later ones reuse what it already allocated
+static void Measure(Result& result, int repetitions, int inner, const std::function<void()>& function)
+{
+    result.seconds = 1e30;
+    for (int r = 0; r < repetitions; r++)
+    {
+        uint64_t outerPeak   = MemoryTracker::ResetHeapPeak();
+        uint64_t allocations = MemoryTracker::Allocations();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < inner; i++) { function(); }
+        auto end   = std::chrono::high_resolution_clock::now();
+
+        if (r == 0)
+        {
+            result.peakBytes   = MemoryTracker::HeapPeakBytes();
+            result.allocations = (MemoryTracker::Allocations() - allocations) / inner;
+        }
+        MemoryTracker::RestoreHeapPeak(outerPeak);
+
+        result.seconds = std::min(result.seconds, std::chrono::duration<double>(end - start).count() / inner);
+    }
+}
+
+
+// The stages MeshProcessor times itself record their memory into the active report
+static void StageMemory(const ExportReport& report, const char* stage, Result& result)
+{
+    for (const ExportReport::Stage& recorded : report.Stages())
+    {
+        if (recorded.name == stage) { result.peakBytes = recorded.peakBytes; result.allocations = recorded.allocations; }
+    }
+}
+
+
+static size_t FileSize(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? (size_t)file.tellg() : 0;
+}
+
+
+static void Report(const Result& result)
+{
+    results.emplace_back(result);
+
+    std::printf("%-18s %-20s %10.3f ms  %10.2f M%s/s", result.case_.c_str(), result.stage.c_str(), result.seconds * 1e3, result.items / result.seconds * 1e-6, result.unit);
+    if (MemoryTracker::HeapTracking()) { std::printf("  %9.1f MB peak %9llu allocs", result.peakBytes / 1e6, (unsigned long long)result.allocations); }
+    if (result.bytes > 0)              { std::printf("  %8.1f MB  %6.2f GB/s", result.bytes / 1e6, result.bytes / result.seconds * 1e-9); }
+    std::printf("\n");
+}
+
+
+static MeshArrays MakeMesh(const MeshCase& meshCase)
+{
+    switch (meshCase.kind)
+    {
+        case MeshKind::NGons:
+        {
+            const int sides = 8;
+            int       cells = (int)std::ceil(std::sqrt((double)meshCase.vertices / sides));
+            return SyntheticMesh::MakeNGons(cells, cells, sides);
+        }
+
+        default:
+        {
+            int quads = std::max(1, (int)std::lround(std::sqrt((double)meshCase.vertices)) - 1);
+            return SyntheticMesh::MakeGrid(quads, quads, meshCase.kind == MeshKind::Seams ? 8 : 0);
+        }
+    }
+}
+
+
+static void BenchmarkMesh(const MeshCase& meshCase, int repetitions, unsigned int threads)
+{
+    MeshArrays mesh        = MakeMesh(meshCase);
+    size_t     vertexCount = mesh.points.size() / 3;
+    size_t     triangles   = mesh.CornerCount() / 3;
+    Result     base{ meshCase.name, "", 0.0, 0.0, "", 0, vertexCount, triangles, (size_t)meshCase.joints, 0 };
+
+    // ==========================================================================================================
+    // Triangulation
+    // ==========================================================================================================
+    std::vector<int> polygonCounts(mesh.triangleCounts.size());
+    for (size_t p = 0; p < polygonCounts.size(); p++) { polygonCounts[p] = mesh.triangleCounts[p] + 2; }
+
+    std::vector<int> triangleCounts, triangleCorners;
+    Result triangulate = base;
+    triangulate.stage   = "triangulate";
+    Measure(triangulate, repetitions, 1, [&]() { Triangulator::Fan(polygonCounts, triangleCounts, triangleCorners); });
+    triangulate.items   = (double)triangles;
+    triangulate.unit    = "tris";
+    Report(triangulate);
+
+    // ==========================================================================================================
+    // Skin, pruning the dense weight matrix
+    // ==========================================================================================================
+    SkinInfluences skin;
+    if (meshCase.joints > 0)
+    {
+        std::vector<double> weightMatrix = SyntheticSkeleton::MakeWeightMatrix(vertexCount, meshCase.joints, std::min(meshCase.joints, 6));
+
+        Result pack = base;
+        pack.stage   = "skin_pack";
+        Measure(pack, repetitions, 1, [&]() { SkinWeights::PackInfluences(weightMatrix.data(), (unsigned int)vertexCount, (unsigned int)meshCase.joints, 4, skin); });
+        pack.items   = (double)vertexCount;
+        pack.unit    = "verts";
+        Report(pack);
+    }
+
+    // ==========================================================================================================
+    // Weld + vertex build, influence lookup and index optimisation, the stages MeshProcessor times itself
+    // ==========================================================================================================
+    MeshExportSettings settings;
+    settings.deduplicate     = true;
+    settings.optimizeIndices = true;
+    settings.threadCount     = threads;
+
+    MeshData          meshData;
+    MeshProcessReport best;
+    best.weldSeconds = best.weightsSeconds = best.optimizeSeconds = 1e30f;
+
+    Result weld     = base; weld.stage     = "weld";     weld.items     = (double)mesh.CornerCount(); weld.unit     = "corners";
+    Result weights  = base; weights.stage  = "weights";                                             weights.unit  = "verts";
+    Result optimize = base; optimize.stage = "optimize"; optimize.items = (double)triangles;        optimize.unit = "tris";
+
+    for (int r = 0; r < repetitions; r++)
+    {
+        ExportReport        stageReport;
+        ExportReport::Scope stageScope(stageReport);
+
+        MeshProcessReport report;
+        MeshProcessor::Process(mesh, skin, settings, meshData, report);
+
+        best.weldSeconds     = std::min(best.weldSeconds,     report.weldSeconds);
+        best.weightsSeconds  = std::min(best.weightsSeconds,  report.weightsSeconds);
+        best.optimizeSeconds = std::min(best.optimizeSeconds, report.optimizeSeconds);
+
+        if (r == 0)
+        {
+            StageMemory(stageReport, "weld",     weld);
+            StageMemory(stageReport, "weights",  weights);
+            StageMemory(stageReport, "optimize", optimize);
+        }
+    }
+
+    weld.seconds = best.weldSeconds;
+    Report(weld);
+
+    if (meshCase.joints > 0)
+    {
+        weights.seconds = best.weightsSeconds;
+        weights.items   = (double)meshData.vertices.size();
+        Report(weights);
+    }
+
+    optimize.seconds = best.optimizeSeconds;
+    Report(optimize);
+
+    // ==========================================================================================================
+    // Serialization, float stream and compact v2 container
+    // ==========================================================================================================
+    Skeleton        skeleton     = SyntheticSkeleton::MakeSkeleton(std::max(meshCase.joints, 1));
+    const Skeleton* fileSkeleton = (meshCase.joints > 0) ? &skeleton : nullptr;
+
+    const std::string path = std::string("ExportBenchmark_") + meshCase.name + ".mof";
+
+    Result writeStream = base;
+    writeStream.stage   = "write_mof";
+    Measure(writeStream, repetitions, 1, [&]() { MOF_Writer::WriteBinary(path, meshData, fileSkeleton); });
+    writeStream.items   = (double)meshData.vertices.size();
+    writeStream.unit    = "verts";
+    writeStream.bytes   = FileSize(path);
+    Report(writeStream);
+
+    MeshData compact = meshData;
+    compact.format   = VertexFormat::Build(meshData.format.attributeMask, VertexLayout::Compact, meshData.format.maxInfluences);
+
+    Result writeContainer = base;
+    writeContainer.stage   = "write_mof_v2";
+    Measure(writeContainer, repetitions, 1, [&]() { MOF_Writer::WriteChunked(path, compact, fileSkeleton); });
+    writeContainer.items   = (double)meshData.vertices.size();
+    writeContainer.unit    = "verts";
+    writeContainer.bytes   = FileSize(path);
+    Report(writeContainer);
+
+    std::remove(path.c_str());
+}
+
+
+static void BenchmarkSkeleton(const SkeletonCase& skeletonCase, int repetitions)
+{
+    Skeleton skeleton = SyntheticSkeleton::MakeSkeleton(skeletonCase.joints);
+
+    // Tiny, so a few thousand resolutions per run
+    Result hierarchy{ skeletonCase.name, "hierarchy", 0.0, (double)skeletonCase.joints, "joints", 0, 0, 0, (size_t)skeletonCase.joints, 0 };
+    Measure(hierarchy, repetitions, 1000, [&]() { skeleton.LinkChildren(); });
+    Report(hierarchy);
+}
+
+
+static void BenchmarkAnimation(const AnimationCase& animationCase, int repetitions, unsigned int threads)
+{
+    uint32_t jointCount = (uint32_t)animationCase.joints + 1;
+
+    std::vector<std::vector<Transform>> tracks = SyntheticSkeleton::MakeTracks((int)jointCount, animationCase.frames);
+
+    AnimationClip clip;
+    clip.jointCount = jointCount;
+    clip.frameCount = (uint32_t)animationCase.frames;
+    clip.transforms.resize((size_t)clip.frameCount * clip.jointCount);
+
+    double samples = (double)clip.transforms.size();
+    Result base{ animationCase.name, "", 0.0, samples, "samples", 0, 0, 0, (size_t)animationCase.joints, (size_t)animationCase.frames };
+
+    // The sampled per joint tracks into the frame major clip
+    Result keyframes = base;
+    keyframes.stage   = "keyframes";
+    Measure(keyframes, repetitions, 1, [&]()
+    {
+        for (uint32_t j = 0; j < jointCount; j++) { clip.SetTrack(j, tracks[j].data()); }
+    });
+    Report(keyframes);
+
+    const std::string path = std::string("ExportBenchmark_") + animationCase.name + ".maf";
+
+    Result write = base;
+    write.stage   = "write_maf";
+    Measure(write, repetitions, 1, [&]() { MAF_Writer::WriteBinary(path, clip); });
+    write.bytes   = FileSize(path);
+    Report(write);
+
+    // Every frame again, track major in blocks of 64 frames
+    Result writeSegmented = base;
+    writeSegmented.stage  = "write_maf_segmented";
+    Measure(writeSegmented, repetitions, 1, [&]() { MAF_Writer::WriteSegmented(path, clip, 64); });
+    writeSegmented.bytes  = FileSize(path);
+    Report(writeSegmented);
+
+    // Keyframe reduction with the default tolerances, and the sparse file it writes
+    ReducedClip reduced;
+
+    Result reduce = base;
+    reduce.stage  = "reduce";
+    Measure(reduce, repetitions, 1, [&]() { KeyframeReducer::Reduce(clip, KeyframeReducer::Tolerance{}, reduced, threads); });
+    Report(reduce);
+
+    Result writeReduced = base;
+    writeReduced.stage  = "write_maf_reduced";
+    Measure(writeReduced, repetitions, 1, [&]() { MAF_Writer::WriteReduced(path, reduced); });
+    writeReduced.bytes  = FileSize(path);
+    Report(writeReduced);
+
+    // Quantized keys with the default threshold, measured through the synthetic hierarchy
+    std::vector<int> parents = SyntheticSkeleton::MakeSkeleton(animationCase.joints).ClipParents();
+    CompressedClip   compressed;
+
+    Result compress = base;
+    compress.stage  = "compress";
+    Measure(compress, repetitions, 1, [&]() { AnimationCompressor::Compress(reduced, parents, AnimationCompressor::Settings{}, compressed, threads); });
+    Report(compress);
+
+    Result writeCompressed = base;
+    writeCompressed.stage  = "write_maf_compressed";
+    Measure(writeCompressed, repetitions, 1, [&]() { MAF_Writer::WriteCompressed(path, compressed); });
+    writeCompressed.bytes  = FileSize(path);
+    Report(writeCompressed);
+
+    // Skinning matrices against the synthetic bind pose, and the half precision palette file
+    Skeleton               bindSkeleton = SyntheticSkeleton::MakeSkeleton(animationCase.joints);
+    std::vector<Transform> bindPose(jointCount);
+    std::vector<Affine>    inverseBind;
+    PaletteClip            palette;
+
+    bindPose[0] = bindSkeleton.rootBindPose;
+    for (size_t j = 0; j < bindSkeleton.joints.size(); j++) { bindPose[j + 1] = bindSkeleton.joints[j].bindPose; }
+    MatrixPalette::InverseBind(bindPose, parents, inverseBind);
+
+    Result bake = base;
+    bake.stage  = "bake_palette";
+    Measure(bake, repetitions, 1, [&]() { MatrixPalette::Bake(clip, parents, inverseBind, palette, threads); });
+    Report(bake);
+
+    Result writePalette = base;
+    writePalette.stage  = "write_maf_palette";
+    Measure(writePalette, repetitions, 1, [&]() { MAF_Writer::WritePalette(path, palette, true); });
+    writePalette.bytes  = FileSize(path);
+    Report(writePalette);
+
+    std::remove(path.c_str());
+}
+
+
+static bool WriteJson(const std::string& path, const std::string& label, const std::string& preset, int repetitions, unsigned int threads)
+{
+    std::ofstream file(path, std::ios::out);
+    if (!file.is_open()) { return false; }
+
+    file.precision(9);
+    file << "{\n";
+    file << "  \"label\": \""       << label       << "\",\n";
+    file << "  \"preset\": \""      << preset      << "\",\n";
+    file << "  \"repetitions\": "   << repetitions << ",\n";
+    file << "  \"threads\": "       << threads     << ",\n";
+    file << "  \"heapTracking\": "  << (MemoryTracker::HeapTracking() ? "true" : "false") << ",\n";
+    file << "  \"results\": [\n";
+
+    for (size_t r = 0; r < results.size(); r++)
+    {
+        const Result& result = results[r];
+        file << "    { \"case\": \"" << result.case_ << "\", \"stage\": \"" << result.stage << "\""
+             << ", \"seconds\": "    << result.seconds
+             << ", \"items\": "      << (size_t)result.items << ", \"unit\": \"" << result.unit << "\""
+             << ", \"itemsPerSecond\": " << result.items / result.seconds
+             << ", \"bytes\": "      << result.bytes
+             << ", \"vertices\": "   << result.vertices << ", \"triangles\": " << result.triangles
+             << ", \"joints\": "     << result.joints   << ", \"frames\": "    << result.frames
+             << ", \"peakBytes\": "  << result.peakBytes << ", \"allocations\": " << result.allocations << " }"
+             << (r + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    file << "  ]\n}\n";
+    return file.good();
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string  preset      = "quick";
+    std::string  label       = "";
+    std::string  jsonPath    = "ExportBenchmark.json";
+    int          repetitions = 3;
+    unsigned int threads     = 0;
+
+    for (int a = 1; a < argc; a++)
+    {
+        if      (!std::strcmp(argv[a], "--preset")      && a + 1 < argc) { preset      = argv[++a]; }
+        else if (!std::strcmp(argv[a], "--label")       && a + 1 < argc) { label       = argv[++a]; }
+        else if (!std::strcmp(argv[a], "--json")        && a + 1 < argc) { jsonPath    = argv[++a]; }
+        else if (!std::strcmp(argv[a], "--repetitions") && a + 1 < argc) { repetitions = std::max(1, std::atoi(argv[++a])); }
+        else if (!std::strcmp(argv[a], "--threads")     && a + 1 < argc) { threads     = (unsigned int)std::atoi(argv[++a]); }
+        else
+        {
+            std::printf("Usage: ExportBenchmark [--preset quick|full] [--repetitions N] [--threads N] [--label text] [--json path]\n");
+            return 1;
+        }
+    }
+
+    bool full = (preset == "full");
+    if (!full && preset != "quick") { std::printf("Unknown preset %s\n", preset.c_str()); return 1; }
+
+    if (full)
+    {
+        for (const MeshCase&      meshCase      : FULL_MESHES)      { BenchmarkMesh     (meshCase, repetitions, threads); }
+        for (const SkeletonCase&  skeletonCase  : FULL_SKELETONS)   { BenchmarkSkeleton (skeletonCase, repetitions); }
+        for (const AnimationCase& animationCase : FULL_ANIMATIONS)  { BenchmarkAnimation(animationCase, repetitions, threads); }
+    }
+    else
+    {
+        for (const MeshCase&      meshCase      : QUICK_MESHES)     { BenchmarkMesh     (meshCase, repetitions, threads); }
+        for (const SkeletonCase&  skeletonCase  : QUICK_SKELETONS)  { BenchmarkSkeleton (skeletonCase, repetitions); }
+        for (const AnimationCase& animationCase : QUICK_ANIMATIONS) { BenchmarkAnimation(animationCase, repetitions, threads); }
+    }
+
+    if (!WriteJson(jsonPath, label, preset, repetitions, threads)) { std::printf("Couldn't write %s\n", jsonPath.c_str()); return 1; }
+    std::printf("Results written to %s\n", jsonPath.c_str());
+
+    return 0;
+}
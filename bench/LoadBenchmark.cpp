@@ -0,0 +1,240 @@
+// @note Load throughput of the reader library on big generated files. Every file gets written with the same layout the
+// exporter uses, then opened (map + validation) and walked end to end so every page really gets touched.
+// The baseline reads the same file into a std::vector with std::ifstream.
+// Build: g++ -O2 -std=c++20 -pthread -Isrc -Ireader bench/LoadBenchmark.cpp reader/*.cpp src/BinaryWriter.cpp src/ChunkWriter.cpp src/VertexFormat.cpp src/VertexQuantizer.cpp -o LoadBenchmark
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "BinaryWriter.h"
+#include "ChunkWriter.h"
+#include "VertexFormat.h"
+#include "MOF_Format.h"
+#include "MeshFile.h"
+#include "AnimationFile.h"
+
+
+static std::vector<Vertex> MakeVertices(size_t count, int influences, SkinInfluences& skin)
+{
+    std::vector<Vertex> vertices(count);
+
+    skin.maxInfluences = influences;
+    skin.jointIDs.resize(count * influences);
+    skin.weights .resize(count * influences);
+
+    for (size_t v = 0; v < count; v++)
+    {
+        Vertex& vertex = vertices[v];
+        float   t      = (float)v / (float)count;
+
+        vertex.position[0] = t * 100.0f;
+        vertex.position[1] = (float)(v % 1024) * 0.01f;
+        vertex.position[2] = (float)(v / 1024) * 0.01f;
+        vertex.color   [0] = vertex.color[1] = vertex.color[2] = t;
+        vertex.normal  [2] = 1.0f;
+        vertex.uv[0][0]    = t;
+        vertex.uv[0][1]    = 1.0f - t;
+        vertex.vertexID    = (int)v;
+
+        for (int i = 0; i < influences; i++)
+        {
+            skin.jointIDs[v * influences + i] = (int)((v + i) % 64);
+            skin.weights [v * influences + i] = 1.0f / (float)influences;
+        }
+    }
+
+    return vertices;
+}
+
+
+static std::vector<int> MakeIndices(size_t vertexCount, size_t triangleCount)
+{
+    std::vector<int> indices(triangleCount * 3);
+    for (size_t i = 0; i < indices.size(); i++) { indices[i] = (int)((i * 7919) % vertexCount); }
+    return indices;
+}
+
+
+// Same bytes as MOF_Generator::WriteFile for a skinned mesh with every legacy channel, 64 joints in a chain
+static void WriteStreamMesh(const std::string& path, const std::vector<Vertex>& vertices, const SkinInfluences& skin, const std::vector<int>& indices)
+{
+    uint32_t                 mask   = VertexFormat::AttributeMask(true, 1, true);
+    VertexFormat::Descriptor format = VertexFormat::Build(mask, VertexLayout::Float, skin.maxInfluences);
+
+    BinaryWriter writer(vertices.size() * format.stride + indices.size() * sizeof(int) + 64 * 1024);
+    writer.Write((int)vertices.size());
+    writer.Write((int)(format.stride / sizeof(float)));
+    VertexFormat::PackVertices(vertices, &skin, format, {}, writer.Allocate(vertices.size() * format.stride));
+    writer.Write((int)indices.size());
+    writer.WriteArray(indices.data(), indices.size());
+
+    float transform[13] = { 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0 };
+    writer.Write((int)64);
+    for (int j = 0; j < 64; j++)
+    {
+        std::string name = "joint" + std::to_string(j);
+        writer.WriteString(name.c_str());
+        writer.Write(j);
+        writer.Write(std::max(j - 1, 0));
+        writer.Write((int)(j < 63 ? 1 : 0));
+        if (j < 63) { writer.Write(j + 1); }
+        writer.WriteArray(transform, 13);
+    }
+
+    writer.SaveToFile(path);
+}
+
+
+static void WriteContainerMesh(const std::string& path, const std::vector<Vertex>& vertices, const SkinInfluences& skin, const std::vector<int>& indices)
+{
+    uint32_t                            mask   = VertexFormat::AttributeMask(true, 1, true);
+    VertexFormat::Descriptor            format = VertexFormat::Build(mask, VertexLayout::Compact, skin.maxInfluences);
+    VertexQuantizer::QuantizationBounds bounds = VertexQuantizer::ComputeBounds(vertices, format.uvSetCount);
+
+    ChunkWriter container(MOF_Format::MAGIC, MOF_Format::VERSION);
+
+    MOF_Format::VertexFormatRecord record{ (int32_t)format.layout, (int32_t)format.stride, format.attributeMask, format.maxInfluences, format.uvSetCount, (int32_t)format.streams.size() };
+    BinaryWriter& formatChunk = container.AddChunk(MOF_Format::CHUNK_VERTEX_FORMAT);
+    formatChunk.Write(record);
+    formatChunk.WriteArray(format.streams.data(), format.streams.size());
+
+    container.AddChunk(MOF_Format::CHUNK_BOUNDS).Write(bounds);
+
+    BinaryWriter& vertexChunk = container.AddChunk(MOF_Format::CHUNK_VERTICES, format.stride, vertices.size() * format.stride);
+    VertexFormat::PackVertices(vertices, &skin, format, bounds, vertexChunk.Allocate(vertices.size() * format.stride));
+
+    container.AddChunk(MOF_Format::CHUNK_INDICES, sizeof(int32_t)).WriteArray(indices.data(), indices.size());
+    container.SaveToFile(path);
+}
+
+
+static void WriteAnimation(const std::string& path, int joints, int frames)
+{
+    BinaryWriter writer(12 + (size_t)joints * frames * sizeof(TransformRecord));
+    writer.Write(joints);
+    writer.Write(frames);
+    writer.Write(30.0f);
+
+    TransformRecord* transforms = reinterpret_cast<TransformRecord*>(writer.Allocate((size_t)joints * frames * sizeof(TransformRecord)));
+    for (size_t t = 0; t < (size_t)joints * frames; t++) { transforms[t] = TransformRecord{ { (float)t, 0, 0 }, { 0, 0, 0, 1 }, { 1, 1, 1 }, { 0, 0, 0 } }; }
+
+    writer.SaveToFile(path);
+}
+
+
+// Reads every 8 bytes so the whole range has to come from memory
+static uint64_t Touch(const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t             sum   = 0;
+
+    size_t words = size / sizeof(uint64_t);
+    for (size_t w = 0; w < words; w++)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + w * sizeof(uint64_t), sizeof(uint64_t));
+        sum += word;
+    }
+
+    for (size_t b = words * sizeof(uint64_t); b < size; b++) { sum += bytes[b]; }
+    return sum;
+}
+
+
+static size_t FileSize(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return (size_t)file.tellg();
+}
+
+
+template <typename Function>
+static double BestSeconds(int repetitions, Function function)
+{
+    double best = 1e30;
+    for (int r = 0; r < repetitions; r++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        function();
+        auto end   = std::chrono::high_resolution_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+
+static uint64_t sink = 0;
+
+static bool BenchmarkMesh(const char* label, const std::string& path, int repetitions)
+{
+    size_t size = FileSize(path);
+    bool   ok   = true;
+
+    double mapped = BestSeconds(repetitions, [&]()
+    {
+        MeshFile mesh;
+        if (!mesh.Open(path)) { std::printf("%s: %s\n", label, mesh.Error().c_str()); ok = false; return; }
+
+        sink += Touch(mesh.Vertices().data(), mesh.Vertices().size_bytes());
+        sink += Touch(mesh.Indices32().data(), mesh.Indices32().size_bytes());
+        sink += Touch(mesh.Indices16().data(), mesh.Indices16().size_bytes());
+        sink += mesh.Joints().size();
+    });
+
+    double stream = BestSeconds(repetitions, [&]()
+    {
+        std::ifstream              file(path, std::ios::binary);
+        std::vector<unsigned char> bytes(size);
+        file.read(reinterpret_cast<char*>(bytes.data()), (std::streamsize)size);
+        sink += Touch(bytes.data(), bytes.size());
+    });
+
+    std::printf("%-22s %8.1f MB   mapped %6.2f GB/s   ifstream %6.2f GB/s\n", label, size / 1e6, size / mapped * 1e-9, size / stream * 1e-9);
+    return ok;
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t vertexCount = (argc > 1) ? (size_t)std::atoll(argv[1]) : 2000000;
+    int    repetitions = (argc > 2) ? std::atoi(argv[2]) : 5;
+    int    influences  = 4;
+
+    SkinInfluences      skin;
+    std::vector<Vertex> vertices = MakeVertices(vertexCount, influences, skin);
+    std::vector<int>    indices  = MakeIndices(vertexCount, vertexCount * 2);
+
+    WriteStreamMesh   ("LoadBenchmark_stream.mof",    vertices, skin, indices);
+    WriteContainerMesh("LoadBenchmark_container.mof", vertices, skin, indices);
+    WriteAnimation    ("LoadBenchmark.maf", 128, (int)std::max<size_t>(vertexCount / 512, 1));
+
+    bool ok = true;
+    ok &= BenchmarkMesh("MOF float stream",    "LoadBenchmark_stream.mof",    repetitions);
+    ok &= BenchmarkMesh("MOF v2 compact",      "LoadBenchmark_container.mof", repetitions);
+
+    size_t animationSize = FileSize("LoadBenchmark.maf");
+    double animation     = BestSeconds(repetitions, [&]()
+    {
+        AnimationFile clip;
+        if (!clip.Open("LoadBenchmark.maf")) { std::printf("MAF: %s\n", clip.Error().c_str()); ok = false; return; }
+
+        sink += Touch(clip.Transforms().data(), clip.Transforms().size_bytes());
+    });
+
+    std::printf("%-22s %8.1f MB   mapped %6.2f GB/s\n", "MAF", animationSize / 1e6, animationSize / animation * 1e-9);
+    std::printf("(checksum %llu)\n", (unsigned long long)sink);
+
+    std::remove("LoadBenchmark_stream.mof");
+    std::remove("LoadBenchmark_container.mof");
+    std::remove("LoadBenchmark.maf");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+#include "MeshArrays.h"
+
+// @note Synthetic meshes for the benchmarks, laid out exactly as MOF_Generator::ExtractMeshArrays would leave them
+namespace SyntheticMesh
+{
+    // Grid of [quadsX * quadsY] quads split in two triangles.
+    // - Every [seamEvery] columns the UVs are split, so the corners along that column don't weld (0 = no seams)
+    // - Normals are normalised per face from differently scaled vectors, so corners of the same vertex end up with normals 
+    //   that are equal up to the last couple of bits. The same happens in Maya with world space normals of smooth meshes
+    // - The first row sits exactly on y = -0.0
+    inline MeshArrays MakeGrid(int quadsX, int quadsY, int seamEvery)
+    {
+        MeshArrays mesh;
+
+        int vertsX = quadsX + 1;
+        int vertsY = quadsY + 1;
+
+        mesh.points.reserve((size_t)vertsX * vertsY * 3);
+        for (int y = 0; y < vertsY; y++)
+        {
+            for (int x = 0; x < vertsX; x++)
+            {
+                mesh.points.push_back((float)x * 0.01f);
+                mesh.points.push_back(y == 0 ? -0.0f : (float)y * 0.01f);
+                mesh.points.push_back(std::sin((float)x * 0.05f) * std::cos((float)y * 0.05f));
+            }
+        }
+
+        // UVs, one extra column per seam
+        int seams = (seamEvery > 0) ? quadsX / seamEvery : 0;
+        int uvsX  = vertsX + seams;
+
+        mesh.uvSets.emplace_back();
+        UVSet& uvSet = mesh.uvSets.back();
+        for (int y = 0; y < vertsY; y++)
+        {
+            for (int x = 0; x < uvsX; x++)
+            {
+                uvSet.us.push_back((float)x / (float)uvsX);
+                uvSet.vs.push_back((float)y / (float)vertsY);
+            }
+        }
+
+        auto uvID = [&](int x, int y, int quadX) 
+        {
+            int seamShift = (seamEvery > 0) ? quadX / seamEvery : 0;
+            return y * uvsX + x + seamShift;
+        };
+
+        for (int y = 0; y < quadsY; y++)
+        {
+            for (int x = 0; x < quadsX; x++)
+            {
+                int quadVerts[4] = { y * vertsX + x, y * vertsX + x + 1, (y + 1) * vertsX + x + 1, (y + 1) * vertsX + x };
+                int quadUVs  [4] = { uvID(x, y, x), uvID(x + 1, y, x), uvID(x + 1, y + 1, x), uvID(x, y + 1, x) };
+
+                int faceVertexBase = (int)mesh.faceVertexIDs.size();
+
+                for (int c = 0; c < 4; c++)
+                {
+                    // Same direction for every face, the lowest bits change with the scale
+                    float scale  = 1.0f + (float)((x + y) % 7) * 0.37f;
+                    float nx     = 0.2f * scale;
+                    float nz     = 0.9f * scale;
+                    float length = std::sqrt(nx * nx + nz * nz);
+                    mesh.normals.push_back(nx / length);
+                    mesh.normals.push_back(0.0f);
+                    mesh.normals.push_back(nz / length);
+
+                    mesh.faceVertexIDs      .push_back(quadVerts[c]);
+                    mesh.faceVertexNormalIDs.push_back((int)(mesh.normals.size() / 3) - 1);
+                    uvSet.faceVertexUVIDs   .push_back(quadUVs[c]);
+                }
+
+                mesh.triangleCounts.push_back(2);
+                int triangles[6] = { 0, 1, 2, 0, 2, 3 };
+                for (int t : triangles) { mesh.triangleCorners.push_back(faceVertexBase + t); }
+            }
+        }
+
+        return mesh;
+    }
+
+    // Grid of [cellsX * cellsY] convex polygons with [sides] corners each, every one with its own vertices, UVs and a
+    // single face normal. Fan triangulated, the way Maya triangulates convex n-gons
+    inline MeshArrays MakeNGons(int cellsX, int cellsY, int sides)
+    {
+        MeshArrays mesh;
+
+        size_t polygons = (size_t)cellsX * cellsY;
+        mesh.points             .reserve(polygons * sides * 3);
+        mesh.faceVertexIDs      .reserve(polygons * sides);
+        mesh.faceVertexNormalIDs.reserve(polygons * sides);
+        mesh.triangleCorners    .reserve(polygons * (sides - 2) * 3);
+
+        mesh.uvSets.emplace_back();
+        UVSet& uvSet = mesh.uvSets.back();
+
+        for (int y = 0; y < cellsY; y++)
+        {
+            for (int x = 0; x < cellsX; x++)
+            {
+                int faceVertexBase = (int)mesh.faceVertexIDs.size();
+                int normalID       = (int)(mesh.normals.size() / 3);
+
+                mesh.normals.push_back(0.0f);
+                mesh.normals.push_back(0.0f);
+                mesh.normals.push_back(1.0f);
+
+                for (int c = 0; c < sides; c++)
+                {
+                    float angle = 6.2831853f * (float)c / (float)sides;
+                    float px    = std::cos(angle) * 0.4f;
+                    float py    = std::sin(angle) * 0.4f;
+
+                    int vertexID = (int)(mesh.points.size() / 3);
+                    mesh.points.push_back(((float)x + 0.5f + px) * 0.01f);
+                    mesh.points.push_back(((float)y + 0.5f + py) * 0.01f);
+                    mesh.points.push_back(0.0f);
+
+                    uvSet.us.push_back(0.5f + px);
+                    uvSet.vs.push_back(0.5f + py);
+
+                    mesh.faceVertexIDs      .push_back(vertexID);
+                    mesh.faceVertexNormalIDs.push_back(normalID);
+                    uvSet.faceVertexUVIDs   .push_back(vertexID);
+                }
+
+                mesh.triangleCounts.push_back(sides - 2);
+                for (int t = 0; t < sides - 2; t++)
+                {
+                    mesh.triangleCorners.push_back(faceVertexBase);
+                    mesh.triangleCorners.push_back(faceVertexBase + t + 1);
+                    mesh.triangleCorners.push_back(faceVertexBase + t + 2);
+                }
+            }
+        }
+
+        return mesh;
+    }
+}
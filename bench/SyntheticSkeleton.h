@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+
+#include "Skeleton.h"
+
+// @note Synthetic skeletons, skin weights and joint tracks for the benchmarks
+namespace SyntheticSkeleton
+{
+    // [joints] joints below the root, every joint has up to 4 children so deep and wide hierarchies both show up
+    inline Skeleton MakeSkeleton(int joints)
+    {
+        Skeleton skeleton;
+        skeleton.rootName = "root";
+        skeleton.joints.resize(joints);
+
+        for (int j = 0; j < joints; j++)
+        {
+            SkeletonJoint& joint = skeleton.joints[j];
+            joint.name                 = "joint" + std::to_string(j);
+            joint.parentID             = (j == 0) ? -1 : (j - 1) / 4;
+            joint.influenceID          = j;
+            joint.bindPose.position[1] = 1.0f;
+        }
+
+        skeleton.LinkChildren();
+        return skeleton;
+    }
+
+    // Vertex major [vertexCount * joints] matrix like MFnSkinCluster::getWeights, [influences] non-zero weights per vertex
+    // on neighbouring joints so the heaviest ones change from vertex to vertex
+    inline std::vector<double> MakeWeightMatrix(size_t vertexCount, int joints, int influences)
+    {
+        std::vector<double> weights(vertexCount * joints, 0.0);
+
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            double* vertexWeights = &weights[v * joints];
+            int     first         = (int)((v / 64) % (size_t)joints);
+
+            for (int i = 0; i < influences; i++)
+            {
+                vertexWeights[(first + i) % joints] += 1.0 / (double)(i + 1 + (v % 3));
+            }
+        }
+
+        return weights;
+    }
+
+    // Joint major tracks, [jointCount] tracks of [frames] transforms. Smooth curves, like sampled animation
+    inline std::vector<std::vector<Transform>> MakeTracks(int jointCount, int frames)
+    {
+        std::vector<std::vector<Transform>> tracks(jointCount, std::vector<Transform>(frames));
+
+        for (int j = 0; j < jointCount; j++)
+        {
+            for (int f = 0; f < frames; f++)
+            {
+                float      angle     = 0.01f * f + 0.1f * j;
+                Transform& transform = tracks[j][f];
+
+                transform.position[0] = std::sin(angle);
+                transform.position[1] = 1.0f;
+                transform.rotation[2] = std::sin(angle * 0.5f);
+                transform.rotation[3] = std::cos(angle * 0.5f);
+            }
+        }
+
+        return tracks;
+    }
+}
@@ -0,0 +1,143 @@
+// @note Compares the old std::unordered_map<Vertex, int> dedup against the quantized WeldTable, serial and parallel.
+// The parallel runs are checked against the serial one, they must match byte by byte.
+// Build: g++ -O2 -std=c++20 -pthread -Isrc bench/WeldBenchmark.cpp src/Welder.cpp -o WeldBenchmark
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+
+#include "Welder.h"
+#include "SyntheticMesh.h"
+
+
+// Replica of the Vertex / std::hash<Vertex> pair the exporter used before the WeldTable.
+// Exact bit hashing on doubles and floats, 1e-6 tolerance on the comparison.
+struct LegacyVertex
+{
+    double position[3];
+    float  color   [3];
+    float  normal  [3];
+    float  u;
+    float  v;
+    int    vertexID;
+
+    bool operator == (const LegacyVertex& other) const
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            if (std::fabs(position[i] - other.position[i]) > 1e-6) { return false; }
+            if (std::fabs(color   [i] - other.color   [i]) > 1e-6f) { return false; }
+            if (std::fabs(normal  [i] - other.normal  [i]) > 1e-6f) { return false; }
+        }
+
+        return std::fabs(u - other.u) < 1e-6f && std::fabs(v - other.v) < 1e-6f && vertexID == other.vertexID;
+    }
+};
+
+struct LegacyHash
+{
+    size_t operator()(const LegacyVertex& v) const
+    {
+        auto customHash = [](size_t& seed, size_t value) { seed ^= value + 1954435769U + (seed << 6) + (seed >> 2); };
+
+        size_t seed = 0;
+        for (int i = 0; i < 3; i++) { customHash(seed, std::hash<double>{}(v.position[i])); }
+        for (int i = 0; i < 3; i++) { customHash(seed, std::hash<float> {}(v.color   [i])); }
+        for (int i = 0; i < 3; i++) { customHash(seed, std::hash<float> {}(v.normal  [i])); }
+        customHash(seed, std::hash<float>{}(v.u));
+        customHash(seed, std::hash<float>{}(v.v));
+        customHash(seed, std::hash<int>  {}(v.vertexID));
+        return seed;
+    }
+};
+
+
+static size_t LegacyWeld(const MeshArrays& mesh, std::vector<int>& indices)
+{
+    std::unordered_map<LegacyVertex, int, LegacyHash> hashedVertices;
+    int counter = 0;
+
+    indices.clear();
+    for (size_t corner = 0; corner < mesh.CornerCount(); corner++)
+    {
+        int faceVertex = mesh.triangleCorners[corner];
+        int vertexID   = mesh.faceVertexIDs[faceVertex];
+        int normalID   = mesh.faceVertexNormalIDs[faceVertex];
+        int uvID       = mesh.uvSets[0].faceVertexUVIDs[faceVertex];
+
+        LegacyVertex vert{};
+        for (int i = 0; i < 3; i++)
+        {
+            vert.position[i] = mesh.points [vertexID * 3 + i];
+            vert.normal  [i] = mesh.normals[normalID * 3 + i];
+            vert.color   [i] = 1.0f;
+        }
+        vert.u        = mesh.uvSets[0].us[uvID];
+        vert.v        = mesh.uvSets[0].vs[uvID];
+        vert.vertexID = -1;
+
+        // Same access pattern as the old exporter: contains, operator[], operator[]
+        if (!hashedVertices.contains(vert)) { hashedVertices[vert] = counter++; }
+        indices.emplace_back(hashedVertices[vert]);
+    }
+
+    return hashedVertices.size();
+}
+
+
+int main(int argc, char** argv)
+{
+    int quads     = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    int seamEvery = (argc > 2) ? std::atoi(argv[2]) : 16;
+
+    MeshArrays mesh    = SyntheticMesh::MakeGrid(quads, quads, seamEvery);
+    size_t     corners = mesh.CornerCount();
+
+    std::vector<int> indices, uniqueCorners;
+
+    auto   legacyStart  = std::chrono::high_resolution_clock::now();
+    size_t legacyUnique = LegacyWeld(mesh, indices);
+    auto   legacyEnd    = std::chrono::high_resolution_clock::now();
+
+    auto   tableStart   = std::chrono::high_resolution_clock::now();
+    Welder::WeldCornersSerial(mesh, false, WeldSettings{}, indices, uniqueCorners);
+    auto   tableEnd     = std::chrono::high_resolution_clock::now();
+    size_t tableUnique  = uniqueCorners.size();
+
+    double legacySeconds = std::chrono::duration<double>(legacyEnd - legacyStart).count();
+    double tableSeconds  = std::chrono::duration<double>(tableEnd  - tableStart ).count();
+
+    std::printf("Corners        %zu (%d x %d quads, seam every %d columns)\n", corners, quads, quads, seamEvery);
+    std::printf("unordered_map  unique %10zu  weld ratio %6.3f  %8.2f Mcorners/s\n", legacyUnique, (double)corners / legacyUnique, corners / legacySeconds * 1e-6);
+    std::printf("WeldTable      unique %10zu  weld ratio %6.3f  %8.2f Mcorners/s\n", tableUnique,  (double)corners / tableUnique,  corners / tableSeconds  * 1e-6);
+    std::printf("Speedup        %.2fx\n", legacySeconds / tableSeconds);
+
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    int          result          = 0;
+
+    for (unsigned int threads = 1; threads <= hardwareThreads * 2; threads *= 2)
+    {
+        std::vector<int> parallelIndices, parallelUniqueCorners;
+
+        auto parallelStart = std::chrono::high_resolution_clock::now();
+        Welder::WeldCornersParallel(mesh, false, WeldSettings{}, parallelIndices, parallelUniqueCorners, threads);
+        auto parallelEnd   = std::chrono::high_resolution_clock::now();
+
+        bool   identical       = parallelIndices == indices && parallelUniqueCorners == uniqueCorners;
+        double parallelSeconds = std::chrono::duration<double>(parallelEnd - parallelStart).count();
+
+        std::printf("Parallel x%-3u  unique %10zu  %s  %8.2f Mcorners/s\n", threads, parallelUniqueCorners.size(), identical ? "identical" : "MISMATCH ", corners / parallelSeconds * 1e-6);
+
+        // What Welder::WeldCorners assumes to pick the parallel path, one of its threads against the serial weld
+        if (threads == 1) { std::printf("Thread cost    %.2fx the serial weld\n", parallelSeconds / tableSeconds); }
+
+        if (!identical) { result = 1; }
+    }
+
+    return result;
+}
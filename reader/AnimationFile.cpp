@@ -0,0 +1,524 @@
+#include "AnimationFile.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "ByteCursor.h"
+#include "ChunkFile.h"
+
+
+namespace
+{
+    const ChunkFile::ChunkEntry* FindChunk(std::span<const ChunkFile::ChunkEntry> directory, uint32_t id)
+    {
+        for (const ChunkFile::ChunkEntry& entry : directory)
+        {
+            if (entry.id == id) { return &entry; }
+        }
+        return nullptr;
+    }
+
+    // Like KeyframeReducer::Evaluate, [b] isn't read when t is 0
+    void Interpolate(const float* a, const float* b, float t, int components, float* out)
+    {
+        if (t <= 0.0f) { std::copy_n(a, components, out); return; }
+
+        // The quantized rotations can come in opposite hemispheres, the short way is the one between a and b or -b
+        float sign = 1.0f;
+        if (components == 4 && a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f) { sign = -1.0f; }
+
+        for (int c = 0; c < components; c++) { out[c] = a[c] + (b[c] * sign - a[c]) * t; }
+
+        if (components == 4)
+        {
+            float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]);
+            if (length > 0.0f) { for (int c = 0; c < 4; c++) { out[c] /= length; } }
+        }
+    }
+
+    float* ChannelOf(TransformRecord& transform, uint8_t channel)
+    {
+        switch (channel)
+        {
+            case 0:  return transform.position;
+            case 1:  return transform.rotation;
+            case 2:  return transform.scale;
+            default: return transform.shear;
+        }
+    }
+}
+
+
+bool AnimationFile::Fail(const char* message)
+{
+    error = message;
+    Close();
+    return false;
+}
+
+
+void AnimationFile::Close()
+{
+    file.Close();
+    view = {};
+
+    libraryClips = {};
+    libraryNames = {};
+    libraryData  = {};
+
+    ResetClip();
+}
+
+
+void AnimationFile::ResetClip()
+{
+    jointCount = 0;
+    frameCount = 0;
+    frameRate  = 0.0f;
+    version    = 0;
+    transforms = {};
+
+    tracks      = {};
+    keyFrames16 = {};
+    keyFrames32 = {};
+    keyValues   = {};
+
+    quantizedTracks = {};
+    ranges          = {};
+    quantizedData   = {};
+
+    segmentedTracks = {};
+    constants       = {};
+    segments        = {};
+    segmentData     = {};
+
+    curveJoints   = {};
+    curveChannels = {};
+    curveKeys     = {};
+
+    matrices     = {};
+    halfMatrices = {};
+}
+
+
+bool AnimationFile::Open(const std::string& path)
+{
+    Close();
+    error.clear();
+
+    if (!file.Open(path)) { return Fail("Couldn't map the file"); }
+
+    view = std::span<const uint8_t>(file.Data(), file.Size());
+    return ParseClip();
+}
+
+
+bool AnimationFile::ParseClip()
+{
+    bool container = view.size() >= sizeof(ChunkFile::Header) && std::memcmp(view.data(), MAF_Format::MAGIC, 4) == 0;
+
+    return container ? ParseContainer() : ParseDense();
+}
+
+
+std::string_view AnimationFile::ClipName(size_t clip) const
+{
+    const MAF_Format::LibraryClipRecord& record = libraryClips[clip];
+    return std::string_view(libraryNames.data() + record.nameOffset, record.nameLength);
+}
+
+
+bool AnimationFile::SelectClip(size_t clip)
+{
+    if (clip >= libraryClips.size()) { return Fail("Clip index out of range"); }
+
+    const MAF_Format::LibraryClipRecord& record = libraryClips[clip];
+
+    ResetClip();
+    view = libraryData.subspan((size_t)record.offset, (size_t)record.size);
+
+    return ParseClip();
+}
+
+
+bool AnimationFile::ParseLibrary(std::span<const ChunkFile::ChunkEntry> directory)
+{
+    const ChunkFile::ChunkEntry* clipEntry = FindChunk(directory, MAF_Format::CHUNK_LIBRARY_CLIPS);
+    const ChunkFile::ChunkEntry* nameEntry = FindChunk(directory, MAF_Format::CHUNK_NAMES);
+    const ChunkFile::ChunkEntry* dataEntry = FindChunk(directory, MAF_Format::CHUNK_LIBRARY_DATA);
+
+    if (!nameEntry || !dataEntry)                                        { return Fail("Missing clip library chunks"); }
+    if (clipEntry->size % sizeof(MAF_Format::LibraryClipRecord) != 0 ||
+        clipEntry->size == 0)                                            { return Fail("Invalid clip library chunk"); }
+
+    libraryClips = std::span<const MAF_Format::LibraryClipRecord>(reinterpret_cast<const MAF_Format::LibraryClipRecord*>(view.data() + clipEntry->offset), (size_t)(clipEntry->size / sizeof(MAF_Format::LibraryClipRecord)));
+    libraryNames = std::span<const char>(reinterpret_cast<const char*>(view.data() + nameEntry->offset), (size_t)nameEntry->size);
+    libraryData  = std::span<const uint8_t>(view.data() + dataEntry->offset, (size_t)dataEntry->size);
+
+    for (const MAF_Format::LibraryClipRecord& record : libraryClips)
+    {
+        if ((size_t)record.nameOffset + record.nameLength > libraryNames.size() || record.endFrame < record.startFrame ||
+            record.offset % ChunkFile::ALIGNMENT != 0 || record.offset > libraryData.size() || record.size > libraryData.size() - record.offset)
+        {
+            return Fail("Invalid library clip");
+        }
+    }
+
+    return SelectClip(0);
+}
+
+
+bool AnimationFile::ParseDense()
+{
+    ByteCursor cursor{ view.data(), view.size(), 0 };
+
+    int32_t joints = 0, frames = 0;
+    if (!cursor.Read(joints) || !cursor.Read(frames) || !cursor.Read(frameRate)) { return Fail("Truncated header"); }
+    if (joints <= 0 || frames < 0)                                              { return Fail("Invalid joint or frame count"); }
+
+    jointCount = (uint32_t)joints;
+    frameCount = (uint32_t)frames;
+
+    size_t transformCount = (size_t)jointCount * frameCount;
+    if (cursor.Remaining() != transformCount * sizeof(TransformRecord)) { return Fail("Joint and frame counts don't match the file size"); }
+
+    transforms = std::span<const TransformRecord>(cursor.Take<TransformRecord>(transformCount), transformCount);
+    version    = 1;
+    return true;
+}
+
+
+bool AnimationFile::ParseContainer()
+{
+    ByteCursor cursor{ view.data(), view.size(), 0 };
+
+    ChunkFile::Header header{};
+    cursor.Read(header);
+
+    if (header.version != MAF_Format::VERSION)  { return Fail("Unsupported MAF version"); }
+    if (header.fileSize > view.size())          { return Fail("The file is shorter than its header says"); }
+    if (header.headerSize < sizeof(header) || header.headerSize > view.size() ||
+        header.headerSize % alignof(ChunkFile::ChunkEntry) != 0)    { return Fail("Invalid header size"); }
+
+    cursor.offset = header.headerSize;
+
+    const ChunkFile::ChunkEntry* entries = cursor.Take<ChunkFile::ChunkEntry>(header.chunkCount);
+    if (!entries) { return Fail("Truncated chunk directory"); }
+
+    std::span<const ChunkFile::ChunkEntry> directory(entries, header.chunkCount);
+    for (const ChunkFile::ChunkEntry& entry : directory)
+    {
+        if (entry.offset > view.size() || entry.size > view.size() - entry.offset) { return Fail("Chunk outside of the file"); }
+        if (entry.offset % ChunkFile::ALIGNMENT != 0)                               { return Fail("Misaligned chunk"); }
+    }
+
+    if (FindChunk(directory, MAF_Format::CHUNK_LIBRARY_CLIPS))
+    {
+        if (!libraryData.empty()) { return Fail("Nested clip library"); }
+        return ParseLibrary(directory);
+    }
+
+    version = 2;
+
+    // Clip
+    const ChunkFile::ChunkEntry* clipEntry = FindChunk(directory, MAF_Format::CHUNK_CLIP);
+    MAF_Format::ClipRecord       clipRecord{};
+
+    ByteCursor clipChunk{ clipEntry ? view.data() + clipEntry->offset : nullptr, clipEntry ? (size_t)clipEntry->size : 0, 0 };
+    if (!clipChunk.Read(clipRecord)) { return Fail("Missing clip chunk"); }
+    if (clipRecord.jointCount == 0)  { return Fail("Invalid joint count"); }
+
+    jointCount = clipRecord.jointCount;
+    frameCount = clipRecord.frameCount;
+    frameRate  = clipRecord.frameRate;
+
+    if (FindChunk(directory, MAF_Format::CHUNK_SEGMENTED_TRACKS)) { return ParseSegmented(directory, clipRecord); }
+    if (const ChunkFile::ChunkEntry* paletteEntry = FindChunk(directory, MAF_Format::CHUNK_PALETTE)) { return ParsePalette(*paletteEntry); }
+
+    // Key frames, shared by both kinds of tracks
+    const ChunkFile::ChunkEntry* frameEntry = FindChunk(directory, MAF_Format::CHUNK_KEY_FRAMES);
+    if (!frameEntry || (frameEntry->elementStride != 2 && frameEntry->elementStride != 4) || frameEntry->size % frameEntry->elementStride != 0) { return Fail("Invalid key frame chunk"); }
+
+    size_t keyCount = (size_t)(frameEntry->size / frameEntry->elementStride);
+    if (frameEntry->elementStride == 2) { keyFrames16 = std::span<const uint16_t>(reinterpret_cast<const uint16_t*>(view.data() + frameEntry->offset), keyCount); }
+    else                                { keyFrames32 = std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(view.data() + frameEntry->offset), keyCount); }
+
+    // Quantized tracks
+    if (const ChunkFile::ChunkEntry* quantizedEntry = FindChunk(directory, MAF_Format::CHUNK_QUANTIZED_TRACKS))
+    {
+        const ChunkFile::ChunkEntry* rangeEntry = FindChunk(directory, MAF_Format::CHUNK_RANGES);
+        const ChunkFile::ChunkEntry* dataEntry  = FindChunk(directory, MAF_Format::CHUNK_QUANTIZED_DATA);
+
+        if (!rangeEntry || !dataEntry)                                                                          { return Fail("Missing quantized track chunks"); }
+        if (quantizedEntry->size != (uint64_t)clipRecord.trackCount * sizeof(MAF_Format::QuantizedTrackRecord)) { return Fail("Track count doesn't match the track chunk"); }
+        if (rangeEntry->size % sizeof(float) != 0)                                                              { return Fail("Invalid range chunk"); }
+
+        quantizedTracks = std::span<const MAF_Format::QuantizedTrackRecord>(reinterpret_cast<const MAF_Format::QuantizedTrackRecord*>(view.data() + quantizedEntry->offset), clipRecord.trackCount);
+        ranges          = std::span<const float>(reinterpret_cast<const float*>(view.data() + rangeEntry->offset), (size_t)(rangeEntry->size / sizeof(float)));
+        quantizedData   = std::span<const uint8_t>(view.data() + dataEntry->offset, (size_t)dataEntry->size);
+
+        for (const MAF_Format::QuantizedTrackRecord& track : quantizedTracks)
+        {
+            bool     rotation   = track.channel == (uint8_t)TrackChannel::Rotation;
+            uint64_t keyBits    = rotation ? 2ull + 3ull * track.bits : 3ull * track.bits;
+            bool     validBits  = rotation ? (track.bits >= AnimationCompressor::MIN_ROTATION_BITS && track.bits <= AnimationCompressor::MAX_ROTATION_BITS)
+                                           : (track.bits <= AnimationCompressor::MAX_QUANTIZED_BITS || track.bits == AnimationCompressor::RAW_BITS);
+
+            if (track.joint >= jointCount || track.channel > 3 || !validBits || track.keyCount == 0 || (size_t)track.firstKey + track.keyCount > keyCount ||
+                (!rotation && (size_t)track.firstRange + 6 > ranges.size()) || track.dataOffset + (keyBits * track.keyCount + 7) / 8 > quantizedData.size())
+            {
+                return Fail("Invalid track");
+            }
+        }
+
+        return true;
+    }
+
+    // Float tracks
+    const ChunkFile::ChunkEntry* trackEntry = FindChunk(directory, MAF_Format::CHUNK_TRACKS);
+    const ChunkFile::ChunkEntry* valueEntry = FindChunk(directory, MAF_Format::CHUNK_KEY_VALUES);
+
+    if (!trackEntry || !valueEntry)                                                             { return Fail("Missing track chunks"); }
+    if (trackEntry->size != (uint64_t)clipRecord.trackCount * sizeof(MAF_Format::TrackRecord)) { return Fail("Track count doesn't match the track chunk"); }
+    if (valueEntry->size % sizeof(float) != 0)                                                  { return Fail("Invalid key value chunk"); }
+
+    tracks    = std::span<const MAF_Format::TrackRecord>(reinterpret_cast<const MAF_Format::TrackRecord*>(view.data() + trackEntry->offset), clipRecord.trackCount);
+    keyValues = std::span<const float>(reinterpret_cast<const float*>(view.data() + valueEntry->offset), (size_t)(valueEntry->size / sizeof(float)));
+
+    for (const MAF_Format::TrackRecord& track : tracks)
+    {
+        if (track.joint >= jointCount || track.channel > 3 || track.components != (track.channel == 1 ? 4 : 3) || track.keyCount == 0 ||
+            (size_t)track.firstKey + track.keyCount > keyCount || (size_t)track.firstValue + (size_t)track.keyCount * track.components > keyValues.size())
+        {
+            return Fail("Invalid track");
+        }
+    }
+
+    if (FindChunk(directory, MAF_Format::CHUNK_CURVE_JOINTS)) { return ParseCurves(directory); }
+
+    return true;
+}
+
+
+bool AnimationFile::ParseCurves(std::span<const ChunkFile::ChunkEntry> directory)
+{
+    const ChunkFile::ChunkEntry* jointEntry   = FindChunk(directory, MAF_Format::CHUNK_CURVE_JOINTS);
+    const ChunkFile::ChunkEntry* channelEntry = FindChunk(directory, MAF_Format::CHUNK_CURVE_CHANNELS);
+    const ChunkFile::ChunkEntry* keyEntry     = FindChunk(directory, MAF_Format::CHUNK_CURVE_KEYS);
+
+    if (!channelEntry || !keyEntry)                                         { return Fail("Missing curve chunks"); }
+    if (jointEntry->size   % sizeof(MAF_Format::CurveJointRecord)   != 0 ||
+        channelEntry->size % sizeof(MAF_Format::CurveChannelRecord) != 0 ||
+        keyEntry->size     % sizeof(CurveKey)                       != 0)  { return Fail("Invalid curve chunk"); }
+
+    curveJoints   = std::span<const MAF_Format::CurveJointRecord>(reinterpret_cast<const MAF_Format::CurveJointRecord*>(view.data() + jointEntry->offset), (size_t)(jointEntry->size / sizeof(MAF_Format::CurveJointRecord)));
+    curveChannels = std::span<const MAF_Format::CurveChannelRecord>(reinterpret_cast<const MAF_Format::CurveChannelRecord*>(view.data() + channelEntry->offset), (size_t)(channelEntry->size / sizeof(MAF_Format::CurveChannelRecord)));
+    curveKeys     = std::span<const CurveKey>(reinterpret_cast<const CurveKey*>(view.data() + keyEntry->offset), (size_t)(keyEntry->size / sizeof(CurveKey)));
+
+    for (const MAF_Format::CurveJointRecord& joint : curveJoints)
+    {
+        if (joint.joint >= jointCount || (size_t)joint.firstChannel + joint.channelCount > curveChannels.size()) { return Fail("Invalid curve joint"); }
+    }
+
+    for (const MAF_Format::CurveChannelRecord& channel : curveChannels)
+    {
+        if (channel.attribute >= (uint8_t)CurveAttribute::Count || channel.keyCount == 0 ||
+            (size_t)channel.firstKey + channel.keyCount > curveKeys.size())
+        {
+            return Fail("Invalid curve channel");
+        }
+    }
+
+    return true;
+}
+
+
+bool AnimationFile::ParsePalette(const ChunkFile::ChunkEntry& paletteEntry)
+{
+    const uint32_t floatStride = (uint32_t)(MatrixPalette::MATRIX_FLOATS * sizeof(float));
+    const uint32_t halfStride  = (uint32_t)(MatrixPalette::MATRIX_FLOATS * sizeof(uint16_t));
+    const uint64_t valueCount  = (uint64_t)frameCount * jointCount * MatrixPalette::MATRIX_FLOATS;
+
+    if (paletteEntry.elementStride != floatStride && paletteEntry.elementStride != halfStride) { return Fail("Invalid palette chunk"); }
+    if (paletteEntry.size != (uint64_t)frameCount * jointCount * paletteEntry.elementStride)    { return Fail("Joint and frame counts don't match the palette chunk"); }
+
+    if (paletteEntry.elementStride == halfStride) { halfMatrices = std::span<const uint16_t>(reinterpret_cast<const uint16_t*>(view.data() + paletteEntry.offset), (size_t)valueCount); }
+    else                                          { matrices     = std::span<const float>(reinterpret_cast<const float*>(view.data() + paletteEntry.offset), (size_t)valueCount); }
+
+    return true;
+}
+
+
+bool AnimationFile::ParseSegmented(std::span<const ChunkFile::ChunkEntry> directory, const MAF_Format::ClipRecord& clipRecord)
+{
+    const ChunkFile::ChunkEntry* trackEntry    = FindChunk(directory, MAF_Format::CHUNK_SEGMENTED_TRACKS);
+    const ChunkFile::ChunkEntry* constantEntry = FindChunk(directory, MAF_Format::CHUNK_CONSTANTS);
+    const ChunkFile::ChunkEntry* segmentEntry  = FindChunk(directory, MAF_Format::CHUNK_SEGMENTS);
+    const ChunkFile::ChunkEntry* dataEntry     = FindChunk(directory, MAF_Format::CHUNK_SEGMENT_DATA);
+
+    if (!constantEntry || !segmentEntry || !dataEntry)                                                   { return Fail("Missing segment chunks"); }
+    if (trackEntry->size != (uint64_t)clipRecord.trackCount * sizeof(MAF_Format::SegmentedTrackRecord)) { return Fail("Track count doesn't match the track chunk"); }
+    if (constantEntry->size % sizeof(float) != 0)                                                        { return Fail("Invalid constant chunk"); }
+    if (segmentEntry->size % sizeof(MAF_Format::SegmentRecord) != 0)                                     { return Fail("Invalid segment chunk"); }
+
+    segmentedTracks = std::span<const MAF_Format::SegmentedTrackRecord>(reinterpret_cast<const MAF_Format::SegmentedTrackRecord*>(view.data() + trackEntry->offset), clipRecord.trackCount);
+    constants       = std::span<const float>(reinterpret_cast<const float*>(view.data() + constantEntry->offset), (size_t)(constantEntry->size / sizeof(float)));
+    segments        = std::span<const MAF_Format::SegmentRecord>(reinterpret_cast<const MAF_Format::SegmentRecord*>(view.data() + segmentEntry->offset), (size_t)(segmentEntry->size / sizeof(MAF_Format::SegmentRecord)));
+    segmentData     = std::span<const uint8_t>(view.data() + dataEntry->offset, (size_t)dataEntry->size);
+
+    // Components of every animated track, the size of one frame in a block
+    uint64_t animatedComponents = 0;
+    for (const MAF_Format::SegmentedTrackRecord& track : segmentedTracks)
+    {
+        const uint32_t components = (track.channel == (uint8_t)TrackChannel::Rotation) ? 4 : 3;
+
+        if (track.joint >= jointCount || track.channel > 3)                                     { return Fail("Invalid track"); }
+        if (track.constant && (size_t)track.offset + components > constants.size())             { return Fail("Invalid track"); }
+        if (!track.constant && track.offset != animatedComponents)                              { return Fail("Invalid track"); }
+
+        if (!track.constant) { animatedComponents += components; }
+    }
+
+    // Back to back from frame 0, each block in SDAT and overlapping the next segment by one frame
+    uint32_t nextFrame = 0;
+    for (size_t s = 0; s < segments.size(); s++)
+    {
+        const MAF_Format::SegmentRecord& segment = segments[s];
+        const bool                       last    = s + 1 == segments.size();
+        const uint64_t                   frames  = last ? (uint64_t)frameCount - segment.firstFrame : (uint64_t)segments[s + 1].firstFrame - segment.firstFrame + 1;
+
+        if (segment.firstFrame != nextFrame || segment.firstFrame >= frameCount || segment.frameCount != frames || frames < 1) { return Fail("Invalid segment"); }
+        if (segment.offset % ChunkFile::ALIGNMENT != 0 || segment.size != frames * animatedComponents * sizeof(float))        { return Fail("Invalid segment"); }
+        if (segment.offset > segmentData.size() || segment.size > segmentData.size() - segment.offset)                       { return Fail("Invalid segment"); }
+
+        nextFrame = segment.firstFrame + segment.frameCount - (last ? 0 : 1);
+    }
+
+    if (nextFrame != frameCount) { return Fail("The segments don't cover the clip"); }
+
+    return true;
+}
+
+
+std::span<const float> AnimationFile::SegmentData(size_t segment) const
+{
+    const MAF_Format::SegmentRecord& record = segments[segment];
+    return std::span<const float>(reinterpret_cast<const float*>(segmentData.data() + record.offset), (size_t)(record.size / sizeof(float)));
+}
+
+
+void AnimationFile::SampleMatrices(uint32_t frame, std::span<float> out) const
+{
+    const size_t frameValues = (size_t)jointCount * MatrixPalette::MATRIX_FLOATS;
+    const size_t first       = (size_t)frame * frameValues;
+
+    if (!matrices.empty()) { std::copy_n(matrices.data() + first, frameValues, out.begin()); return; }
+
+    for (size_t v = 0; v < frameValues && !halfMatrices.empty(); v++) { out[v] = MatrixPalette::FromHalf(halfMatrices[first + v]); }
+}
+
+
+// Last segment starting at or before the frame
+size_t AnimationFile::SegmentOf(uint32_t frame) const
+{
+    auto next = std::upper_bound(segments.begin(), segments.end(), frame, [](uint32_t f, const MAF_Format::SegmentRecord& segment) { return f < segment.firstFrame; });
+    return next == segments.begin() ? 0 : (size_t)(next - segments.begin()) - 1;
+}
+
+
+// Last key at or before the frame and how far the frame is towards the next one
+void AnimationFile::FindKeys(uint32_t firstKey, uint32_t keyCount, uint32_t frame, size_t& key, float& t) const
+{
+    key = 0;
+    for (size_t lo = 0, hi = keyCount; lo < hi; )
+    {
+        size_t middle = (lo + hi) / 2;
+        if (KeyFrame(firstKey + middle) <= frame) { key = middle; lo = middle + 1; }
+        else                                      { hi = middle; }
+    }
+
+    uint32_t keyFrame = KeyFrame(firstKey + key);
+    if (key + 1 >= keyCount || keyFrame >= frame) { t = 0.0f; return; }
+
+    t = (float)(frame - keyFrame) / (float)(KeyFrame(firstKey + key + 1) - keyFrame);
+}
+
+
+void AnimationFile::Sample(uint32_t frame, std::span<TransformRecord> out) const
+{
+    if (version == 1)
+    {
+        std::span<const TransformRecord> dense = Frame(frame);
+        std::copy(dense.begin(), dense.end(), out.begin());
+        return;
+    }
+
+    // Rest values for the channels without a track
+    const TransformRecord rest = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } };
+    std::fill(out.begin(), out.begin() + jointCount, rest);
+
+    for (const MAF_Format::TrackRecord& track : tracks)
+    {
+        const float* values = keyValues.data() + track.firstValue;
+        size_t       key;
+        float        t;
+
+        FindKeys(track.firstKey, track.keyCount, frame, key, t);
+        Interpolate(values + key * track.components, values + (key + 1) * track.components, t, track.components, ChannelOf(out[track.joint], track.channel));
+    }
+
+    if (!segments.empty())
+    {
+        const size_t                     segment = SegmentOf(frame);
+        const MAF_Format::SegmentRecord& record  = segments[segment];
+        const float*                     block   = SegmentData(segment).data();
+        const uint32_t                   local   = frame - record.firstFrame;
+
+        for (const MAF_Format::SegmentedTrackRecord& track : segmentedTracks)
+        {
+            const int    components = (track.channel == (uint8_t)TrackChannel::Rotation) ? 4 : 3;
+            const float* values     = track.constant ? constants.data() + track.offset
+                                                     : block + (size_t)track.offset * record.frameCount + (size_t)local * components;
+
+            std::copy_n(values, components, ChannelOf(out[track.joint], track.channel));
+        }
+    }
+
+    if (!curveJoints.empty())
+    {
+        const float time = frameRate > 0.0f ? (float)frame / frameRate : 0.0f;
+        Transform   transform;
+
+        for (const MAF_Format::CurveJointRecord& joint : curveJoints)
+        {
+            float values[(int)CurveAttribute::Count];
+            std::copy_n(joint.values, (int)CurveAttribute::Count, values);
+
+            for (const MAF_Format::CurveChannelRecord& channel : curveChannels.subspan(joint.firstChannel, joint.channelCount))
+            {
+                values[channel.attribute] = AnimationCurves::Evaluate(curveKeys.data() + channel.firstKey, channel.keyCount, time);
+            }
+
+            AnimationCurves::Compose(values, joint.rotateOrder, joint.rotateAxis, joint.jointOrient, transform);
+            std::memcpy(&out[joint.joint], &transform, sizeof(TransformRecord));       // Same layout
+        }
+    }
+
+    float a[4], b[4];
+    for (const MAF_Format::QuantizedTrackRecord& track : quantizedTracks)
+    {
+        const uint8_t* data       = quantizedData.data() + track.dataOffset;
+        const float*   range      = ranges.data() + track.firstRange;
+        const int      components = (track.channel == (uint8_t)TrackChannel::Rotation) ? 4 : 3;
+        size_t         key;
+        float          t;
+
+        FindKeys(track.firstKey, track.keyCount, frame, key, t);
+
+        AnimationCompressor::DecodeKey(data, (TrackChannel)track.channel, track.bits, range, range + 3, key, a);
+        if (t > 0.0f) { AnimationCompressor::DecodeKey(data, (TrackChannel)track.channel, track.bits, range, range + 3, key + 1, b); }
+
+        Interpolate(a, b, t, components, ChannelOf(out[track.joint], track.channel));
+    }
+}
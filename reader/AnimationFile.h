@@ -0,0 +1,128 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "MappedFile.h"
+#include "Transform.h"
+#include "MAF_Format.h"
+#include "AnimationCompressor.h"
+#include "AnimationCurves.h"
+#include "MatrixPalette.h"
+
+// @note Maya independent MAF loader, the counterpart of MAF_Writer:
+// v1 [jointCount, frameCount, frameRate] followed by frameCount * jointCount transforms (frame major, the root first).
+// v2 the reduced clips, a container with one track per animated joint channel (MAF_Format.h), float or quantized keys,
+// or the segmented ones, every frame in track major blocks a player can stream one at a time (SegmentData).
+// v2 curve clips add the authored keys of the keyed joints to the float tracks of the sampled ones (CurveJoints).
+// v2 matrix palettes have the skinning matrices of every joint and frame instead (Matrices, SampleMatrices).
+// v2 clip libraries hold several clips, each one a file of the kinds above. Open selects the first one, SelectClip the rest.
+// The transforms, tracks, keys and blocks are views into the mapped file.
+//
+class AnimationFile
+{
+public:
+    bool Open(const std::string& path);
+    void Close();
+
+    const std::string& Error() const { return error; }
+
+    // Clip libraries only, 0 clips for the files with a single unnamed clip. Everything below is about the selected one
+    std::span<const MAF_Format::LibraryClipRecord> Clips()                const { return libraryClips; }
+    std::string_view                               ClipName(size_t clip) const;
+    bool                                           SelectClip(size_t clip);
+
+    uint32_t                         JointCount() const { return jointCount; }
+    uint32_t                         FrameCount() const { return frameCount; }
+    float                            FrameRate()  const { return frameRate;  }
+    int                              Version()    const { return version;    }   // 1 for the dense files, 2 for the reduced and segmented ones
+
+    // v1 only, empty for the reduced files
+    std::span<const TransformRecord> Transforms() const { return transforms; }
+
+    // Every joint of one frame, in the same order as the MOF skeleton. v1 only
+    std::span<const TransformRecord> Frame(uint32_t frame) const { return transforms.subspan((size_t)frame * jointCount, jointCount); }
+
+    // v2 only, the float tracks or the quantized ones (AnimationCompressor::DecodeKey decodes their keys)
+    std::span<const MAF_Format::TrackRecord>          Tracks()            const { return tracks; }
+    std::span<const float>                            KeyValues()         const { return keyValues; }
+    std::span<const MAF_Format::QuantizedTrackRecord> QuantizedTracks()   const { return quantizedTracks; }
+    std::span<const float>                            Ranges()            const { return ranges; }
+    std::span<const uint8_t>                          QuantizedData()     const { return quantizedData; }
+    uint32_t                                          KeyFrame(size_t key) const { return keyFrames16.empty() ? keyFrames32[key] : keyFrames16[key]; }
+
+    // v2 segmented only. An animated track's floats in a block start at offset * the segment's frameCount
+    std::span<const MAF_Format::SegmentedTrackRecord> SegmentedTracks()   const { return segmentedTracks; }
+    std::span<const float>                            Constants()         const { return constants; }
+    std::span<const MAF_Format::SegmentRecord>        Segments()          const { return segments; }
+    std::span<const float>                            SegmentData(size_t segment) const;
+    size_t                                            SegmentOf(uint32_t frame) const;
+
+    // v2 curve clips only. The curves of a joint are its CurveJointRecord::channelCount records from firstChannel
+    std::span<const MAF_Format::CurveJointRecord>     CurveJoints()       const { return curveJoints; }
+    std::span<const MAF_Format::CurveChannelRecord>   CurveChannels()     const { return curveChannels; }
+    std::span<const CurveKey>                         CurveKeys()         const { return curveKeys; }
+
+    // v2 matrix palettes only, [frameCount][jointCount] matrices of MatrixPalette::MATRIX_FLOATS, float or half ones.
+    // Slot 0 is the root and influence i is slot i + 1, so a MOF vertex joint ID (MeshFile) picks its matrix as it is
+    std::span<const float>                            Matrices()          const { return matrices; }
+    std::span<const uint16_t>                         HalfMatrices()      const { return halfMatrices; }
+
+    // The matrices of one frame as floats, [out] needs JointCount() * MatrixPalette::MATRIX_FLOATS.
+    // The one of a 0 based influence index is at (jointID + 1) * MatrixPalette::MATRIX_FLOATS
+    void SampleMatrices(uint32_t frame, std::span<float> out) const;
+
+    // Every joint of one frame, whatever the version (the matrix palettes have no local transforms, they give the rest pose). The reduced tracks get interpolated like KeyframeReducer::Evaluate does,
+    // the curves evaluated at frame / FrameRate() seconds.
+    // [out] needs JointCount() transforms
+    void Sample(uint32_t frame, std::span<TransformRecord> out) const;
+
+private:
+    bool Fail(const char* message);
+    void ResetClip();
+    bool ParseClip();
+    bool ParseLibrary(std::span<const ChunkFile::ChunkEntry> directory);
+    bool ParseDense();
+    bool ParseContainer();
+    bool ParseSegmented(std::span<const ChunkFile::ChunkEntry> directory, const MAF_Format::ClipRecord& clipRecord);
+    bool ParseCurves(std::span<const ChunkFile::ChunkEntry> directory);
+    bool ParsePalette(const ChunkFile::ChunkEntry& paletteEntry);
+    void FindKeys(uint32_t firstKey, uint32_t keyCount, uint32_t frame, size_t& key, float& t) const;
+
+    MappedFile                       file;
+    std::string                      error;
+    std::span<const uint8_t>         view;          // The file, or the selected clip of a library
+
+    std::span<const MAF_Format::LibraryClipRecord> libraryClips;
+    std::span<const char>                          libraryNames;
+    std::span<const uint8_t>                       libraryData;
+
+    uint32_t                         jointCount = 0;
+    uint32_t                         frameCount = 0;
+    float                            frameRate  = 0.0f;
+    int                              version    = 0;
+    std::span<const TransformRecord> transforms;
+
+    std::span<const MAF_Format::TrackRecord> tracks;
+    std::span<const uint16_t>                keyFrames16;
+    std::span<const uint32_t>                keyFrames32;
+    std::span<const float>                   keyValues;
+
+    std::span<const MAF_Format::QuantizedTrackRecord> quantizedTracks;
+    std::span<const float>                            ranges;
+    std::span<const uint8_t>                          quantizedData;
+
+    std::span<const MAF_Format::SegmentedTrackRecord> segmentedTracks;
+    std::span<const float>                            constants;
+    std::span<const MAF_Format::SegmentRecord>        segments;
+    std::span<const uint8_t>                          segmentData;
+
+    std::span<const MAF_Format::CurveJointRecord>     curveJoints;
+    std::span<const MAF_Format::CurveChannelRecord>   curveChannels;
+    std::span<const CurveKey>                         curveKeys;
+
+    std::span<const float>                            matrices;
+    std::span<const uint16_t>                         halfMatrices;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// @note Bounds checked walk over a mapped file. Take hands out pointers into the mapping, nothing gets copied
+// except the small header values read with Read.
+//
+struct ByteCursor
+{
+    const unsigned char* data   = nullptr;
+    size_t               size   = 0;
+    size_t               offset = 0;
+
+    size_t Remaining() const { return offset < size ? size - offset : 0; }   // 0 past the end, a bad seek fails the next read
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (Remaining() < sizeof(T)) { return false; }
+
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    // nullptr if the file is too short. Count * sizeof(T) can't overflow as the counts come from 32 bit fields
+    template <typename T>
+    const T* Take(size_t count)
+    {
+        size_t bytes = count * sizeof(T);
+        if (Remaining() < bytes) { return nullptr; }
+
+        const T* values = reinterpret_cast<const T*>(data + offset);
+        offset += bytes;
+        return values;
+    }
+};
@@ -0,0 +1,84 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) { fileHandle = nullptr; return false; }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) { Close(); return false; }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) { Close(); return false; }
+
+    data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!data) { Close(); return false; }
+
+    size = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+
+void MappedFile::Close()
+{
+    if (data)          { UnmapViewOfFile(data);     }
+    if (mappingHandle) { CloseHandle(mappingHandle); }
+    if (fileHandle)    { CloseHandle(fileHandle);    }
+
+    data          = nullptr;
+    size          = 0;
+    mappingHandle = nullptr;
+    fileHandle    = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) { return false; }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) { Close(); return false; }
+
+    void* mapping = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED) { Close(); return false; }
+
+    // The loaders go through the file front to back
+    madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+
+    data = static_cast<const unsigned char*>(mapping);
+    size = (size_t)status.st_size;
+    return true;
+}
+
+
+void MappedFile::Close()
+{
+    if (data)            { munmap(const_cast<unsigned char*>(data), size); }
+    if (descriptor >= 0) { close(descriptor); }
+
+    data       = nullptr;
+    size       = 0;
+    descriptor = -1;
+}
+
+#endif
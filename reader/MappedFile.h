@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// @note Read only memory mapping of a whole file. The views handed out by MeshFile/AnimationFile point in here,
+// so they are valid as long as the MappedFile stays open.
+//
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const unsigned char* Data() const { return data; }
+    size_t               Size() const { return size; }
+
+private:
+    const unsigned char* data = nullptr;
+    size_t               size = 0;
+
+#ifdef _WIN32
+    void* fileHandle    = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int   descriptor    = -1;
+#endif
+};
@@ -0,0 +1,310 @@
+#include "MeshFile.h"
+
+#include "ByteCursor.h"
+#include "ChunkFile.h"
+
+
+namespace
+{
+    // @note Walks the variable length joint records of the stream files: name, IDs, children and the transform
+    bool ParseStreamJoints(ByteCursor& cursor, std::vector<MeshFile::JointView>& joints)
+    {
+        int32_t jointCount = 0;
+        if (!cursor.Read(jointCount) || jointCount < 0) { return false; }
+
+        joints.clear();
+        joints.reserve((size_t)jointCount);
+
+        for (int32_t j = 0; j < jointCount; j++)
+        {
+            MeshFile::JointView joint{};
+
+            int32_t nameLength = 0;
+            if (!cursor.Read(nameLength) || nameLength < 0) { return false; }
+
+            const char* name = cursor.Take<char>((size_t)nameLength);
+            if (!name) { return false; }
+            joint.name = std::string_view(name, (size_t)nameLength);
+
+            int32_t childCount = 0;
+            if (!cursor.Read(joint.id) || !cursor.Read(joint.parentID) || !cursor.Read(childCount) || childCount < 0) { return false; }
+
+            const int32_t* children = cursor.Take<int32_t>((size_t)childCount);
+            if (!children) { return false; }
+            joint.children = std::span<const int32_t>(children, (size_t)childCount);
+
+            joint.transform = cursor.Take<TransformRecord>(1);
+            if (!joint.transform) { return false; }
+
+            joints.push_back(joint);
+        }
+
+        return true;
+    }
+
+    // Every stream has a known format and ends inside the vertex
+    bool StreamsFit(std::span<const VertexFormat::Stream> streams, uint32_t stride)
+    {
+        for (const VertexFormat::Stream& stream : streams)
+        {
+            size_t componentSize = VertexFormat::ComponentSize(stream.format);
+            if (componentSize == 0 || (size_t)stream.offset + stream.components * componentSize > stride) { return false; }
+        }
+        return true;
+    }
+
+    template <typename Index>
+    bool IndicesInRange(std::span<const Index> indices, uint32_t vertexCount)
+    {
+        for (Index index : indices)
+        {
+            if ((uint32_t)index >= vertexCount) { return false; }
+        }
+        return true;
+    }
+
+    const ChunkFile::ChunkEntry* FindChunk(std::span<const ChunkFile::ChunkEntry> directory, uint32_t id)
+    {
+        for (const ChunkFile::ChunkEntry& entry : directory)
+        {
+            if (entry.id == id) { return &entry; }
+        }
+        return nullptr;
+    }
+}
+
+
+bool MeshFile::Fail(const char* message)
+{
+    error = message;
+    Close();
+    return false;
+}
+
+
+void MeshFile::Close()
+{
+    file.Close();
+
+    version       = 0;
+    attributeMask = 0;
+    influences    = 0;
+    stride        = 0;
+    vertexCount   = 0;
+    indexSize     = 4;
+    streams       = {};
+    vertices      = {};
+    indices16     = {};
+    indices32     = {};
+    bounds        = {};
+    joints.clear();
+    legacyStreams.clear();
+}
+
+
+bool MeshFile::Open(const std::string& path)
+{
+    Close();
+    error.clear();
+
+    if (!file.Open(path)) { return Fail("Couldn't map the file"); }
+
+    bool container = file.Size() >= sizeof(ChunkFile::Header) && std::memcmp(file.Data(), MOF_Format::MAGIC, 4) == 0;
+
+    return container ? ParseContainer() : ParseStream();
+}
+
+
+bool MeshFile::ParseStream()
+{
+    ByteCursor cursor{ file.Data(), file.Size(), 0 };
+    version = 1;
+
+    int32_t count = 0, legacyStride = 0;
+    if (!cursor.Read(count) || !cursor.Read(legacyStride) || count < 0) { return Fail("Truncated header"); }
+
+    vertexCount = (uint32_t)count;
+
+    if (legacyStride > 0)
+    {
+        // [vCount, stride in floats], position, color, normal, uv and optionally K joint IDs + K weights
+        if (legacyStride < 11 || (legacyStride - 11) % 2 != 0 || (legacyStride - 11) / 2 > MAX_INFLUENCES) { return Fail("Unknown legacy stride"); }
+
+        influences    = (legacyStride - 11) / 2;
+        attributeMask = VertexFormat::AttributeMask(true, 1, influences > 0);
+        legacyStreams = VertexFormat::Build(attributeMask, VertexLayout::Float, influences).streams;
+        streams       = legacyStreams;
+        stride        = (uint32_t)legacyStride * sizeof(float);
+    }
+    else
+    {
+        int32_t layoutID = 0, strideBytes = 0, streamCount = 0;
+        if (!cursor.Read(layoutID) || !cursor.Read(strideBytes) || !cursor.Read(attributeMask) || !cursor.Read(influences) || !cursor.Read(streamCount))
+        {
+            return Fail("Truncated extended header");
+        }
+
+        if (layoutID < 0 || layoutID > (int32_t)VertexLayout::Compact || strideBytes <= 0 || streamCount < 0 || influences < 0 || influences > MAX_INFLUENCES)
+        {
+            return Fail("Invalid extended header");
+        }
+
+        layout = (VertexLayout)layoutID;
+        stride = (uint32_t)strideBytes;
+
+        const VertexFormat::Stream* streamData = cursor.Take<VertexFormat::Stream>((size_t)streamCount);
+        if (!streamData) { return Fail("Truncated stream list"); }
+        streams = std::span<const VertexFormat::Stream>(streamData, (size_t)streamCount);
+
+        if (layout == VertexLayout::Compact)
+        {
+            int uvSetCount = 0;
+            for (int set = 0; set < MAX_UV_SETS; set++) { if (attributeMask & ((uint32_t)VertexFormat::ATTRIBUTE_UV0 << set)) { uvSetCount = set + 1; } }
+
+            bool complete = cursor.Read(bounds.positionMin) && cursor.Read(bounds.positionMax);
+            for (int set = 0; set < uvSetCount && complete; set++) { complete = cursor.Read(bounds.uvMin[set]) && cursor.Read(bounds.uvMax[set]); }
+
+            if (!complete) { return Fail("Truncated bounds"); }
+        }
+    }
+
+    if (!StreamsFit(streams, stride)) { return Fail("Stream outside of the vertex"); }
+
+    const unsigned char* vertexData = cursor.Take<unsigned char>((size_t)vertexCount * stride);
+    if (!vertexData) { return Fail("Vertex count doesn't match the file size"); }
+    vertices = std::span<const unsigned char>(vertexData, (size_t)vertexCount * stride);
+
+    int32_t indexCount = 0;
+    if (!cursor.Read(indexCount) || indexCount < 0) { return Fail("Truncated index count"); }
+
+    const uint32_t* indexData = cursor.Take<uint32_t>((size_t)indexCount);
+    if (!indexData) { return Fail("Index count doesn't match the file size"); }
+    indices32 = std::span<const uint32_t>(indexData, (size_t)indexCount);
+    indexSize = sizeof(uint32_t);
+
+    if (!IndicesInRange(indices32, vertexCount)) { return Fail("Index past the last vertex"); }
+
+    // @note Only skinned meshes carry the skeleton
+    if (influences > 0 && !ParseStreamJoints(cursor, joints)) { return Fail("Truncated skeleton"); }
+
+    return true;
+}
+
+
+bool MeshFile::ParseContainer()
+{
+    ByteCursor cursor{ file.Data(), file.Size(), 0 };
+
+    ChunkFile::Header header{};
+    cursor.Read(header);
+
+    if (header.version != MOF_Format::VERSION)  { return Fail("Unsupported MOF version"); }
+    if (header.fileSize > file.Size())          { return Fail("The file is shorter than its header says"); }
+    if (header.headerSize < sizeof(header) || header.headerSize > file.Size() ||
+        header.headerSize % alignof(ChunkFile::ChunkEntry) != 0)    { return Fail("Invalid header size"); }
+
+    cursor.offset = header.headerSize;
+
+    const ChunkFile::ChunkEntry* entries = cursor.Take<ChunkFile::ChunkEntry>(header.chunkCount);
+    if (!entries) { return Fail("Truncated chunk directory"); }
+
+    std::span<const ChunkFile::ChunkEntry> directory(entries, header.chunkCount);
+    for (const ChunkFile::ChunkEntry& entry : directory)
+    {
+        if (entry.offset > file.Size() || entry.size > file.Size() - entry.offset) { return Fail("Chunk outside of the file"); }
+        if (entry.offset % ChunkFile::ALIGNMENT != 0)                               { return Fail("Misaligned chunk"); }
+    }
+
+    auto chunkCursor = [&](uint32_t id, ByteCursor& chunk)
+    {
+        const ChunkFile::ChunkEntry* entry = FindChunk(directory, id);
+        if (!entry) { return false; }
+
+        chunk = ByteCursor{ file.Data() + entry->offset, (size_t)entry->size, 0 };
+        return true;
+    };
+
+    version = 2;
+
+    // Vertex format
+    ByteCursor                     formatChunk;
+    MOF_Format::VertexFormatRecord formatRecord{};
+    if (!chunkCursor(MOF_Format::CHUNK_VERTEX_FORMAT, formatChunk) || !formatChunk.Read(formatRecord)) { return Fail("Missing vertex format"); }
+
+    if (formatRecord.layout < 0 || formatRecord.layout > (int32_t)VertexLayout::Compact || formatRecord.stride <= 0 || formatRecord.streamCount < 0 ||
+        formatRecord.influences < 0 || formatRecord.influences > MAX_INFLUENCES)
+    {
+        return Fail("Invalid vertex format");
+    }
+
+    layout        = (VertexLayout)formatRecord.layout;
+    stride        = (uint32_t)formatRecord.stride;
+    attributeMask = formatRecord.attributeMask;
+    influences    = formatRecord.influences;
+
+    const VertexFormat::Stream* streamData = formatChunk.Take<VertexFormat::Stream>((size_t)formatRecord.streamCount);
+    if (!streamData) { return Fail("Truncated stream list"); }
+    streams = std::span<const VertexFormat::Stream>(streamData, (size_t)formatRecord.streamCount);
+
+    if (!StreamsFit(streams, stride)) { return Fail("Stream outside of the vertex"); }
+
+    // Bounds
+    ByteCursor boundsChunk;
+    if (chunkCursor(MOF_Format::CHUNK_BOUNDS, boundsChunk) && !boundsChunk.Read(bounds)) { return Fail("Truncated bounds"); }
+
+    // Vertices
+    ByteCursor vertexChunk;
+    if (!chunkCursor(MOF_Format::CHUNK_VERTICES, vertexChunk) || vertexChunk.size % stride != 0) { return Fail("Vertex chunk doesn't match the stride"); }
+
+    vertexCount = (uint32_t)(vertexChunk.size / stride);
+    vertices    = std::span<const unsigned char>(vertexChunk.data, vertexChunk.size);
+
+    // Indices
+    const ChunkFile::ChunkEntry* indexEntry = FindChunk(directory, MOF_Format::CHUNK_INDICES);
+    if (!indexEntry || (indexEntry->elementStride != 2 && indexEntry->elementStride != 4) || indexEntry->size % indexEntry->elementStride != 0)
+    {
+        return Fail("Invalid index chunk");
+    }
+
+    indexSize = indexEntry->elementStride;
+    if (indexSize == 2) { indices16 = std::span<const uint16_t>(reinterpret_cast<const uint16_t*>(file.Data() + indexEntry->offset), (size_t)(indexEntry->size / 2)); }
+    else                { indices32 = std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(file.Data() + indexEntry->offset), (size_t)(indexEntry->size / 4)); }
+
+    if (!IndicesInRange(indices16, vertexCount) || !IndicesInRange(indices32, vertexCount)) { return Fail("Index past the last vertex"); }
+
+    // Skeleton
+    ByteCursor skeletonChunk, childrenChunk, nameChunk;
+    if (chunkCursor(MOF_Format::CHUNK_SKELETON, skeletonChunk))
+    {
+        if (!chunkCursor(MOF_Format::CHUNK_CHILDREN, childrenChunk) || !chunkCursor(MOF_Format::CHUNK_NAMES, nameChunk) || 
+            skeletonChunk.size % sizeof(MOF_Format::JointRecord) != 0)
+        {
+            return Fail("Incomplete skeleton");
+        }
+
+        size_t                         jointCount = skeletonChunk.size / sizeof(MOF_Format::JointRecord);
+        const MOF_Format::JointRecord* records    = skeletonChunk.Take<MOF_Format::JointRecord>(jointCount);
+        const int32_t*                 children   = reinterpret_cast<const int32_t*>(childrenChunk.data);
+        size_t                         childTotal = childrenChunk.size / sizeof(int32_t);
+
+        joints.reserve(jointCount);
+        for (size_t j = 0; j < jointCount; j++)
+        {
+            const MOF_Format::JointRecord& record = records[j];
+
+            if ((size_t)record.nameOffset + record.nameLength > nameChunk.size)           { return Fail("Joint name outside of the names chunk"); }
+            if ((size_t)record.firstChild + record.childCount > childTotal)               { return Fail("Joint children outside of the children chunk"); }
+
+            JointView joint{};
+            joint.id        = record.id;
+            joint.parentID  = record.parentID;
+            joint.name      = std::string_view(reinterpret_cast<const char*>(nameChunk.data) + record.nameOffset, record.nameLength);
+            joint.children  = std::span<const int32_t>(children + record.firstChild, record.childCount);
+            joint.transform = reinterpret_cast<const TransformRecord*>(record.position);
+
+            joints.push_back(joint);
+        }
+    }
+
+    return true;
+}
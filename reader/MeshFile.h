@@ -0,0 +1,76 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "Transform.h"
+#include "VertexFormat.h"
+#include "MOF_Format.h"
+
+// @note Maya independent MOF loader. Reads every flavour MOF_Generator writes (legacy 11/19/27 floats, the extended
+// header of the attribute masked and compact layouts, and the v2 chunked container) and validates every count against
+// the size of the file, every stream against the stride, every index against the vertex count and every chunk against
+// ChunkFile::ALIGNMENT. The vertices, indices and joints are views into the mapped file, so Open doesn't copy any of them.
+//
+class MeshFile
+{
+public:
+    struct JointView
+    {
+        int32_t                  id;
+        int32_t                  parentID;
+        std::string_view         name;
+        std::span<const int32_t> children;
+        const TransformRecord*   transform;   // Bind pose
+    };
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const std::string& Error() const { return error; }
+
+    int                                         Version()       const { return version; }             // 1 for the stream files, 2 for the container
+    VertexLayout                                Layout()        const { return layout; }
+    uint32_t                                    AttributeMask() const { return attributeMask; }
+    int                                         Influences()    const { return influences; }
+    uint32_t                                    Stride()        const { return stride; }             // Bytes
+    uint32_t                                    VertexCount()   const { return vertexCount; }
+    std::span<const VertexFormat::Stream>       Streams()       const { return streams; }
+    const VertexQuantizer::QuantizationBounds&  Bounds()        const { return bounds; }             // Only filled for the compact layout and v2 files
+    std::span<const unsigned char>              Vertices()      const { return vertices; }
+
+    // Only one of them is filled, depending on IndexSize
+    uint32_t                                    IndexSize()     const { return indexSize; }
+    std::span<const uint16_t>                   Indices16()     const { return indices16; }
+    std::span<const uint32_t>                   Indices32()     const { return indices32; }
+
+    const std::vector<JointView>&               Joints()        const { return joints; }
+
+private:
+    bool Fail(const char* message);
+    bool ParseStream();
+    bool ParseContainer();
+
+    MappedFile                              file;
+    std::string                             error;
+
+    int                                     version       = 0;
+    VertexLayout                            layout        = VertexLayout::Float;
+    uint32_t                                attributeMask = 0;
+    int                                     influences    = 0;
+    uint32_t                                stride        = 0;
+    uint32_t                                vertexCount   = 0;
+    uint32_t                                indexSize     = 4;
+
+    std::vector<VertexFormat::Stream>       legacyStreams;
+    std::span<const VertexFormat::Stream>   streams;
+    VertexQuantizer::QuantizationBounds     bounds{};
+    std::span<const unsigned char>          vertices;
+    std::span<const uint16_t>               indices16;
+    std::span<const uint32_t>               indices32;
+    std::vector<JointView>                  joints;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+// @note Joint transform as MOF_Generator::WriteJoint/WriteRoot and MAF_Generator::SerializeJointFrameTransform write it
+struct TransformRecord
+{
+    float position[3];
+    float rotation[4];   // Quaternion xyzw
+    float scale   [3];
+    float shear   [3];
+};
+
+static_assert(sizeof(TransformRecord) == 13 * sizeof(float), "TransformRecord has to match the serialized transform");
@@ -0,0 +1,626 @@
+#include "AnimationCompressor.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "Parallel.h"
+#include "MatrixPalette.h"
+#include "ExportReport.h"
+
+namespace
+{
+    constexpr int   CHANNEL_COUNT = 4;
+    constexpr float SMALLEST_THREE_RANGE = 0.70710678f;   // 1 / sqrt(2), no component but the largest one can be bigger
+
+    int Components(TrackChannel channel) { return (channel == TrackChannel::Rotation) ? 4 : 3; }
+
+    uint32_t KeyBits(TrackChannel channel, uint8_t bits)
+    {
+        return (channel == TrackChannel::Rotation) ? 2u + 3u * bits : 3u * bits;
+    }
+
+    uint32_t MaxQuantized(uint8_t bits) { return (uint32_t)((1ull << bits) - 1); }
+
+    // ==========================================================================================================
+    // Bits
+    // ==========================================================================================================
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<uint8_t>& data) : data(data) {}
+
+        void Write(uint32_t value, uint32_t count)
+        {
+            for (uint32_t b = 0; b < count; b++, position++)
+            {
+                if ((position & 7) == 0) { data.emplace_back((uint8_t)0); }
+                if (value & (1u << b))   { data.back() |= (uint8_t)(1u << (position & 7)); }
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& data;
+        uint64_t              position = 0;
+    };
+
+    uint32_t ReadBits(const uint8_t* data, uint64_t position, uint32_t count)
+    {
+        uint64_t value = 0;
+        uint32_t read  = 0;
+
+        while (read < count)
+        {
+            uint32_t shift = (uint32_t)(position & 7);
+            uint32_t take  = std::min(8 - shift, count - read);
+
+            value    |= (uint64_t)((data[position >> 3] >> shift) & ((1u << take) - 1)) << read;
+            read     += take;
+            position += take;
+        }
+
+        return (uint32_t)value;
+    }
+
+    // ==========================================================================================================
+    // Quantization
+    // ==========================================================================================================
+    void Quantize(const AnimationTrack& source, uint8_t bits, QuantizedTrack& out)
+    {
+        const size_t keyCount   = source.frames.size();
+        const int    components = Components(source.channel);
+
+        out.joint   = source.joint;
+        out.channel = source.channel;
+        out.bits    = bits;
+        out.frames  = source.frames;
+        out.data.clear();
+        out.data.reserve(((size_t)KeyBits(source.channel, bits) * keyCount + 7) / 8);
+
+        BitWriter writer(out.data);
+
+        if (source.channel == TrackChannel::Rotation)
+        {
+            const float scale = (float)MaxQuantized(bits) / (2.0f * SMALLEST_THREE_RANGE);
+
+            for (size_t key = 0; key < keyCount; key++)
+            {
+                const float* q = &source.values[key * 4];
+
+                int largest = 0;
+                for (int c = 1; c < 4; c++) { if (std::fabs(q[c]) > std::fabs(q[largest])) { largest = c; } }
+
+                // q and -q are the same rotation, the one with the largest component positive doesn't need its sign
+                float sign = (q[largest] < 0.0f) ? -1.0f : 1.0f;
+
+                writer.Write((uint32_t)largest, 2);
+                for (int c = 0; c < 4; c++)
+                {
+                    if (c == largest) { continue; }
+
+                    float value = std::clamp(q[c] * sign, -SMALLEST_THREE_RANGE, SMALLEST_THREE_RANGE);
+                    writer.Write((uint32_t)std::lround((value + SMALLEST_THREE_RANGE) * scale), bits);
+                }
+            }
+            return;
+        }
+
+        for (int c = 0; c < components; c++)
+        {
+            float low = source.values[c], high = source.values[c];
+            for (size_t key = 1; key < keyCount; key++)
+            {
+                low  = std::min(low,  source.values[key * components + c]);
+                high = std::max(high, source.values[key * components + c]);
+            }
+
+            out.rangeMin   [c] = low;
+            out.rangeExtent[c] = high - low;
+        }
+
+        if (bits == 0) { return; }
+
+        for (size_t key = 0; key < keyCount; key++)
+        {
+            for (int c = 0; c < components; c++)
+            {
+                float value = source.values[key * components + c];
+
+                if (bits == AnimationCompressor::RAW_BITS)
+                {
+                    uint32_t raw;
+                    std::memcpy(&raw, &value, sizeof(raw));
+                    writer.Write(raw, 32);
+                }
+                else
+                {
+                    float    normalized = (out.rangeExtent[c] > 0.0f) ? (value - out.rangeMin[c]) / out.rangeExtent[c] : 0.0f;
+                    uint32_t quantized  = (uint32_t)std::lround(std::clamp(normalized, 0.0f, 1.0f) * (float)MaxQuantized(bits));
+                    writer.Write(quantized, bits);
+                }
+            }
+        }
+    }
+
+    // ==========================================================================================================
+    // Object space
+    // ==========================================================================================================
+    // Column vectors, Affine and the math on it in MatrixPalette.h
+    using MatrixPalette::ToAffine;
+    using MatrixPalette::Compose;
+
+    // Largest distance between where a and b put the joint and the points [distance] away along its axes
+    float ShellError(const Affine& a, const Affine& b, float distance)
+    {
+        float delta[3] = { a.translation[0] - b.translation[0], a.translation[1] - b.translation[1], a.translation[2] - b.translation[2] };
+        float error    = delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2];
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float squared = 0.0f;
+            for (int row = 0; row < 3; row++)
+            {
+                float d = delta[row] + distance * (a.linear[row * 3 + axis] - b.linear[row * 3 + axis]);
+                squared += d * d;
+            }
+            error = std::max(error, squared);
+        }
+
+        return std::sqrt(error);
+    }
+
+    // ==========================================================================================================
+    // Joints
+    // ==========================================================================================================
+    // Every channel of one joint on every frame
+    struct JointFrames
+    {
+        std::vector<float> channels[CHANNEL_COUNT];     // [frameCount * components]
+
+        void Affines(uint32_t frameCount, const std::vector<Affine>* parentWorld, std::vector<Affine>& world) const
+        {
+            world.resize(frameCount);
+
+            Affine local;
+            for (uint32_t frame = 0; frame < frameCount; frame++)
+            {
+                ToAffine(&channels[0][frame * 3], &channels[1][frame * 4], &channels[2][frame * 3], &channels[3][frame * 3], local);
+
+                if (parentWorld) { Compose((*parentWorld)[frame], local, world[frame]); }
+                else             { world[frame] = local; }
+            }
+        }
+    };
+
+    void EvaluateChannel(const AnimationTrack* track, TrackChannel channel, uint32_t frameCount, std::vector<float>& out)
+    {
+        const int components = Components(channel);
+        out.resize((size_t)frameCount * components);
+
+        if (!track)
+        {
+            for (uint32_t frame = 0; frame < frameCount; frame++) { std::copy_n(KeyframeReducer::RestValue(channel), components, &out[(size_t)frame * components]); }
+            return;
+        }
+
+        // KeyframeReducer::Evaluate on every frame, walking the keys instead of searching them
+        const size_t keyCount = track->frames.size();
+        size_t       key      = 0;
+
+        for (uint32_t frame = 0; frame < frameCount; frame++)
+        {
+            float* value = &out[(size_t)frame * components];
+
+            while (key + 1 < keyCount && track->frames[key + 1] <= frame) { key++; }
+
+            if (key + 1 >= keyCount || frame <= track->frames[key])
+            {
+                std::copy_n(&track->values[key * components], components, value);
+                continue;
+            }
+
+            const float* a = &track->values[key * components];
+            const float* b = a + components;
+            float        t = (float)(frame - track->frames[key]) / (float)(track->frames[key + 1] - track->frames[key]);
+
+            for (int c = 0; c < components; c++) { value[c] = a[c] + (b[c] - a[c]) * t; }
+
+            if (components == 4)
+            {
+                float length = std::sqrt(value[0] * value[0] + value[1] * value[1] + value[2] * value[2] + value[3] * value[3]);
+                if (length > 0.0f) { for (int c = 0; c < 4; c++) { value[c] /= length; } }
+            }
+        }
+    }
+
+    class JointCompressor
+    {
+    public:
+        JointCompressor(uint32_t frameCount, const AnimationCompressor::Settings& settings) : frameCount(frameCount), settings(settings) {}
+
+        // Picks the bits of every track of the joint, fills its quantized world transforms and returns its error.
+        // The bits get searched with the error [shell] away from the joint, under [target]
+        float Compress(const AnimationTrack* const tracks[CHANNEL_COUNT], float shell, float target, const std::vector<Affine>* parentReference, const std::vector<Affine>* parentQuantized,
+                       std::vector<Affine>& reference, std::vector<Affine>& quantized, QuantizedTrack* out[CHANNEL_COUNT])
+        {
+            this->parentQuantized = parentQuantized;
+            this->reference       = &reference;
+            this->shell           = shell;
+            this->target          = target;
+
+            for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+            {
+                EvaluateChannel(tracks[channel], (TrackChannel)channel, frameCount, frames.channels[channel]);
+            }
+            frames.Affines(frameCount, parentReference, reference);
+
+            // @note The channels get searched one after the other on top of the ones already quantized, so the last
+            // search measures all of them together
+            uint8_t bits [CHANNEL_COUNT] = {};
+            float   error = 0.0f;
+
+            for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+            {
+                if (!tracks[channel]) { continue; }
+                bits[channel] = SearchBits(*tracks[channel], *out[channel], error);
+            }
+
+            // The earlier channels took too much of the threshold, give them more bits until it fits or they're all maxed
+            int lastChannel = -1;
+            for (int channel = 0; channel < CHANNEL_COUNT; channel++) { if (tracks[channel]) { lastChannel = channel; } }
+
+            while (error > target)
+            {
+                bool raised = false;
+                for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+                {
+                    if (!tracks[channel] || bits[channel] == MaxBits((TrackChannel)channel)) { continue; }
+
+                    bits[channel] = NextBits((TrackChannel)channel, bits[channel]);
+                    error  = TryBits(*tracks[channel], bits[channel], *out[channel]);
+                    raised = true;
+                }
+
+                if (!raised) { break; }
+                if (lastChannel >= 0) { error = TryBits(*tracks[lastChannel], bits[lastChannel], *out[lastChannel]); }
+            }
+
+            frames.Affines(frameCount, parentQuantized, quantized);
+
+            float jointError = 0.0f;
+            for (uint32_t frame = 0; frame < frameCount; frame++) { jointError = std::max(jointError, ShellError(quantized[frame], reference[frame], settings.shellDistance)); }
+            return jointError;
+        }
+
+    private:
+        uint8_t MaxBits(TrackChannel channel) const
+        {
+            return (channel == TrackChannel::Rotation) ? (uint8_t)std::clamp(settings.rotationBits, (int)AnimationCompressor::MIN_ROTATION_BITS, (int)AnimationCompressor::MAX_ROTATION_BITS)
+                                                       : AnimationCompressor::RAW_BITS;
+        }
+
+        uint8_t NextBits(TrackChannel channel, uint8_t bits) const
+        {
+            if (channel != TrackChannel::Rotation && bits >= AnimationCompressor::MAX_QUANTIZED_BITS) { return AnimationCompressor::RAW_BITS; }
+            return (uint8_t)(bits + 1);
+        }
+
+        // Quantizes the track with [bits], leaves what it decodes to in the joint frames and returns the joint error.
+        // Only whether it's over the target matters when it is, so the first frame over it ends the check
+        float TryBits(const AnimationTrack& track, uint8_t bits, QuantizedTrack& out)
+        {
+            Quantize(track, bits, out);
+            AnimationCompressor::Dequantize(out, decoded);
+            EvaluateChannel(&decoded, track.channel, frameCount, frames.channels[(int)track.channel]);
+
+            float error = 0.0f;
+            Affine local, world;
+
+            for (uint32_t frame = 0; frame < frameCount; frame++)
+            {
+                ToAffine(&frames.channels[0][frame * 3], &frames.channels[1][frame * 4], &frames.channels[2][frame * 3], &frames.channels[3][frame * 3], local);
+
+                if (parentQuantized) { Compose((*parentQuantized)[frame], local, world); }
+                else                 { world = local; }
+
+                error = std::max(error, ShellError(world, (*reference)[frame], shell));
+                if (error > target) { break; }
+            }
+
+            return error;
+        }
+
+        // Fewest bits under the threshold. The error goes down with the bits (close enough), so a binary search
+        uint8_t SearchBits(const AnimationTrack& track, QuantizedTrack& out, float& error)
+        {
+            uint8_t low  = AnimationCompressor::MIN_ROTATION_BITS;
+            uint8_t high = MaxBits(TrackChannel::Rotation);
+
+            if (track.channel != TrackChannel::Rotation)
+            {
+                // Every key the same, the min is all it takes
+                Quantize(track, 0, out);
+                if (out.rangeExtent[0] == 0.0f && out.rangeExtent[1] == 0.0f && out.rangeExtent[2] == 0.0f)
+                {
+                    error = TryBits(track, 0, out);
+                    return 0;
+                }
+
+                low  = 1;
+                high = AnimationCompressor::MAX_QUANTIZED_BITS;
+            }
+
+            error = TryBits(track, high, out);
+            if (error > target)
+            {
+                if (track.channel == TrackChannel::Rotation) { return high; }
+
+                error = TryBits(track, AnimationCompressor::RAW_BITS, out);
+                return AnimationCompressor::RAW_BITS;
+            }
+
+            while (low < high)
+            {
+                uint8_t middle = (uint8_t)((low + high) / 2);
+                if (TryBits(track, middle, out) <= target) { high = middle;                }
+                else                                       { low  = (uint8_t)(middle + 1); }
+            }
+
+            error = TryBits(track, high, out);
+            return high;
+        }
+
+        uint32_t                            frameCount;
+        const AnimationCompressor::Settings& settings;
+        const std::vector<Affine>*          parentQuantized = nullptr;
+        const std::vector<Affine>*          reference       = nullptr;
+        float                               shell           = 0.0f;
+        float                               target          = 0.0f;
+        JointFrames                         frames;
+        AnimationTrack                      decoded;
+    };
+}
+
+
+uint32_t QuantizedTrack::BitsPerKey() const { return KeyBits(channel, bits); }
+
+
+size_t CompressedClip::KeyCount() const
+{
+    size_t keys = 0;
+    for (const QuantizedTrack& track : tracks) { keys += track.frames.size(); }
+    return keys;
+}
+
+
+size_t CompressedClip::DataBytes() const
+{
+    size_t bytes = 0;
+    for (const QuantizedTrack& track : tracks) { bytes += track.data.size(); }
+    return bytes;
+}
+
+
+void AnimationCompressor::DecodeKey(const uint8_t* data, TrackChannel channel, uint8_t bits, const float* rangeMin, const float* rangeExtent, size_t key, float* out)
+{
+    uint64_t position = (uint64_t)key * KeyBits(channel, bits);
+
+    if (channel == TrackChannel::Rotation)
+    {
+        const float scale   = (2.0f * SMALLEST_THREE_RANGE) / (float)MaxQuantized(bits);
+        const int   largest = (int)ReadBits(data, position, 2);
+        float       sum     = 0.0f;
+
+        position += 2;
+        for (int c = 0; c < 4; c++)
+        {
+            if (c == largest) { continue; }
+
+            out[c]    = (float)ReadBits(data, position, bits) * scale - SMALLEST_THREE_RANGE;
+            sum      += out[c] * out[c];
+            position += bits;
+        }
+
+        out[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+        return;
+    }
+
+    for (int c = 0; c < 3; c++)
+    {
+        if (bits == 0)
+        {
+            out[c] = rangeMin[c];
+        }
+        else if (bits == RAW_BITS)
+        {
+            uint32_t raw = ReadBits(data, position, 32);
+            std::memcpy(&out[c], &raw, sizeof(raw));
+        }
+        else
+        {
+            out[c] = rangeMin[c] + (float)ReadBits(data, position, bits) / (float)MaxQuantized(bits) * rangeExtent[c];
+        }
+
+        position += bits;
+    }
+}
+
+
+void AnimationCompressor::Dequantize(const QuantizedTrack& track, AnimationTrack& out)
+{
+    const int components = Components(track.channel);
+
+    out.joint      = track.joint;
+    out.channel    = track.channel;
+    out.components = (uint8_t)components;
+    out.frames     = track.frames;
+    out.values.resize(track.frames.size() * components);
+
+    for (size_t key = 0; key < track.frames.size(); key++)
+    {
+        float* value = &out.values[key * components];
+        DecodeKey(track.data.data(), track.channel, track.bits, track.rangeMin, track.rangeExtent, key, value);
+
+        // Back to the hemisphere of the previous key, the interpolation takes the short way between them
+        if (track.channel == TrackChannel::Rotation && key > 0)
+        {
+            const float* previous = value - 4;
+            if (previous[0] * value[0] + previous[1] * value[1] + previous[2] * value[2] + previous[3] * value[3] < 0.0f)
+            {
+                for (int c = 0; c < 4; c++) { value[c] = -value[c]; }
+            }
+        }
+    }
+}
+
+
+void AnimationCompressor::Decode(const CompressedClip& compressed, ReducedClip& reduced)
+{
+    reduced            = ReducedClip{};
+    reduced.frameRate  = compressed.frameRate;
+    reduced.jointCount = compressed.jointCount;
+    reduced.frameCount = compressed.frameCount;
+    reduced.tracks.resize(compressed.tracks.size());
+
+    for (size_t t = 0; t < compressed.tracks.size(); t++) { Dequantize(compressed.tracks[t], reduced.tracks[t]); }
+}
+
+
+void AnimationCompressor::Compress(const ReducedClip& reduced, const std::vector<int>& parents, const Settings& settings, CompressedClip& compressed, unsigned int threadCount)
+{
+    ExportReport::ScopedTimer timer("compress");
+
+    compressed            = CompressedClip{};
+    compressed.frameRate  = reduced.frameRate;
+    compressed.jointCount = reduced.jointCount;
+    compressed.frameCount = reduced.frameCount;
+    compressed.tracks.resize(reduced.tracks.size());
+
+    const uint32_t jointCount = reduced.jointCount;
+    if (jointCount == 0 || reduced.frameCount == 0) { return; }
+
+    // Tracks of every joint, nullptr for the channels at their rest value
+    std::vector<const AnimationTrack*> jointTracks((size_t)jointCount * CHANNEL_COUNT, nullptr);
+    std::vector<QuantizedTrack*>       jointOutput((size_t)jointCount * CHANNEL_COUNT, nullptr);
+
+    for (size_t t = 0; t < reduced.tracks.size(); t++)
+    {
+        size_t slot = (size_t)reduced.tracks[t].joint * CHANNEL_COUNT + (size_t)reduced.tracks[t].channel;
+        jointTracks[slot] = &reduced.tracks[t];
+        jointOutput[slot] = &compressed.tracks[t];
+    }
+
+    // Levels of the hierarchy, the joints of one level only need the ones above them. Parents out of range (or in a
+    // loop) are treated as the root
+    std::vector<int>                   parentOf(jointCount, -1);
+    std::vector<std::vector<uint32_t>> children(jointCount);
+    std::vector<std::vector<uint32_t>> levels(1);
+    std::vector<bool>                  placed(jointCount, false);
+
+    for (uint32_t joint = 0; joint < jointCount; joint++)
+    {
+        int parent = (joint < parents.size()) ? parents[joint] : -1;
+        if (parent >= 0 && (uint32_t)parent < jointCount && (uint32_t)parent != joint) { parentOf[joint] = parent; children[parent].emplace_back(joint); }
+        else                                                                           { levels[0].emplace_back(joint); placed[joint] = true; }
+    }
+
+    for (size_t placedCount = levels[0].size(); placedCount < jointCount; placedCount += levels.back().size())
+    {
+        std::vector<uint32_t> next;
+        for (uint32_t joint : levels.back())
+        {
+            for (uint32_t child : children[joint]) { if (!placed[child]) { next.emplace_back(child); placed[child] = true; } }
+        }
+
+        // Loops never reach the root, they go last as if they were under it
+        if (next.empty())
+        {
+            for (uint32_t joint = 0; joint < jointCount; joint++)
+            {
+                if (!placed[joint]) { next.emplace_back(joint); placed[joint] = true; parentOf[joint] = -1; break; }
+            }
+        }
+
+        levels.emplace_back(std::move(next));
+    }
+
+    // @note Every joint is measured on top of its quantized parents, so the error adds up down a chain. Each joint gets
+    // a share of the threshold that grows with its depth, so the leaves still end up under it, and gets measured as far
+    // as its farthest descendant goes, where the error of its rotation gets the most amplified
+    std::vector<float>    reach (jointCount, 0.0f);   // Farthest descendant
+    std::vector<uint32_t> height(jointCount, 0);      // Longest chain below
+    std::vector<uint32_t> depth (jointCount, 0);
+
+    for (size_t l = levels.size(); l-- > 0; )
+    {
+        for (uint32_t joint : levels[l])
+        {
+            const AnimationTrack* position = jointTracks[(size_t)joint * CHANNEL_COUNT + (size_t)TrackChannel::Position];
+            const AnimationTrack* scale    = jointTracks[(size_t)joint * CHANNEL_COUNT + (size_t)TrackChannel::Scale];
+
+            float maxScale = 1.0f;
+            if (scale) { for (float value : scale->values) { maxScale = std::max(maxScale, std::fabs(value)); } }
+            reach[joint] *= maxScale;
+
+            int parent = parentOf[joint];
+            if (parent < 0) { continue; }
+
+            float offset = 0.0f;
+            if (position)
+            {
+                for (size_t key = 0; key < position->frames.size(); key++)
+                {
+                    const float* value = &position->values[key * 3];
+                    offset = std::max(offset, std::sqrt(value[0] * value[0] + value[1] * value[1] + value[2] * value[2]));
+                }
+            }
+
+            reach [parent] = std::max(reach [parent], offset + reach[joint]);
+            height[parent] = std::max(height[parent], height[joint] + 1);
+        }
+    }
+
+    for (size_t l = 1; l < levels.size(); l++)
+    {
+        for (uint32_t joint : levels[l]) { if (parentOf[joint] >= 0) { depth[joint] = depth[parentOf[joint]] + 1; } }
+    }
+
+    std::vector<std::vector<Affine>> reference(jointCount), quantized(jointCount);
+    std::vector<float>               jointErrors(jointCount, 0.0f);
+
+    threadCount = Parallel::ThreadCount(threadCount);
+
+    for (const std::vector<uint32_t>& level : levels)
+    {
+        Parallel::ForChunks(level.size(), threadCount,
+            [&](size_t begin, size_t end, unsigned int)
+            {
+                JointCompressor jointCompressor(reduced.frameCount, settings);
+
+                for (size_t l = begin; l < end; l++)
+                {
+                    uint32_t joint  = level[l];
+                    int      parent = parentOf[joint];
+                    float    shell  = settings.shellDistance + reach[joint];
+                    float    target = settings.threshold * (float)(depth[joint] + 1) / (float)(depth[joint] + height[joint] + 1);
+
+                    jointErrors[joint] = jointCompressor.Compress(&jointTracks[(size_t)joint * CHANNEL_COUNT], shell, target,
+                                                                  parent >= 0 ? &reference[parent] : nullptr, parent >= 0 ? &quantized[parent] : nullptr,
+                                                                  reference[joint], quantized[joint], &jointOutput[(size_t)joint * CHANNEL_COUNT]);
+                }
+            }
+        );
+
+        // The parents are done once their children are, only two levels of world transforms are alive at a time
+        for (uint32_t joint : level)
+        {
+            int parent = parentOf[joint];
+            if (parent >= 0 && !reference[parent].empty()) { std::vector<Affine>().swap(reference[parent]); std::vector<Affine>().swap(quantized[parent]); }
+        }
+    }
+
+    compressed.maxError = *std::max_element(jointErrors.begin(), jointErrors.end());
+
+    ExportReport::SetOnActive("quantized_bytes",     compressed.DataBytes());
+    ExportReport::SetOnActive("max_object_error_um", (uint64_t)std::lround(compressed.maxError * 1e4));
+}
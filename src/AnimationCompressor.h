@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "KeyframeReducer.h"
+
+// @note Quantized keys for the reduced tracks (KeyframeReducer.h), the compressed MAF mode.
+// - Rotations are stored as smallest three quaternions: 2 bits for the index of the largest component and the other
+//   three in [-1/sqrt(2), 1/sqrt(2)], [bits] each. The largest one gets rebuilt from the unit length
+// - Position, scale and shear are range reduced per track: min and extent of every component, then [bits] per component.
+//   0 bits when every key is the same (only the min is stored), 32 when 16 bits aren't enough and the floats go as they are
+// - Channels at their rest value (shear most of the times) already have no track after the reduction
+//
+// The bits of every track are the fewest that keep the error under the threshold. The error is measured against the
+// reduced clip in object space, through the joint hierarchy, on points [shellDistance] away from every joint along its
+// axes (roughly where its skin is), so a parent that's a bit off shows up on all of its children. The joints go from the
+// root down, every one of them is measured on top of its already quantized parent.
+//
+struct QuantizedTrack
+{
+    uint32_t              joint      = 0;
+    TrackChannel          channel    = TrackChannel::Position;
+    uint8_t               bits       = 0;       // Per component
+    std::vector<uint32_t> frames;               // Same keys as the reduced track
+    float                 rangeMin   [3] = { 0.0f, 0.0f, 0.0f };   // Not used by rotations
+    float                 rangeExtent[3] = { 0.0f, 0.0f, 0.0f };
+    std::vector<uint8_t>  data;                 // Keys one after the other, BitsPerKey each, LSB first
+
+    uint32_t BitsPerKey() const;
+};
+
+struct CompressedClip
+{
+    float                       frameRate   = 30.0f;
+    uint32_t                    jointCount  = 0;
+    uint32_t                    frameCount  = 0;
+    std::vector<QuantizedTrack> tracks;
+    float                       maxError    = 0.0f;     // Object space, the largest one of every joint and frame
+
+    size_t KeyCount() const;
+    size_t DataBytes() const;
+};
+
+namespace AnimationCompressor
+{
+    constexpr uint8_t RAW_BITS             = 32;
+    constexpr uint8_t MIN_ROTATION_BITS    = 4;
+    constexpr uint8_t MAX_ROTATION_BITS    = 20;
+    constexpr uint8_t MAX_QUANTIZED_BITS   = 16;
+
+    struct Settings
+    {
+        float threshold     = 0.01f;    // Scene units (centimeters in Maya), object space
+        float shellDistance = 3.0f;     // Scene units, how far from the joints the error gets measured
+        int   rotationBits  = 16;       // Most bits per smallest three component, MIN_ROTATION_BITS to MAX_ROTATION_BITS
+    };
+
+    // [parents] in clip order (the root first, -1 for it), see Skeleton::ClipParents
+    void Compress(const ReducedClip& reduced, const std::vector<int>& parents, const Settings& settings, CompressedClip& compressed, unsigned int threadCount = 0);
+
+    // Value of one key, the data of a track on its own. Rotations come out with their largest component positive,
+    // so two consecutive keys can be in opposite hemispheres
+    void DecodeKey(const uint8_t* data, TrackChannel channel, uint8_t bits, const float* rangeMin, const float* rangeExtent, size_t key, float* out);
+
+    // Float keys back, the rotations in the same hemisphere as the key before them
+    void Dequantize(const QuantizedTrack& track, AnimationTrack& out);
+    void Decode    (const CompressedClip& compressed, ReducedClip& reduced);
+}
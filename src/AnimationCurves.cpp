@@ -0,0 +1,198 @@
+#include "AnimationCurves.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace
+{
+    // Value and slope of the segment from [a] to [b], [time] in between them
+    float SegmentValue(const CurveKey& a, const CurveKey& b, float time)
+    {
+        if (time <= a.time)               { return a.value; }
+        if (a.flags & CurveKey::STEP)      { return a.value; }
+        if (a.flags & CurveKey::STEP_NEXT) { return b.value; }
+
+        const float d  = b.time - a.time;
+        const float s  = (time - a.time) / d;
+        const float s2 = s * s;
+        const float s3 = s2 * s;
+
+        return (2.0f * s3 - 3.0f * s2 + 1.0f) * a.value + (s3 - 2.0f * s2 + s) * d * a.outSlope + (-2.0f * s3 + 3.0f * s2) * b.value + (s3 - s2) * d * b.inSlope;
+    }
+
+    float SegmentSlope(const CurveKey& a, const CurveKey& b, float time)
+    {
+        if (a.flags & (CurveKey::STEP | CurveKey::STEP_NEXT)) { return 0.0f; }
+
+        const float d  = b.time - a.time;
+        const float s  = (time - a.time) / d;
+        const float s2 = s * s;
+
+        return ((6.0f * s2 - 6.0f * s) * a.value + (3.0f * s2 - 4.0f * s + 1.0f) * d * a.outSlope + (-6.0f * s2 + 6.0f * s) * b.value + (3.0f * s2 - 2.0f * s) * d * b.inSlope) / d;
+    }
+
+    // First key of the segment holding [time]. [fromLeft] picks the one ending at it when it's on a key instead of the
+    // one starting there. -1 before the first key and after the last one
+    ptrdiff_t FindSegment(const CurveKey* keys, size_t keyCount, float time, bool fromLeft)
+    {
+        const CurveKey* end  = keys + keyCount;
+        const CurveKey* next = fromLeft ? std::lower_bound(keys, end, time, [](const CurveKey& key, float t) { return key.time < t; })
+                                        : std::upper_bound(keys, end, time, [](float t, const CurveKey& key) { return t < key.time; });
+
+        if (next == keys || next == end) { return -1; }
+        return (next - keys) - 1;
+    }
+
+    void Multiply(const double a[4], const double b[4], double out[4])     // Hamilton, b first and then a
+    {
+        double x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        double y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+        double z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+        double w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+
+        out[0] = x; out[1] = y; out[2] = z; out[3] = w;
+    }
+}
+
+
+float AnimationCurves::Evaluate(const CurveKey* keys, size_t keyCount, float time)
+{
+    if (keyCount == 0)                   { return 0.0f; }
+    if (time <= keys[0].time)            { return keys[0].value; }
+    if (time >= keys[keyCount - 1].time) { return keys[keyCount - 1].value; }
+
+    ptrdiff_t segment = FindSegment(keys, keyCount, time, false);
+    return SegmentValue(keys[segment], keys[segment + 1], time);
+}
+
+
+float AnimationCurves::Derivative(const CurveKey* keys, size_t keyCount, float time)
+{
+    ptrdiff_t segment = FindSegment(keys, keyCount, time, true);
+    return segment < 0 ? 0.0f : SegmentSlope(keys[segment], keys[segment + 1], time);
+}
+
+
+std::vector<CurveKey> AnimationCurves::Cut(const std::vector<CurveKey>& keys, float start, float end)
+{
+    std::vector<CurveKey> cut;
+    if (keys.empty()) { return cut; }
+
+    // Start, carrying on the segment it's in. Outside of the keys the value holds, a step keeps it flat up to the first one
+    CurveKey first;
+    first.value = Evaluate(keys.data(), keys.size(), start);
+
+    ptrdiff_t segment = FindSegment(keys.data(), keys.size(), start, false);
+    if (segment < 0)
+    {
+        first.flags = CurveKey::STEP;
+    }
+    else
+    {
+        const CurveKey& a = keys[segment];
+
+        if (a.flags & CurveKey::STEP_NEXT) { first.flags = (start <= a.time) ? CurveKey::STEP_NEXT : CurveKey::STEP; }   // Past the key it's already the next value
+        else                               { first.flags = a.flags; }
+
+        first.outSlope = SegmentSlope(a, keys[segment + 1], start);
+        first.inSlope  = first.outSlope;
+    }
+
+    cut.emplace_back(first);
+
+    // Keys in between as they are
+    for (const CurveKey& key : keys)
+    {
+        if (key.time <= start || key.time >= end) { continue; }
+
+        CurveKey moved = key;
+        moved.time -= start;
+        cut.emplace_back(moved);
+    }
+
+    if (end <= start) { return cut; }
+
+    // Past the last key the value holds
+    if (end > keys.back().time && cut.size() > 1) { cut.back().flags = CurveKey::STEP; }
+
+    CurveKey last;
+    last.time     = end - start;
+    last.value    = Evaluate(keys.data(), keys.size(), end);
+    last.inSlope  = Derivative(keys.data(), keys.size(), end);
+    last.outSlope = last.inSlope;
+
+    cut.emplace_back(last);
+    return cut;
+}
+
+
+void AnimationCurves::Cut(const std::vector<CurveJoint>& joints, float start, float end, std::vector<CurveJoint>& cut)
+{
+    cut.resize(joints.size());
+
+    for (size_t j = 0; j < joints.size(); j++)
+    {
+        cut[j] = joints[j];
+        for (CurveChannel& channel : cut[j].channels) { channel.keys = Cut(channel.keys, start, end); }
+    }
+}
+
+
+void AnimationCurves::Compose(const float* values, int rotateOrder, const float rotateAxis[4], const float jointOrient[4], Transform& transform)
+{
+    // Axes in the order they're applied, like MEulerRotation::RotationOrder
+    static const int ORDERS[6][3] = { { 0, 1, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 0, 2, 1 }, { 1, 0, 2 }, { 2, 1, 0 } };
+
+    const int* order     = ORDERS[(rotateOrder >= 0 && rotateOrder < 6) ? rotateOrder : 0];
+    double     rotate[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+    for (int a = 0; a < 3; a++)
+    {
+        const int    axis  = order[a];
+        const double angle = (double)values[(int)CurveAttribute::RotateX + axis] * 0.5;
+
+        double axisRotation[4] = { 0.0, 0.0, 0.0, std::cos(angle) };
+        axisRotation[axis] = std::sin(angle);
+
+        Multiply(axisRotation, rotate, rotate);
+    }
+
+    // Maya multiplies row vectors, rotateAxis * rotate * jointOrient there is jointOrient (x) rotate (x) rotateAxis here
+    const double axisQuaternion  [4] = { rotateAxis [0], rotateAxis [1], rotateAxis [2], rotateAxis [3] };
+    const double orientQuaternion[4] = { jointOrient[0], jointOrient[1], jointOrient[2], jointOrient[3] };
+
+    double rotation[4];
+    Multiply(rotate, axisQuaternion, rotation);
+    Multiply(orientQuaternion, rotation, rotation);
+
+    for (int c = 0; c < 3; c++)
+    {
+        transform.position[c] = values[(int)CurveAttribute::TranslateX + c];
+        transform.scale   [c] = values[(int)CurveAttribute::ScaleX     + c];
+        transform.shear   [c] = values[(int)CurveAttribute::ShearX     + c];
+    }
+    for (int c = 0; c < 4; c++) { transform.rotation[c] = (float)rotation[c]; }
+}
+
+
+void AnimationCurves::EvaluateJoint(const CurveJoint& joint, float time, Transform& transform)
+{
+    float values[(int)CurveAttribute::Count];
+    std::copy_n(joint.values, (int)CurveAttribute::Count, values);
+
+    for (const CurveChannel& channel : joint.channels) { values[(int)channel.attribute] = Evaluate(channel.keys.data(), channel.keys.size(), time); }
+
+    Compose(values, joint.rotateOrder, joint.rotateAxis, joint.jointOrient, transform);
+}
+
+
+size_t AnimationCurves::KeyCount(const std::vector<CurveJoint>& joints)
+{
+    size_t count = 0;
+    for (const CurveJoint& joint : joints)
+    {
+        for (const CurveChannel& channel : joint.channels) { count += channel.keys.size(); }
+    }
+    return count;
+}
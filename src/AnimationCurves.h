@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Skeleton.h"
+
+// @note Authored animation curves, what "Export Animation Curves" writes for the joints keyed directly by animCurve
+// nodes instead of sampling them (MAF_Helper::GetCurveJoint finds them).
+// Every joint has 12 scalar channels, the ones Maya keys: translate, rotate (euler, radians), scale and shear xyz.
+// A channel is either a curve or a value that never changes. The transform gets built like Maya does it:
+// rotateAxis, then rotate in its rotate order, then jointOrient.
+//
+// The curves are Maya's non weighted ones, a cubic Hermite segment between every two keys with the out slope of the
+// first one and the in slope of the second, or a step. Before the first key and after the last one they hold the value
+// (constant infinity). The times are seconds from the start of the clip, the slopes value units per second.
+//
+enum class CurveAttribute : uint8_t
+{
+    TranslateX = 0, TranslateY, TranslateZ,
+    RotateX,        RotateY,    RotateZ,
+    ScaleX,         ScaleY,     ScaleZ,
+    ShearX,         ShearY,     ShearZ,
+
+    Count
+};
+
+struct CurveKey
+{
+    static constexpr uint32_t STEP      = 1u << 0;  // Holds its value until the next key
+    static constexpr uint32_t STEP_NEXT = 1u << 1;  // Jumps to the value of the next key right after it
+
+    float    time     = 0.0f;
+    float    value    = 0.0f;
+    float    inSlope  = 0.0f;
+    float    outSlope = 0.0f;
+    uint32_t flags    = 0;
+};
+
+static_assert(sizeof(CurveKey) == 20, "CurveKey is written as is in the MAF CKEY chunk");
+
+struct CurveChannel
+{
+    CurveAttribute        attribute = CurveAttribute::TranslateX;
+    std::vector<CurveKey> keys;                 // Ascending times, at least one
+};
+
+struct CurveJoint
+{
+    uint32_t                  joint          = 0;       // Clip joint index, the root is 0
+    int                       rotateOrder    = 0;       // xyz, yzx, zxy, xzy, yxz, zyx like MEulerRotation::RotationOrder
+    float                     rotateAxis [4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    float                     jointOrient[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    float                     values[(int)CurveAttribute::Count] = { 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0 };   // The channels without a curve
+    std::vector<CurveChannel> channels;                 // Sorted by attribute, one per keyed channel at most
+};
+
+namespace AnimationCurves
+{
+    float Evaluate  (const CurveKey* keys, size_t keyCount, float time);
+    float Derivative(const CurveKey* keys, size_t keyCount, float time);      // From the left at a key
+
+    // The piece of a curve between [start] and [end], with keys on both ends and the times moved to start from 0.
+    // A Hermite segment cut anywhere is still one, with the value and the slope of the curve there, so nothing changes
+    std::vector<CurveKey> Cut(const std::vector<CurveKey>& keys, float start, float end);
+    void                  Cut(const std::vector<CurveJoint>& joints, float start, float end, std::vector<CurveJoint>& cut);
+
+    // [values] every channel, the curves already evaluated. Same quaternion MAF_Helper::SampleJoint builds
+    void Compose(const float* values, int rotateOrder, const float rotateAxis[4], const float jointOrient[4], Transform& transform);
+
+    // Every channel at [time], seconds from the start of the clip
+    void EvaluateJoint(const CurveJoint& joint, float time, Transform& transform);
+
+    size_t KeyCount(const std::vector<CurveJoint>& joints);
+}
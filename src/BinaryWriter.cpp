@@ -0,0 +1,18 @@
+#include "BinaryWriter.h"
+
+#include <fstream>
+
+#include "ExportReport.h"
+
+
+bool BinaryWriter::SaveToFile(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) { return false; }
+
+    file.write(reinterpret_cast<const char*>(buffer.data()), (std::streamsize)buffer.size());
+    if (!file) { return false; }
+
+    ExportReport::AddToActive("bytes_written", buffer.size());
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+// @note Every binary file gets built in memory first and then written with a single call, instead of going through
+// std::ofstream::write once per float. Size it up front with the constructor so the buffer never has to grow.
+//
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(size_t capacity = 0) { buffer.reserve(capacity); }
+
+    void Reserve(size_t capacity) { buffer.reserve(capacity); }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain data can be copied into the staging buffer");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void WriteArray(const T* values, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain data can be copied into the staging buffer");
+        WriteBytes(values, sizeof(T) * count);
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        if (size == 0) { return; }
+        std::memcpy(Allocate(size), data, size);
+    }
+
+    // int length followed by the characters, without the null terminator
+    void WriteString(const char* text)
+    {
+        int length = (int)std::strlen(text);
+        Write(length);
+        WriteBytes(text, (size_t)length);
+    }
+
+    // Appends [size] bytes and returns where they start, so big ranges can be filled in place (and in parallel).
+    // The pointer is valid until the next write
+    unsigned char* Allocate(size_t size)
+    {
+        size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        return buffer.data() + offset;
+    }
+
+    size_t               Size() const { return buffer.size(); }
+    const unsigned char* Data() const { return buffer.data(); }
+
+    bool SaveToFile(const std::string& path) const;
+
+private:
+    std::vector<unsigned char> buffer;
+};
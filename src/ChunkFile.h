@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// @note Versioned container shared by the v2 MOF and MAF files:
+//
+//  Header                      32 bytes
+//  ChunkEntry[chunkCount]      24 bytes each
+//  chunks                      every chunk starts at a multiple of ALIGNMENT, the gaps are zeros
+//
+// Offsets are from the start of the file, so a loader can map the file and hand out pointers to the chunks without
+// copying them. Unknown chunk IDs have to be skipped, that's how the format grows without bumping the version.
+//
+namespace ChunkFile
+{
+    constexpr uint32_t ALIGNMENT = 64;
+
+    constexpr uint32_t MakeID(char a, char b, char c, char d)
+    {
+        return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+    }
+
+    constexpr size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+    struct Header
+    {
+        char     magic[4];          // "MOF\0" or "MAF\0"
+        uint16_t version;
+        uint16_t headerSize;        // sizeof(Header), lets newer versions append fields
+        uint32_t chunkCount;
+        uint32_t flags;             // Reserved, 0
+        uint64_t fileSize;
+        uint64_t reserved;
+    };
+
+    struct ChunkEntry
+    {
+        uint32_t id;
+        uint32_t elementStride;     // Bytes per element, 0 if the chunk isn't an array
+        uint64_t offset;
+        uint64_t size;              // Bytes, without the padding
+    };
+
+    static_assert(sizeof(Header)     == 32, "The container header is part of the file format");
+    static_assert(sizeof(ChunkEntry) == 24, "The chunk entries are part of the file format");
+}
@@ -0,0 +1,92 @@
+#include "ChunkWriter.h"
+
+#include <fstream>
+
+#include "ExportReport.h"
+
+
+ChunkWriter::ChunkWriter(const char magic[4], uint16_t version)
+{
+    for (int i = 0; i < 4; i++) { header.magic[i] = magic[i]; }
+
+    header.version    = version;
+    header.headerSize = (uint16_t)sizeof(ChunkFile::Header);
+}
+
+
+BinaryWriter& ChunkWriter::AddChunk(uint32_t id, uint32_t elementStride, size_t capacity)
+{
+    chunks.push_back({ id, elementStride, BinaryWriter(capacity) });
+    return chunks.back().data;
+}
+
+
+ChunkFile::Header ChunkWriter::Layout(std::vector<ChunkFile::ChunkEntry>& directory) const
+{
+    directory.clear();
+    directory.reserve(chunks.size());
+
+    size_t offset = ChunkFile::AlignUp(sizeof(ChunkFile::Header) + chunks.size() * sizeof(ChunkFile::ChunkEntry), ChunkFile::ALIGNMENT);
+    for (const Chunk& chunk : chunks)
+    {
+        directory.push_back({ chunk.id, chunk.elementStride, (uint64_t)offset, (uint64_t)chunk.data.Size() });
+        offset = ChunkFile::AlignUp(offset + chunk.data.Size(), ChunkFile::ALIGNMENT);
+    }
+
+    ChunkFile::Header fileHeader = header;
+    fileHeader.chunkCount = (uint32_t)chunks.size();
+    fileHeader.fileSize   = (uint64_t)offset;
+
+    return fileHeader;
+}
+
+
+bool ChunkWriter::SaveToFile(const std::string& path) const
+{
+    static const char PADDING[ChunkFile::ALIGNMENT] = {};     // The gaps are always shorter than the alignment
+
+    std::vector<ChunkFile::ChunkEntry> directory;
+    const ChunkFile::Header fileHeader = Layout(directory);
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) { return false; }
+
+    file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    file.write(reinterpret_cast<const char*>(directory.data()), (std::streamsize)(directory.size() * sizeof(ChunkFile::ChunkEntry)));
+
+    uint64_t position = sizeof(fileHeader) + directory.size() * sizeof(ChunkFile::ChunkEntry);
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        file.write(PADDING, (std::streamsize)(directory[c].offset - position));
+        file.write(reinterpret_cast<const char*>(chunks[c].data.Data()), (std::streamsize)chunks[c].data.Size());
+
+        position = directory[c].offset + directory[c].size;
+    }
+
+    file.write(PADDING, (std::streamsize)(fileHeader.fileSize - position));
+    if (!file) { return false; }
+
+    ExportReport::AddToActive("bytes_written", fileHeader.fileSize);
+    return true;
+}
+
+
+void ChunkWriter::WriteTo(BinaryWriter& file) const
+{
+    std::vector<ChunkFile::ChunkEntry> directory;
+    const ChunkFile::Header fileHeader = Layout(directory);
+
+    const size_t start = file.Size();
+    file.Reserve(start + (size_t)fileHeader.fileSize);
+
+    file.Write(fileHeader);
+    file.WriteArray(directory.data(), directory.size());
+
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        file.Allocate(start + (size_t)directory[c].offset - file.Size());     // Zeroed padding
+        file.WriteBytes(chunks[c].data.Data(), chunks[c].data.Size());
+    }
+
+    file.Allocate(start + (size_t)fileHeader.fileSize - file.Size());
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "ChunkFile.h"
+#include "BinaryWriter.h"
+
+// @note Builds a ChunkFile container. Every chunk gets its own staging buffer, SaveToFile writes the header and the
+// directory and then every chunk straight from its buffer, one write each, so the file is never assembled in memory.
+//
+class ChunkWriter
+{
+public:
+    ChunkWriter(const char magic[4], uint16_t version);
+
+    // The reference stays valid until SaveToFile, the chunks end up in the file in the order they were added
+    BinaryWriter& AddChunk(uint32_t id, uint32_t elementStride = 0, size_t capacity = 0);
+
+    bool SaveToFile(const std::string& path) const;
+
+    // Appends the whole container to [file], its offsets are from where it starts. For files inside files (a clip
+    // library), which have to start aligned
+    void WriteTo(BinaryWriter& file) const;
+
+private:
+    // The directory of the chunks laid out behind it, and the header with their count and the file size
+    ChunkFile::Header Layout(std::vector<ChunkFile::ChunkEntry>& directory) const;
+
+    struct Chunk
+    {
+        uint32_t     id;
+        uint32_t     elementStride;
+        BinaryWriter data;
+    };
+
+    ChunkFile::Header header{};
+    std::deque<Chunk> chunks;
+};
@@ -0,0 +1,154 @@
+#include "ClipTable.h"
+
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+
+
+bool ClipTable::Parse(const std::string& text, std::vector<ClipRange>& clips, std::string& error)
+{
+    clips.clear();
+
+    std::string entries = text;
+    std::replace(entries.begin(), entries.end(), '\n', ';');
+
+    std::istringstream stream(entries);
+    std::string        entry;
+
+    while (std::getline(stream, entry, ';'))
+    {
+        std::istringstream fields(entry);
+        std::string        name, flag;
+        ClipRange          clip;
+
+        if (!(fields >> name)) { continue; }   // Empty entry
+
+        if (!(fields >> clip.start >> clip.end))  { error = "Clip [ " + name + " ] needs a start and an end frame"; return false; }
+        if (clip.end < clip.start)                { error = "Clip [ " + name + " ] ends before it starts";         return false; }
+
+        if (fields >> flag)
+        {
+            if (flag != "loop") { error = "Clip [ " + name + " ] has an unknown flag [ " + flag + " ]"; return false; }
+            clip.loop = true;
+        }
+        if (fields >> flag) { error = "Clip [ " + name + " ] has too many fields"; return false; }
+
+        for (const ClipRange& other : clips)
+        {
+            if (other.name == name) { error = "Clip [ " + name + " ] is there twice"; return false; }
+        }
+
+        clip.name = name;
+        clips.emplace_back(clip);
+    }
+
+    return true;
+}
+
+
+std::vector<double> ClipTable::SampleTimes(const ClipRange& range, double sceneRate, double sampleRate)
+{
+    // Timeline frames between two samples. The times are start + k * step, computed the same way for every caller so the
+    // ones of a clip are found again in the union
+    const double step  = (sampleRate > 0.0 && sceneRate > 0.0) ? sceneRate / sampleRate : 1.0;
+    const size_t count = (size_t)std::floor((double)(range.end - range.start) / step + 1e-6) + 1;
+
+    std::vector<double> times(count);
+    for (size_t k = 0; k < count; k++) { times[k] = (double)range.start + (double)k * step; }
+
+    return times;
+}
+
+
+std::vector<double> ClipTable::UnionTimes(const std::vector<ClipRange>& clips, double sceneRate, double sampleRate)
+{
+    std::vector<double> times;
+
+    for (const ClipRange& clip : clips)
+    {
+        std::vector<double> clipTimes = SampleTimes(clip, sceneRate, sampleRate);
+        times.insert(times.end(), clipTimes.begin(), clipTimes.end());
+    }
+
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    return times;
+}
+
+
+void ClipTable::Extract(const AnimationClip& sampled, const std::vector<double>& times, const ClipRange& range, double sceneRate, double sampleRate, AnimationClip& clip)
+{
+    std::vector<double> clipTimes = SampleTimes(range, sceneRate, sampleRate);
+
+    clip.frameRate  = sampled.frameRate;
+    clip.jointCount = sampled.jointCount;
+    clip.frameCount = (uint32_t)clipTimes.size();
+    clip.transforms.resize((size_t)clip.frameCount * clip.jointCount);
+
+    // Every time of the range is in [times], but with other clips' times in between when their samples don't line up
+    for (uint32_t frame = 0; frame < clip.frameCount; frame++)
+    {
+        size_t source = (size_t)(std::lower_bound(times.begin(), times.end(), clipTimes[frame]) - times.begin());
+        std::copy_n(&sampled.At((uint32_t)source, 0), clip.jointCount, &clip.At(frame, 0));
+    }
+}
+
+
+void ClipTable::Resample(const AnimationClip& timeline, const std::vector<double>& times, AnimationClip& sampled)
+{
+    sampled.jointCount = timeline.jointCount;
+    sampled.frameCount = (uint32_t)times.size();
+    sampled.transforms.resize((size_t)sampled.frameCount * sampled.jointCount);
+
+    if (timeline.frameCount == 0) { return; }
+
+    for (uint32_t frame = 0; frame < sampled.frameCount; frame++)
+    {
+        const double   time  = std::clamp(times[frame], 0.0, (double)(timeline.frameCount - 1));
+        const uint32_t first = (uint32_t)time;
+        const uint32_t next  = std::min(first + 1, timeline.frameCount - 1);
+        const float    t     = (float)(time - (double)first);
+
+        // Whole frames as they are
+        if (t == 0.0f) { std::copy_n(&timeline.At(first, 0), sampled.jointCount, &sampled.At(frame, 0)); continue; }
+
+        for (uint32_t joint = 0; joint < sampled.jointCount; joint++)
+        {
+            const Transform& a   = timeline.At(first, joint);
+            const Transform& b   = timeline.At(next,  joint);
+            Transform&       out = sampled.At(frame, joint);
+
+            for (int c = 0; c < 3; c++)
+            {
+                out.position[c] = a.position[c] + (b.position[c] - a.position[c]) * t;
+                out.scale   [c] = a.scale   [c] + (b.scale   [c] - a.scale   [c]) * t;
+                out.shear   [c] = a.shear   [c] + (b.shear   [c] - a.shear   [c]) * t;
+            }
+
+            // nlerp the short way
+            const float sign   = (a.rotation[0] * b.rotation[0] + a.rotation[1] * b.rotation[1] + a.rotation[2] * b.rotation[2] + a.rotation[3] * b.rotation[3] < 0.0f) ? -1.0f : 1.0f;
+            float       length = 0.0f;
+
+            for (int c = 0; c < 4; c++)
+            {
+                out.rotation[c] = a.rotation[c] + (b.rotation[c] * sign - a.rotation[c]) * t;
+                length         += out.rotation[c] * out.rotation[c];
+            }
+
+            length = std::sqrt(length);
+            if (length > 0.0f) { for (int c = 0; c < 4; c++) { out.rotation[c] /= length; } }
+        }
+    }
+}
+
+
+std::string ClipTable::ClipPath(const std::string& path, const std::string& name)
+{
+    size_t slash = path.find_last_of("/\\");
+    size_t dot   = path.find_last_of('.');
+
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) { return path + "_" + name; }
+
+    return path.substr(0, dot) + "_" + name + path.substr(dot);
+}
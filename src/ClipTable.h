@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Skeleton.h"
+
+// @note Named frame ranges of one timeline (walk, run, idle...) so every clip comes out of a single sampling pass.
+// The timeline gets sampled once on the union of the sample times of every range (overlapping ones share theirs) and
+// every clip is cut out of that afterwards.
+//
+//  "walk 0 30 loop; run 31 60 loop; idle 61 120"      name start end [loop], inclusive timeline frames
+//
+// The sample times don't need to be whole frames. With an output sample rate other than the scene one, a range gets a
+// sample every sceneRate / sampleRate frames from its start (the last one at or before its end), so a 120 fps scene
+// can be exported at 30 Hz, or a 24 fps one at 60 Hz evaluated in between its frames.
+//
+struct ClipRange
+{
+    std::string name;
+    int32_t     start = 0;
+    int32_t     end   = 0;      // Inclusive
+    bool        loop  = false;
+};
+
+namespace ClipTable
+{
+    // Entries separated by ';' or new lines. Fails on a malformed entry, an end before its start or a repeated name
+    bool Parse(const std::string& text, std::vector<ClipRange>& clips, std::string& error);
+
+    // Timeline frames (fractional ones too) a range gets sampled at. [sampleRate] 0 = the scene rate, every whole frame
+    std::vector<double> SampleTimes(const ClipRange& range, double sceneRate, double sampleRate);
+
+    // The SampleTimes of every clip, ascending and once each
+    std::vector<double> UnionTimes(const std::vector<ClipRange>& clips, double sceneRate, double sampleRate);
+
+    // [sampled] holds a frame per [times] entry, the result of sampling UnionTimes. Copies the ones of [range]
+    void Extract(const AnimationClip& sampled, const std::vector<double>& times, const ClipRange& range, double sceneRate, double sampleRate, AnimationClip& clip);
+
+    // For timelines that only exist as whole frames already sampled from frame 0 (the stand-in scenes): [times] get
+    // interpolated between their frames, linearly and with nlerp for the rotations. The times are clamped to the timeline
+    void Resample(const AnimationClip& timeline, const std::vector<double>& times, AnimationClip& sampled);
+
+    // "dir/anim.maf" + "walk" = "dir/anim_walk.maf"
+    std::string ClipPath(const std::string& path, const std::string& name);
+}
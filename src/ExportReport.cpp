@@ -0,0 +1,207 @@
+#include "ExportReport.h"
+#include "MemoryTracker.h"
+
+#include <fstream>
+
+namespace
+{
+    thread_local ExportReport* activeReport = nullptr;
+
+    void WriteJsonString(std::ofstream& file, const std::string& text)
+    {
+        file << '"';
+        for (char c : text)
+        {
+            switch (c)
+            {
+                case '"':  file << "\\\""; break;
+                case '\\': file << "\\\\"; break;
+                case '\n': file << "\\n";  break;
+                case '\t': file << "\\t";  break;
+                default:   if ((unsigned char)c >= 0x20) { file << c; } break;
+            }
+        }
+        file << '"';
+    }
+}
+
+
+ExportReport::ExportReport() : created(std::chrono::high_resolution_clock::now()), createdAllocations(MemoryTracker::Allocations())
+{
+}
+
+
+ExportReport::Stage& ExportReport::FindStage(const std::string& stage)
+{
+    for (Stage& existing : stages)
+    {
+        if (existing.name == stage) { return existing; }
+    }
+
+    stages.push_back({ stage });
+    return stages.back();
+}
+
+
+void ExportReport::AddTime(const std::string& stage, double seconds)
+{
+    Stage& existing = FindStage(stage);
+    existing.seconds += seconds;
+    existing.calls++;
+}
+
+
+void ExportReport::AddMemory(const std::string& stage, uint64_t processBytes, uint64_t peakBytes, uint64_t allocations)
+{
+    Stage& existing = FindStage(stage);
+    existing.processBytes = processBytes;
+    existing.peakBytes    = (peakBytes > existing.peakBytes) ? peakBytes : existing.peakBytes;
+    existing.allocations += allocations;
+}
+
+
+void ExportReport::AddCount(const std::string& counter, uint64_t amount)
+{
+    for (auto& existing : counters)
+    {
+        if (existing.first == counter) { existing.second += amount; return; }
+    }
+
+    counters.emplace_back(counter, amount);
+}
+
+
+void ExportReport::SetCount(const std::string& counter, uint64_t value)
+{
+    for (auto& existing : counters)
+    {
+        if (existing.first == counter) { existing.second = value; return; }
+    }
+
+    counters.emplace_back(counter, value);
+}
+
+
+void ExportReport::SetInfo(const std::string& key, const std::string& value)
+{
+    for (auto& existing : info)
+    {
+        if (existing.first == key) { existing.second = value; return; }
+    }
+
+    info.emplace_back(key, value);
+}
+
+
+uint64_t ExportReport::GetCount(const std::string& counter) const
+{
+    for (const auto& existing : counters)
+    {
+        if (existing.first == counter) { return existing.second; }
+    }
+    return 0;
+}
+
+
+double ExportReport::GetSeconds(const std::string& stage) const
+{
+    for (const Stage& existing : stages)
+    {
+        if (existing.name == stage) { return existing.seconds; }
+    }
+    return 0.0;
+}
+
+
+double ExportReport::TotalSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - created).count();
+}
+
+
+bool ExportReport::SaveJson(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) { return false; }
+
+    file.precision(9);
+    file << "{\n";
+
+    for (const auto& entry : info)
+    {
+        file << "  "; WriteJsonString(file, entry.first); file << ": "; WriteJsonString(file, entry.second); file << ",\n";
+    }
+
+    file << "  \"totalSeconds\": " << TotalSeconds() << ",\n";
+
+    file << "  \"stages\": [";
+    for (size_t s = 0; s < stages.size(); s++)
+    {
+        file << (s == 0 ? "\n    " : ",\n    ") << "{ \"name\": "; WriteJsonString(file, stages[s].name);
+        file << ", \"seconds\": " << stages[s].seconds << ", \"calls\": " << stages[s].calls;
+        file << ", \"processBytes\": " << stages[s].processBytes;
+        if (MemoryTracker::HeapTracking()) { file << ", \"peakBytes\": " << stages[s].peakBytes << ", \"allocations\": " << stages[s].allocations; }
+        file << " }";
+    }
+    file << (stages.empty() ? "],\n" : "\n  ],\n");
+
+    file << "  \"counters\": {";
+    for (size_t c = 0; c < counters.size(); c++)
+    {
+        file << (c == 0 ? "\n    " : ",\n    "); WriteJsonString(file, counters[c].first); file << ": " << counters[c].second;
+    }
+    file << (counters.empty() ? "},\n" : "\n  },\n");
+
+    file << "  \"memory\": { \"processPeakBytes\": " << MemoryTracker::ProcessPeakBytes();
+    if (MemoryTracker::HeapTracking())
+    {
+        file << ", \"heapPeakBytes\": " << MemoryTracker::HeapPeakBytes() << ", \"allocations\": " << MemoryTracker::Allocations() - createdAllocations;
+    }
+    file << " }\n";
+
+    file << "}\n";
+    return (bool)file;
+}
+
+
+ExportReport* ExportReport::Active()
+{
+    return activeReport;
+}
+
+
+ExportReport::Scope::Scope(ExportReport& report) : previous(activeReport), outerPeakBytes(MemoryTracker::ResetHeapPeak())
+{
+    activeReport = &report;
+}
+
+
+ExportReport::Scope::~Scope()
+{
+    activeReport = previous;
+    MemoryTracker::RestoreHeapPeak(outerPeakBytes);
+}
+
+
+ExportReport::ScopedTimer::ScopedTimer(const char* stage) : report(activeReport), stage(stage)
+{
+    if (!report) { return; }
+
+    outerPeakBytes   = MemoryTracker::ResetHeapPeak();
+    startAllocations = MemoryTracker::Allocations();
+    start            = std::chrono::high_resolution_clock::now();
+}
+
+
+ExportReport::ScopedTimer::~ScopedTimer()
+{
+    if (!report) { return; }
+
+    double   seconds     = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    uint64_t peakBytes   = MemoryTracker::HeapPeakBytes();
+    uint64_t allocations = MemoryTracker::Allocations() - startAllocations;
+    MemoryTracker::RestoreHeapPeak(outerPeakBytes);
+
+    report->AddTime  (stage, seconds);
+    report->AddMemory(stage, MemoryTracker::ProcessBytes(), peakBytes, allocations);
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+// @note Wall time, memory per stage and counters of one export, saved as JSON next to the exported file so the numbers of a
+// lot of assets can be aggregated. The exporter activates a report with Scope for the whole export and every stage
+// records into whichever report is active, so nothing has to be passed around. With no active report ScopedTimer
+// and the static helpers do nothing. The active report belongs to the thread that activated it, the worker threads
+// of the parallel stages don't record.
+//
+// Every stage also gets the process resident set when it last finished and, when the build tracks the heap (see
+// MemoryTracker.h), the highest heap usage while it ran and how many allocations it made. Allocations of the worker
+// threads are counted in the stage that started them. "memory" holds the totals of the whole export, the heap peak
+// counts from when the Scope was created, so SaveJson has to be called before it goes away.
+//
+//  {
+//    "exporter": "MOF", "file": "...", ...                       SetInfo
+//    "totalSeconds": 1.5,
+//    "stages":   [ { "name": "weld", "seconds": 0.4, "calls": 1,                   In the order they first ran
+//                    "processBytes": 1e8, "peakBytes": 5e7, "allocations": 12 }, ... ]
+//    "counters": { "vertices": 1000, "maya_calls": 42, ... },
+//    "memory":   { "processPeakBytes": 2e8, "heapPeakBytes": 9e7, "allocations": 300 }
+//  }
+//
+// "maya_calls" counts the Maya API methods that read the scene (function sets, plugs, anim curves), each one where it's
+// called (ScopedCount). Function set constructors and handle checks like MPlug::isNull aren't counted.
+//
+class ExportReport
+{
+public:
+    struct Stage
+    {
+        std::string name;
+        double      seconds = 0.0;
+        uint64_t    calls   = 0;
+
+        uint64_t    processBytes = 0;     // Resident set when the last call finished
+        uint64_t    peakBytes    = 0;     // Highest heap usage of all the calls, only with heap tracking
+        uint64_t    allocations  = 0;
+    };
+
+    ExportReport();
+
+    void     AddTime (const std::string& stage, double seconds);
+    void     AddMemory(const std::string& stage, uint64_t processBytes, uint64_t peakBytes, uint64_t allocations);
+    void     AddCount(const std::string& counter, uint64_t amount = 1);
+    void     SetCount(const std::string& counter, uint64_t value);
+    void     SetInfo (const std::string& key, const std::string& value);
+
+    uint64_t GetCount    (const std::string& counter) const;   // 0 if it was never recorded
+    double   GetSeconds  (const std::string& stage)   const;
+    double   TotalSeconds() const;
+
+    const std::vector<Stage>& Stages() const { return stages; }
+
+    bool     SaveJson(const std::string& path) const;
+
+    // Report every stage records into until the Scope goes away (the previous one gets restored)
+    static ExportReport* Active();
+
+    class Scope
+    {
+    public:
+        explicit Scope(ExportReport& report);
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ExportReport* previous;
+        uint64_t      outerPeakBytes;
+    };
+
+    // Adds the time, peak heap and allocations between construction and destruction to [stage] of the active report
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const char* stage);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&)            = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        ExportReport*                                  report;
+        const char*                                    stage;
+        std::chrono::high_resolution_clock::time_point start;
+        uint64_t                                       outerPeakBytes   = 0;
+        uint64_t                                       startAllocations = 0;
+    };
+
+    // Counts in a local and adds the total to [counter] of the active report when it goes away, one lookup however many
+    // times it's bumped. Wraps the call it counts where it's made: status = calls(plug.getValue(value))
+    class ScopedCount
+    {
+    public:
+        explicit ScopedCount(const char* counter) : counter(counter) {}
+        ~ScopedCount() { if (count > 0) { AddToActive(counter, count); } }
+
+        ScopedCount(const ScopedCount&)            = delete;
+        ScopedCount& operator=(const ScopedCount&) = delete;
+
+        template <typename Result>
+        Result operator()(Result result) { count++; return result; }
+
+    private:
+        const char* counter;
+        uint64_t    count = 0;
+    };
+
+    static void AddToActive(const char* counter, uint64_t amount = 1) { if (ExportReport* report = Active()) { report->AddCount(counter, amount); } }
+    static void SetOnActive(const char* counter, uint64_t value)      { if (ExportReport* report = Active()) { report->SetCount(counter, value);  } }
+
+private:
+    Stage& FindStage(const std::string& stage);
+
+    std::chrono::high_resolution_clock::time_point     created;
+    uint64_t                                           createdAllocations;
+    std::vector<Stage>                                 stages;
+    std::vector<std::pair<std::string, uint64_t>>      counters;
+    std::vector<std::pair<std::string, std::string>>   info;
+};
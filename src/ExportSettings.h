@@ -0,0 +1,33 @@
+#pragma once
+
+#include "VertexFormat.h"
+#include "KeyframeReducer.h"
+#include "AnimationCompressor.h"
+#include "ClipTable.h"
+
+struct MeshExportSettings
+{
+    bool         deduplicate     = false;
+    int          maxInfluences   = 4;     // 4 or 8
+    unsigned int threadCount     = 0;     // 0 = every core. The exported file is the same whatever the amount of threads
+    bool         optimizeIndices = false; // Reorder the triangles for the post transform cache and overdraw
+    VertexLayout vertexLayout    = VertexLayout::Float;
+    bool         chunkedFile     = false; // Versioned MOF v2 container with aligned chunks (MOF_Format.h), binary only
+    bool         writeReport     = false; // Stage timings and counters in [path].report.json (ExportReport.h)
+};
+
+struct AnimationExportSettings
+{
+    bool         deduplicate     = false; // Keyframe reduction, sparse MAF v2 tracks instead of every frame (KeyframeReducer.h)
+    KeyframeReducer::Tolerance keyTolerance;
+    bool         compress        = false; // Quantized keys, the bits of every track picked by their object space error (AnimationCompressor.h)
+    AnimationCompressor::Settings compression;
+    uint32_t     segmentFrames   = 0;     // Every frame in track-major blocks of this many frames (MAF v2 segmented), 0 = frame after frame
+    float        sampleRate      = 0.0f;  // Samples per second of the exported clips, in the MAF header too. 0 = the scene frame rate
+    std::vector<ClipRange> clips;         // Sampled in one pass and written as a clip library. Empty = the playback range as a single clip
+    bool         clipFiles       = false; // A file per clip ([path]_[name].maf) instead of the library
+    bool         animationCurves = false; // The authored animCurve keys of the directly keyed joints instead of sampling them (AnimationCurves.h), binary only
+    bool         matrixPalette   = false; // Skinning matrices of every joint and frame instead of the local transforms (MatrixPalette.h), binary only
+    bool         halfMatrices    = false; // The palette in half floats
+    bool         writeReport     = false; // Stage timings and counters in [path].report.json (ExportReport.h)
+};
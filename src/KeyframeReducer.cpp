@@ -0,0 +1,317 @@
+#include "KeyframeReducer.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Parallel.h"
+#include "ExportReport.h"
+
+namespace
+{
+    constexpr int CHANNEL_COUNT = 4;
+
+    const float REST_POSITION[3] = { 0.0f, 0.0f, 0.0f };
+    const float REST_ROTATION[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const float REST_SCALE   [3] = { 1.0f, 1.0f, 1.0f };
+    const float REST_SHEAR   [3] = { 0.0f, 0.0f, 0.0f };
+
+    int Components(TrackChannel channel) { return (channel == TrackChannel::Rotation) ? 4 : 3; }
+
+    const float* ChannelOf(const Transform& transform, TrackChannel channel)
+    {
+        switch (channel)
+        {
+            case TrackChannel::Position: return transform.position;
+            case TrackChannel::Rotation: return transform.rotation;
+            case TrackChannel::Scale:    return transform.scale;
+            default:                     return transform.shear;
+        }
+    }
+
+    float* ChannelOf(Transform& transform, TrackChannel channel) { return const_cast<float*>(ChannelOf((const Transform&)transform, channel)); }
+
+    void Interpolate(const float* a, const float* b, float t, int components, float* out)
+    {
+        for (int c = 0; c < components; c++) { out[c] = a[c] + (b[c] - a[c]) * t; }
+
+        // nlerp, the keys of a rotation track are kept in the same hemisphere so the short way is always the straight one
+        if (components == 4)
+        {
+            float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]);
+            if (length > 0.0f) { for (int c = 0; c < 4; c++) { out[c] /= length; } }
+        }
+    }
+
+    // Whether [value] is close enough to [reference] for the channel
+    class ErrorCheck
+    {
+    public:
+        ErrorCheck(TrackChannel channel, const KeyframeReducer::Tolerance& tolerance) : channel(channel)
+        {
+            switch (channel)
+            {
+                case TrackChannel::Position: limit = tolerance.position * tolerance.position; break;
+                case TrackChannel::Rotation: limit = ChordSquared(tolerance.rotation);        break;
+                default:                     limit = tolerance.scale;                         break;
+            }
+        }
+
+        bool Within(const float* value, const float* reference) const
+        {
+            switch (channel)
+            {
+                case TrackChannel::Position:
+                {
+                    float distance = 0.0f;
+                    for (int c = 0; c < 3; c++) { float d = value[c] - reference[c]; distance += d * d; }
+                    return distance <= limit;
+                }
+
+                case TrackChannel::Rotation:
+                {
+                    float difference = 0.0f, sum = 0.0f;
+                    for (int c = 0; c < 4; c++)
+                    {
+                        difference += (value[c] - reference[c]) * (value[c] - reference[c]);
+                        sum        += (value[c] + reference[c]) * (value[c] + reference[c]);
+                    }
+                    return std::min(difference, sum) <= limit;
+                }
+
+                default:
+                {
+                    for (int c = 0; c < 3; c++) { if (std::fabs(value[c] - reference[c]) > limit) { return false; } }
+                    return true;
+                }
+            }
+        }
+
+    private:
+        // @note Two unit quaternions [angle] apart are 2 sin(angle / 4) away from each other (the closest of q and -q).
+        // Comparing that distance keeps its precision for tiny angles, the usual |dot| >= cos(angle / 2) rounds to 1 in floats
+        static float ChordSquared(float angle)
+        {
+            float chord = 2.0f * std::sin(std::min(angle, 6.28f) * 0.25f);
+            return chord * chord;
+        }
+
+        TrackChannel channel;
+        float        limit;
+    };
+
+    // Every frame strictly between start and end is reproduced by interpolating the two of them
+    bool SegmentFits(const std::vector<float>& samples, int components, size_t start, size_t end, const ErrorCheck& check)
+    {
+        const float* a = &samples[start * components];
+        const float* b = &samples[end   * components];
+        float        interpolated[4];
+
+        for (size_t frame = start + 1; frame < end; frame++)
+        {
+            Interpolate(a, b, (float)(frame - start) / (float)(end - start), components, interpolated);
+            if (!check.Within(interpolated, &samples[frame * components])) { return false; }
+        }
+        return true;
+    }
+
+    void AddKey(AnimationTrack& track, const std::vector<float>& samples, size_t frame)
+    {
+        track.frames.emplace_back((uint32_t)frame);
+        track.values.insert(track.values.end(), samples.begin() + frame * track.components, samples.begin() + (frame + 1) * track.components);
+    }
+
+    // Returns false if the channel stays at its rest value, no track needed
+    bool ReduceChannel(const AnimationClip& clip, uint32_t joint, TrackChannel channel, const KeyframeReducer::Tolerance& tolerance,
+                       std::vector<float>& samples, AnimationTrack& track)
+    {
+        const int    components = Components(channel);
+        const size_t frameCount = clip.frameCount;
+
+        // Contiguous copy of the channel, the clip is frame major
+        samples.resize(frameCount * components);
+        for (size_t frame = 0; frame < frameCount; frame++)
+        {
+            std::copy_n(ChannelOf(clip.At((uint32_t)frame, joint), channel), components, &samples[frame * components]);
+        }
+
+        // q and -q are the same rotation, flip them so consecutive samples never cross hemispheres
+        if (channel == TrackChannel::Rotation)
+        {
+            for (size_t frame = 1; frame < frameCount; frame++)
+            {
+                float* previous = &samples[(frame - 1) * 4];
+                float* current  = &samples[frame * 4];
+
+                if (previous[0] * current[0] + previous[1] * current[1] + previous[2] * current[2] + previous[3] * current[3] < 0.0f)
+                {
+                    for (int c = 0; c < 4; c++) { current[c] = -current[c]; }
+                }
+            }
+        }
+
+        ErrorCheck check(channel, tolerance);
+
+        track            = AnimationTrack{};
+        track.joint      = joint;
+        track.channel    = channel;
+        track.components = (uint8_t)components;
+
+        // Constant channels
+        bool atRest   = true;
+        bool constant = true;
+        for (size_t frame = 0; frame < frameCount && (atRest || constant); frame++)
+        {
+            atRest   = atRest   && check.Within(&samples[frame * components], KeyframeReducer::RestValue(channel));
+            constant = constant && check.Within(&samples[frame * components], &samples[0]);
+        }
+
+        if (atRest)   { return false; }
+        if (constant) { AddKey(track, samples, 0); return true; }
+
+        // Greedy, every key reaches as far as it can. The reach grows by doubling and then gets narrowed down with a
+        // binary search, so a long linear stretch costs O(n log n) checks instead of O(n^2)
+        const size_t last  = frameCount - 1;
+        size_t       start = 0;
+
+        AddKey(track, samples, 0);
+
+        while (start < last)
+        {
+            size_t good = start + 1;
+            size_t bad  = 0;      // 0 = no failing end found yet
+
+            for (size_t length = 2; start + length <= last; length *= 2)
+            {
+                if (SegmentFits(samples, components, start, start + length, check)) { good = start + length; }
+                else                                                                { bad  = start + length; break; }
+            }
+
+            if (bad == 0 && good < last)
+            {
+                if (SegmentFits(samples, components, start, last, check)) { good = last; }
+                else                                                      { bad  = last; }
+            }
+
+            while (bad > good + 1)
+            {
+                size_t middle = good + (bad - good) / 2;
+
+                if (SegmentFits(samples, components, start, middle, check)) { good = middle; }
+                else                                                        { bad  = middle; }
+            }
+
+            AddKey(track, samples, good);
+            start = good;
+        }
+
+        return true;
+    }
+}
+
+
+size_t ReducedClip::KeyCount() const
+{
+    size_t keys = 0;
+    for (const AnimationTrack& track : tracks) { keys += track.frames.size(); }
+    return keys;
+}
+
+
+const float* KeyframeReducer::RestValue(TrackChannel channel)
+{
+    switch (channel)
+    {
+        case TrackChannel::Position: return REST_POSITION;
+        case TrackChannel::Rotation: return REST_ROTATION;
+        case TrackChannel::Scale:    return REST_SCALE;
+        default:                     return REST_SHEAR;
+    }
+}
+
+
+void KeyframeReducer::Reduce(const AnimationClip& clip, const Tolerance& tolerance, ReducedClip& reduced, unsigned int threadCount)
+{
+    ExportReport::ScopedTimer timer("reduce");
+
+    reduced            = ReducedClip{};
+    reduced.frameRate  = clip.frameRate;
+    reduced.jointCount = clip.jointCount;
+    reduced.frameCount = clip.frameCount;
+
+    if (clip.frameCount == 0 || clip.jointCount == 0) { return; }
+
+    // @note Joints are independent, every thread reduces a contiguous range of them and the tracks get appended in joint order
+    threadCount = Parallel::ThreadCount(threadCount);
+
+    std::vector<std::vector<AnimationTrack>> chunkTracks(threadCount);
+
+    Parallel::ForChunks(clip.jointCount, threadCount,
+        [&](size_t begin, size_t end, unsigned int chunkIdx)
+        {
+            std::vector<float> samples;
+            AnimationTrack     track;
+
+            for (size_t joint = begin; joint < end; joint++)
+            {
+                for (int channel = 0; channel < CHANNEL_COUNT; channel++)
+                {
+                    if (ReduceChannel(clip, (uint32_t)joint, (TrackChannel)channel, tolerance, samples, track))
+                    {
+                        chunkTracks[chunkIdx].emplace_back(std::move(track));
+                    }
+                }
+            }
+        }
+    );
+
+    for (std::vector<AnimationTrack>& tracks : chunkTracks)
+    {
+        for (AnimationTrack& track : tracks) { reduced.tracks.emplace_back(std::move(track)); }
+    }
+
+    ExportReport::SetOnActive("tracks",       reduced.tracks.size());
+    ExportReport::SetOnActive("keys",         reduced.KeyCount());
+    ExportReport::SetOnActive("dense_keys",   (uint64_t)clip.jointCount * CHANNEL_COUNT * clip.frameCount);
+}
+
+
+void KeyframeReducer::Evaluate(const AnimationTrack& track, float frame, float* out)
+{
+    const size_t keyCount = track.frames.size();
+
+    if (keyCount == 1 || frame <= (float)track.frames.front())
+    {
+        std::copy_n(track.values.data(), track.components, out);
+        return;
+    }
+
+    if (frame >= (float)track.frames.back())
+    {
+        std::copy_n(track.values.data() + (keyCount - 1) * track.components, track.components, out);
+        return;
+    }
+
+    // First key after the frame, there's always one before it
+    size_t next     = (size_t)(std::upper_bound(track.frames.begin(), track.frames.end(), frame, [](float f, uint32_t key) { return f < (float)key; }) - track.frames.begin());
+    size_t previous = next - 1;
+    float  t        = (frame - (float)track.frames[previous]) / (float)(track.frames[next] - track.frames[previous]);
+
+    Interpolate(&track.values[previous * track.components], &track.values[next * track.components], t, track.components, out);
+}
+
+
+void KeyframeReducer::Decode(const ReducedClip& reduced, AnimationClip& clip)
+{
+    clip.frameRate  = reduced.frameRate;
+    clip.jointCount = reduced.jointCount;
+    clip.frameCount = reduced.frameCount;
+    clip.transforms.assign((size_t)clip.frameCount * clip.jointCount, Transform{});
+
+    for (const AnimationTrack& track : reduced.tracks)
+    {
+        for (uint32_t frame = 0; frame < clip.frameCount; frame++)
+        {
+            Evaluate(track, (float)frame, ChannelOf(clip.At(frame, track.joint), track.channel));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Skeleton.h"
+
+// @note Per channel keyframe reduction of a sampled clip, what "Deduplicate Keyframes" exports.
+// Every joint has 4 channels (position, rotation, scale, shear) and each one becomes a track on its own:
+// 1. A channel that stays at its rest value (position 0, rotation identity, scale 1, shear 0) gets no track at all
+// 2. A channel that doesn't change gets a single key
+// 3. Otherwise the keys that interpolation between their neighbours reproduces within the tolerance get dropped.
+//    Position, scale and shear interpolate linearly, rotation with nlerp (normalized linear interpolation).
+//    The first and the last frame always keep their key
+//
+// Every dropped key is checked against the sampled value, so the decoded clip is never further than the tolerance
+// from the sampled one on any frame.
+//
+enum class TrackChannel : uint8_t
+{
+    Position = 0,
+    Rotation = 1,
+    Scale    = 2,
+    Shear    = 3,
+};
+
+struct AnimationTrack
+{
+    uint32_t              joint      = 0;       // Clip joint index, the root is 0
+    TrackChannel          channel    = TrackChannel::Position;
+    uint8_t               components = 3;       // 4 for rotations
+    std::vector<uint32_t> frames;               // Ascending, the first one is always 0
+    std::vector<float>    values;               // [frames.size() * components]
+};
+
+// @note Sparse counterpart of AnimationClip. Tracks are sorted by joint and then by channel
+struct ReducedClip
+{
+    float                       frameRate  = 30.0f;
+    uint32_t                    jointCount = 0;     // Root included
+    uint32_t                    frameCount = 0;
+    std::vector<AnimationTrack> tracks;
+
+    size_t KeyCount() const;
+};
+
+namespace KeyframeReducer
+{
+    struct Tolerance
+    {
+        float position = 0.001f;     // Scene units (centimeters in Maya)
+        float rotation = 0.0002f;    // Radians, angle between the sampled and the interpolated rotation
+        float scale    = 0.0001f;    // Scale and shear, per component
+    };
+
+    // Rest value of a channel, what the frames of a joint without that track decode to
+    const float* RestValue(TrackChannel channel);
+
+    void Reduce(const AnimationClip& clip, const Tolerance& tolerance, ReducedClip& reduced, unsigned int threadCount = 0);
+
+    // Value of the track at [frame], the frames before the first key and after the last one hold the nearest key
+    void Evaluate(const AnimationTrack& track, float frame, float* out);
+
+    // Back to one transform per joint per frame
+    void Decode(const ReducedClip& reduced, AnimationClip& clip);
+}
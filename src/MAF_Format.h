@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ChunkFile.h"
+
+// @note Chunks of the v2 MAF container (see ChunkFile.h), the reduced clips "Deduplicate Keyframes" exports
+// (KeyframeReducer.h), the segmented ones, the curve ones, the matrix palettes and the clip libraries. Every struct here is written as is.
+//
+//  CLIP  ClipRecord
+//  TRCK  TrackRecord per track, sorted by joint and then by channel. A joint channel without a track holds its rest
+//        value on every frame (position 0, rotation identity, scale 1, shear 0)
+//  KTIM  Key frames of every track, one after the other. uint16 when every frame fits, uint32 otherwise (elementStride says which)
+//  KVAL  float key values, components per key, sliced by TrackRecord::firstValue
+//
+// The compressed clips (AnimationCompressor.h) swap TRCK and KVAL for
+//
+//  QTRK  QuantizedTrackRecord per track, same order as TRCK
+//  RNGE  float min xyz and extent xyz of every position, scale and shear track, sliced by QuantizedTrackRecord::firstRange
+//  QDAT  Packed keys of every track, each one starting on a byte, sliced by QuantizedTrackRecord::dataOffset
+//
+// The segmented clips keep every frame, split in blocks of a fixed amount of frames a runtime can load and drop one by one
+//
+//  CLIP  ClipRecord, trackCount counts the STRK records
+//  STRK  SegmentedTrackRecord per joint channel that isn't at its rest value, sorted by joint and then by channel
+//  CONS  float values of the constant tracks, sliced by SegmentedTrackRecord::offset
+//  SEGS  SegmentRecord per segment, in frame order. Written before the data, so it's read with the header
+//  SDAT  The segment blocks, each one ALIGNMENT aligned. Track major, every animated track has its frameCount * components
+//        floats one after the other. A block ends with the first frame of the next segment, so interpolating between any
+//        two frames only needs one block
+//
+// The curve clips ("Export Animation Curves") keep the keys the animators authored for the joints keyed straight by
+// animCurve nodes (AnimationCurves.h), the rest of the joints get sampled and go in TRCK/KTIM/KVAL like a reduced clip.
+// A joint is in one or the other, never both
+//
+//  CJNT  CurveJointRecord per curve joint, sorted by joint
+//  CCHN  CurveChannelRecord per keyed channel, sliced by CurveJointRecord::firstChannel
+//  CKEY  CurveKey per key (AnimationCurves.h), sliced by CurveChannelRecord::firstKey
+//
+// The matrix palettes ("Bake Matrix Palette") have the skinning matrices of every joint on every frame instead of the
+// local transforms (MatrixPalette.h), ready to go to the GPU as they are
+//
+//  CLIP  ClipRecord, trackCount is 0
+//  PALT  [frameCount][jointCount] 3x4 row major matrices, float or half (elementStride is the bytes of a matrix, 48 or 24).
+//        Clip joint order, the root is slot 0 and influence i is slot i + 1: the joint IDs of the MOF vertices (already
+//        influence + 1) index it as they are, 0 based influence indices need jointID + 1
+//
+// A clip library holds the clips of one timeline (ClipTable.h), each one a whole MAF file of its own, v1 or v2 in any
+// of the modes above. A clip exported to a file of its own is a library with a single clip, so it keeps its name,
+// timeline range and loop flag. Libraries have no CLIP chunk
+//
+//  LCLP  LibraryClipRecord per clip, in the order of the clip table
+//  NAME  The clip names one after the other, without null terminators
+//  LDAT  The clip files, each one ALIGNMENT aligned (their chunks are too, the offsets inside are from their start)
+//
+namespace MAF_Format
+{
+    constexpr char     MAGIC[4] = { 'M', 'A', 'F', '\0' };
+    constexpr uint16_t VERSION  = 2;
+
+    constexpr uint32_t CHUNK_CLIP       = ChunkFile::MakeID('C', 'L', 'I', 'P');
+    constexpr uint32_t CHUNK_TRACKS     = ChunkFile::MakeID('T', 'R', 'C', 'K');
+    constexpr uint32_t CHUNK_KEY_FRAMES = ChunkFile::MakeID('K', 'T', 'I', 'M');
+    constexpr uint32_t CHUNK_KEY_VALUES = ChunkFile::MakeID('K', 'V', 'A', 'L');
+
+    constexpr uint32_t CHUNK_QUANTIZED_TRACKS = ChunkFile::MakeID('Q', 'T', 'R', 'K');
+    constexpr uint32_t CHUNK_RANGES           = ChunkFile::MakeID('R', 'N', 'G', 'E');
+    constexpr uint32_t CHUNK_QUANTIZED_DATA   = ChunkFile::MakeID('Q', 'D', 'A', 'T');
+
+    constexpr uint32_t CHUNK_SEGMENTED_TRACKS = ChunkFile::MakeID('S', 'T', 'R', 'K');
+    constexpr uint32_t CHUNK_CONSTANTS        = ChunkFile::MakeID('C', 'O', 'N', 'S');
+    constexpr uint32_t CHUNK_SEGMENTS         = ChunkFile::MakeID('S', 'E', 'G', 'S');
+    constexpr uint32_t CHUNK_SEGMENT_DATA     = ChunkFile::MakeID('S', 'D', 'A', 'T');
+
+    constexpr uint32_t CHUNK_CURVE_JOINTS     = ChunkFile::MakeID('C', 'J', 'N', 'T');
+    constexpr uint32_t CHUNK_CURVE_CHANNELS   = ChunkFile::MakeID('C', 'C', 'H', 'N');
+    constexpr uint32_t CHUNK_CURVE_KEYS       = ChunkFile::MakeID('C', 'K', 'E', 'Y');
+
+    constexpr uint32_t CHUNK_PALETTE          = ChunkFile::MakeID('P', 'A', 'L', 'T');
+
+    constexpr uint32_t CHUNK_LIBRARY_CLIPS    = ChunkFile::MakeID('L', 'C', 'L', 'P');
+    constexpr uint32_t CHUNK_NAMES            = ChunkFile::MakeID('N', 'A', 'M', 'E');
+    constexpr uint32_t CHUNK_LIBRARY_DATA     = ChunkFile::MakeID('L', 'D', 'A', 'T');
+
+    constexpr uint32_t CLIP_LOOP              = 1u << 0;     // LibraryClipRecord::flags
+
+    struct ClipRecord
+    {
+        uint32_t jointCount;        // Root included
+        uint32_t frameCount;
+        float    frameRate;
+        uint32_t trackCount;
+    };
+
+    // @note Joints keep the clip order, the root is 0
+    struct TrackRecord
+    {
+        uint16_t joint;
+        uint8_t  channel;           // TrackChannel, 0 position, 1 rotation, 2 scale, 3 shear
+        uint8_t  components;        // 4 for rotations, 3 otherwise
+        uint32_t keyCount;
+        uint32_t firstKey;          // Elements into KTIM
+        uint32_t firstValue;        // Floats into KVAL
+    };
+
+    // @note Every key takes the same amount of bits, 2 + 3 * bits for rotations (smallest three) and 3 * bits otherwise.
+    // 0 bits means every key is the range min, 32 raw floats
+    struct QuantizedTrackRecord
+    {
+        uint16_t joint;
+        uint8_t  channel;
+        uint8_t  bits;              // Per component
+        uint32_t keyCount;
+        uint32_t firstKey;          // Elements into KTIM
+        uint32_t firstRange;        // Floats into RNGE, not used by rotations
+        uint32_t dataOffset;        // Bytes into QDAT
+    };
+
+    struct SegmentedTrackRecord
+    {
+        uint16_t joint;
+        uint8_t  channel;
+        uint8_t  constant;          // 1 if the value never changes, it's in CONS and not in the segments
+        uint32_t offset;            // Constant: floats into CONS. Animated: components of the animated tracks before it,
+                                    // its floats start at offset * frameCount into every block
+    };
+
+    struct SegmentRecord
+    {
+        uint32_t firstFrame;
+        uint32_t frameCount;        // Frames in the block, the first one of the next segment included (but in the last one)
+        uint64_t offset;            // Bytes into SDAT
+        uint64_t size;
+    };
+
+    // @note The channels without a record hold values[attribute] the whole clip
+    struct CurveJointRecord
+    {
+        uint16_t joint;
+        uint8_t  rotateOrder;       // Like MEulerRotation::RotationOrder
+        uint8_t  channelCount;
+        uint32_t firstChannel;      // Records into CCHN
+        float    rotateAxis [4];    // Quaternions xyzw
+        float    jointOrient[4];
+        float    values[12];        // CurveAttribute order
+    };
+
+    struct CurveChannelRecord
+    {
+        uint8_t  attribute;         // CurveAttribute
+        uint8_t  reserved[3];
+        uint32_t keyCount;
+        uint32_t firstKey;          // Keys into CKEY
+    };
+
+    struct LibraryClipRecord
+    {
+        uint32_t nameOffset;        // Bytes into NAME
+        uint32_t nameLength;
+        int32_t  startFrame;        // Timeline frames it was cut from, inclusive
+        int32_t  endFrame;
+        uint32_t flags;             // CLIP_LOOP
+        uint32_t reserved;
+        uint64_t offset;            // Bytes into LDAT
+        uint64_t size;
+    };
+
+    static_assert(sizeof(ClipRecord)           == 16, "The MAF records are part of the file format");
+    static_assert(sizeof(TrackRecord)          == 16, "The MAF records are part of the file format");
+    static_assert(sizeof(QuantizedTrackRecord) == 20, "The MAF records are part of the file format");
+    static_assert(sizeof(SegmentedTrackRecord) == 8,  "The MAF records are part of the file format");
+    static_assert(sizeof(SegmentRecord)        == 24, "The MAF records are part of the file format");
+    static_assert(sizeof(CurveJointRecord)     == 88, "The MAF records are part of the file format");
+    static_assert(sizeof(CurveChannelRecord)   == 12, "The MAF records are part of the file format");
+    static_assert(sizeof(LibraryClipRecord)    == 40, "The MAF records are part of the file format");
+}
@@ -4,9 +4,46 @@
 // @note I just had a realization. To export the joint transformation for each keyframe, I'm gonna traverse the timeline manually
 // So I'll go from frame 0 to frame n and gather the transform information for each joint
 //
-MStatus MAF_Generator::ExportAnimation(std::string& path, std::string& format, bool deduplicate)
+namespace
 {
-	std::chrono::time_point<std::chrono::high_resolution_clock> start = std::chrono::high_resolution_clock::now();
+	// What WriteAnimation made of one clip, after its name and range
+	void AppendClipInfo(const ClipWriteReport& report, const AnimationExportSettings& settings, MString& info)
+	{
+		switch (report.encoding)
+		{
+			case ClipEncoding::Palette:
+				info += " ( "; info += (int)report.matrices; info += settings.halfMatrices ? " half" : " float"; info += " skinning matrices )";
+				break;
+
+			case ClipEncoding::Curves:
+				info += " ( "; info += (int)report.authoredKeys; info += " authored keys in [ "; info += (int)report.curveJoints; info += " ] joints, ";
+				info += (int)report.keys; info += " sampled keys in [ "; info += (int)report.tracks; info += " ] tracks )";
+				break;
+
+			case ClipEncoding::Reduced:
+				info += " ( "; info += (int)report.keys; info += " keys in [ "; info += (int)report.tracks; info += " ] tracks )";
+				break;
+
+			case ClipEncoding::Compressed:
+				info += " ( "; info += (int)report.keys; info += " keys in [ "; info += (int)report.tracks; info += " ] tracks, ";
+				info += (int)report.quantizedBytes; info += " bytes quantized, max error "; info += report.maxError; info += " cm )";
+				break;
+
+			case ClipEncoding::Segmented:
+				info += " ( segments of [ "; info += (int)settings.segmentFrames; info += " ] frames )";
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+
+MStatus MAF_Generator::ExportAnimation(std::string& path, std::string& format, const AnimationExportSettings& settings)
+{
+	ExportReport        exportReport;
+	ExportReport::Scope reportScope(exportReport);
 
 	MStatus			   status = MStatus::kSuccess;
 	MDagPath		   selectionDagPath;
@@ -14,6 +51,10 @@ MStatus MAF_Generator::ExportAnimation(std::string& path, std::string& format, b
 	std::vector<Joint> finalJoints;
 	MSelectionList	   selectionList;
 
+	exportReport.SetInfo("exporter", "MAF");
+	exportReport.SetInfo("file",     path);
+	exportReport.SetInfo("format",   format);
+
 	MGlobal::getActiveSelectionList(selectionList);
 
 	if (selectionList.length() != 1) { return Status("Select just on object", MStatus::kFailure); }
@@ -22,142 +63,105 @@ MStatus MAF_Generator::ExportAnimation(std::string& path, std::string& format, b
 	if (status != MStatus::kSuccess) { return status; }
 
 	iter.getDagPath(selectionDagPath);
-	status = MAF_Helper::GetAnimationData(selectionDagPath, root, finalJoints, AnimationGatheringInformation::BOTH);
-	status = WriteFile(path, format, root, finalJoints);
+	exportReport.SetInfo("mesh", selectionDagPath.partialPathName().asUTF8());
 
-	std::chrono::time_point<std::chrono::high_resolution_clock> end = std::chrono::high_resolution_clock::now();
+	// @note One pass over the timeline samples the root and every joint, for every clip of the table at once (the union
+	// of their sample times). MAF_Writer just serializes the clips cut out of it
+	// @note At the export sample rate, not the scene one. The times in between frames get evaluated as they are instead of
+	// leaving the resampling to the runtime
+	const double        sceneRate  = GetFrameRate();
+	const double        sampleRate = settings.sampleRate > 0.0f ? (double)settings.sampleRate : sceneRate;
+	std::vector<double> times      = settings.clips.empty() ? ClipTable::SampleTimes(MAF_Helper::PlaybackRange(), sceneRate, sampleRate)
+	                                                        : ClipTable::UnionTimes(settings.clips, sceneRate, sampleRate);
 
-	float duration = std::chrono::duration<float, std::chrono::seconds::period>(end - start).count();
+	const bool binary = !format.compare("Binary");
 
-	int frames = finalJoints[0].transformPerFrame.size() - 1;
-	MString info = "Time that took to export a [ "; info += frames; info += " ] frames animation: "; info += duration; info += " seconds";
-	MGlobal::displayInfo(info);
+	AnimationClip sampled;
+	sampled.frameRate = (float)sampleRate;
 
-	return status;
-}
+	// @note With "Export Animation Curves" the joints keyed straight by animCurve nodes keep the keys they were authored
+	// with and only the rest get sampled. Ascii files sample everything
+	std::vector<CurveJoint> curves;
 
+	if (settings.animationCurves && binary && !settings.matrixPalette)
+	{
+		status = MAF_Helper::GetAnimationData(selectionDagPath, root, finalJoints, AnimationGatheringInformation::JOINT_HIERARCHY);
+		if (finalJoints.empty()) { return Status("The selected mesh has no skin cluster influences", MStatus::kFailure); }
 
-MStatus MAF_Generator::WriteFile(std::string& path, std::string& format, Root& rootObj, std::vector<Joint>& finalJoints)
-{
-	std::ofstream   file;
-	MFnIkJoint     root(rootObj.rootObj);	
-	MTime          endFrame;
-	Print(root.childCount());
-	endFrame = MAnimControl::animationEndTime();
+		MAF_Helper::GetCurveJoints(root, finalJoints, curves);
+
+		std::vector<bool> skip(finalJoints.size() + 1, false);
+		for (const CurveJoint& joint : curves) { skip[joint.joint] = true; }
 
-	int   jointCount = finalJoints.size() + 1;						 
-	int   frameCount = finalJoints[0].transformPerFrame.size(); 
-	float frameRate  = GetFrameRate();
+		status = MAF_Helper::GetJointTransformationsOvertTheTimeline(root, finalJoints, times, sampled, &skip);
 
+		exportReport.SetCount("curve_joints", curves.size());
+		exportReport.SetCount("curve_keys",   AnimationCurves::KeyCount(curves));
+	}
+	else
+	{
+		status = MAF_Helper::GetAnimationData(selectionDagPath, root, finalJoints, AnimationGatheringInformation::BOTH, &sampled, &times);
+		if (finalJoints.empty()) { return Status("The selected mesh has no skin cluster influences", MStatus::kFailure); }
+	}
 
+	exportReport.SetCount("joints",  sampled.jointCount);
+	exportReport.SetCount("frames",  sampled.frameCount);
+	exportReport.SetCount("samples", (uint64_t)(sampled.jointCount - curves.size()) * sampled.frameCount);
 
-	if (!format.compare("Binary")) 
+	// Clip order, the root first and every joint under its parent + 1
+	std::vector<int> parents(sampled.jointCount, 0);
+	parents[0] = -1;
+	for (size_t jIdx = 0; jIdx < finalJoints.size(); jIdx++) { parents[jIdx + 1] = finalJoints[jIdx].parentID + 1; }
+
+	// @note The palettes are skinning matrices against the bind pose MOF_Generator writes, the start of the animation
+	std::vector<Affine> inverseBind;
+
+	if (settings.matrixPalette && binary)
 	{
+		Skeleton skeleton;
+		MAF_Helper::BuildSkeleton(root, finalJoints, skeleton);
 
-		file.open(path, std::ios::out | std::ios::binary);
-
-		file.write(reinterpret_cast<char*>(&jointCount), sizeof(int));
-		file.write(reinterpret_cast<char*>(&frameCount), sizeof(int));
-		file.write(reinterpret_cast<char*>(&frameRate),  sizeof(float));
-	
-
-		// ===========================================================================
-		// Serialize
-		//
-		for (unsigned int fI = 0; fI <= endFrame.value(); fI++)
-		{				
-			// The root always first
-			JointTransform rootTransform;
-			MAF_Helper::GetTransformInFrameX(root, rootTransform, fI);
-			SerializeJointFrameTransform(file, rootTransform);
-			 
-			// And then each joint
-			for (unsigned int jI = 0; jI < finalJoints.size(); jI++)
-			{			
-				SerializeJointFrameTransform(file, finalJoints[jI].transformPerFrame[fI]);	 
-			}
- 
-		}
-		// ===========================================================================
-		file.close();
+		std::vector<Transform> bindPose(sampled.jointCount);
+		bindPose[0] = skeleton.rootBindPose;
+		for (size_t jIdx = 0; jIdx < skeleton.joints.size(); jIdx++) { bindPose[jIdx + 1] = skeleton.joints[jIdx].bindPose; }
+
+		MatrixPalette::InverseBind(bindPose, parents, inverseBind);
+	}
+
+	const uint32_t sampledFrames = sampled.frameCount;
+	const uint32_t jointCount    = sampled.jointCount;
+	const float    frameRate     = sampled.frameRate;
+
+	if (!settings.clips.empty()) { exportReport.SetCount("clips", settings.clips.size()); }
+
+	std::vector<ClipWriteReport> clipReports;
+	bool                         written = MAF_Writer::WriteAnimation(sampled, times, sceneRate, sampleRate, parents, settings, binary, path, curves, inverseBind, clipReports);
+
+	MString info;
+
+	if (settings.clips.empty())
+	{
+		info = "Exported a [ "; info += (int)sampledFrames; info += " ] frames animation of [ "; info += (int)jointCount; info += " ] joints at [ "; info += frameRate; info += " ] fps";
+		if (!clipReports.empty()) { AppendClipInfo(clipReports[0], settings, info); }
 	}
 	else
 	{
-		file.open(path, std::ios::out);		 
-
-		file << "Joint Count [ " << jointCount << " ] \n"; 
-		file << "Frame Count [ " << frameCount << " ] \n";
-		file << "Frame Rate  [ " << frameRate  << " ] \n";					
-
-		for (unsigned int cFrame = 0; cFrame <= endFrame.value(); cFrame++)
-		{			
-			file << "Frame " << cFrame << "\n{\n";
-
-			JointTransform transform;
-			MAF_Helper::GetTransformInFrameX(root, transform, cFrame);
-
-			file << "\n\t{\n";
-			file << "\t\tPosition [ " << transform.position.x << ", " << transform.position.y << ", " << transform.position.z << " ]\n";
-			file << "\t\tRotation [ " << transform.rotation.x << ", " << transform.rotation.y << ", " << transform.rotation.z << ", " << transform.rotation.w << " ]\n";			
-			file << "\t\tScale    [ " << transform.scale.x << ", " << transform.scale.y << ", " << transform.scale.z << " ]\n";
-			file << "\t\tShear    [ " << transform.shear.x << ", " << transform.shear.y << ", " << transform.shear.z << " ]\n";
-			file << "\t} \n";
-
-			for (unsigned int jointIdx = 0; jointIdx < finalJoints.size(); jointIdx++)
-			{
-				JointTransform transform = finalJoints[jointIdx].transformPerFrame[cFrame];
-				file << "\n\t{\n";
-				file << "\t\tPosition [ " << transform.position.x << ", " << transform.position.y << ", " << transform.position.z << " ]\n";								
-				file << "\t\tRotation [ " << transform.rotation.x << ", " << transform.rotation.y << ", " << transform.rotation.z << ", " << transform.rotation.w << " ]\n";				
-				file << "\t\tScale    [ " << transform.scale.x << ", " << transform.scale.y << ", " << transform.scale.z << " ]\n";
-				file << "\t\tShear    [ " << transform.shear.x << ", " << transform.shear.y << ", " << transform.shear.z << " ]\n";
-				file << "\t} \n";
-			}
-
-			file << "} \n\n";
-		}		
-
-		file.close();
+		info = "Exported [ "; info += (int)settings.clips.size(); info += " ] clips of [ "; info += (int)jointCount; info += " ] joints from [ "; info += (int)sampledFrames; info += " ] samples at [ "; info += frameRate; info += " ] fps";
+
+		for (const ClipWriteReport& clipReport : clipReports)
+		{
+			info += " | "; info += clipReport.range.name.c_str(); info += " [ "; info += clipReport.range.start; info += " - "; info += clipReport.range.end; info += " ]";
+			AppendClipInfo(clipReport, settings, info);
+		}
 	}
 
+	if (!written) { return Status("Couldn't write the animation file", MStatus::kFailure); }
 
-	return MStatus::kSuccess;
-}
+	info += " in ";
+	info += exportReport.TotalSeconds(); info += " seconds | "; info += (double)exportReport.GetCount("bytes_written"); info += " bytes";
+	MGlobal::displayInfo(info);
 
+	FinishExportReport(exportReport, path, settings.writeReport);
 
-void MAF_Generator::SerializeJointFrameTransform(std::ofstream& file, JointTransform& transform)
-{	
-	float posX = (float)transform.position.x;
-	float posY = (float)transform.position.y;
-	float posZ = (float)transform.position.z;
-	
-	file.write(reinterpret_cast<char*>(&posX), sizeof(float));
-	file.write(reinterpret_cast<char*>(&posY), sizeof(float));
-	file.write(reinterpret_cast<char*>(&posZ), sizeof(float));
-
-	float rotX = (float)transform.rotation.x;
-	float rotY = (float)transform.rotation.y;
-	float rotZ = (float)transform.rotation.z;
-	float rotW = (float)transform.rotation.w;
-	
-	file.write(reinterpret_cast<char*>(&rotX), sizeof(float));
-	file.write(reinterpret_cast<char*>(&rotY), sizeof(float));
-	file.write(reinterpret_cast<char*>(&rotZ), sizeof(float));
-	file.write(reinterpret_cast<char*>(&rotW), sizeof(float));		
-	
-	float scaX = (float)transform.scale.x;
-	float scaY = (float)transform.scale.y;
-	float scaZ = (float)transform.scale.z;		
-	
-	file.write(reinterpret_cast<char*>(&scaX), sizeof(float));		
-	file.write(reinterpret_cast<char*>(&scaY), sizeof(float));		
-	file.write(reinterpret_cast<char*>(&scaZ), sizeof(float));		
-
-	float shrX = (float)transform.shear.x;
-	float shrY = (float)transform.shear.y;
-	float shrZ = (float)transform.shear.z;	
-	
-	file.write(reinterpret_cast<char*>(&shrX), sizeof(float));		
-	file.write(reinterpret_cast<char*>(&shrY), sizeof(float));		
-	file.write(reinterpret_cast<char*>(&shrZ), sizeof(float));
-}
\ No newline at end of file
+	return status;
+}
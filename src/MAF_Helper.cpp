@@ -1,5 +1,8 @@
 #include "MAF_Helper.h"
 
+#include <cmath>
+#include <algorithm>
+
 // 
 // No real point in returning the status. I dont check anything dah
 // @note As with the influence data values written in mof files, the joints
@@ -11,19 +14,22 @@
 // @note Right now I'm assuming that the root is always the parent of the first joint that influences the mesh.
 // This could end up failing, I maybe need to recursively look until I get to a joint without parent? 
 // 
-MStatus MAF_Helper::GetAnimationData(MDagPath dagPath, Root& root, std::vector<Joint>& finalJoints, AnimationGatheringInformation informationToGather)
+MStatus MAF_Helper::GetAnimationData(MDagPath dagPath, Root& root, std::vector<Joint>& finalJoints, AnimationGatheringInformation informationToGather, AnimationClip* clip, const std::vector<double>* times)
 {
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
 	MStatus				 status	     = MStatus::kSuccess;	
 
 	MObject              skinCluster = Skinner::FindSkinCluster(dagPath);
 	MFnSkinCluster       skinClusterFn(skinCluster, &status);
 	MDagPathArray        jointsDags;
-	unsigned int         jointCount  = skinClusterFn.influenceObjects(jointsDags);	
+	unsigned int         jointCount  = mayaCalls(skinClusterFn.influenceObjects(jointsDags));	
 	
 	switch (informationToGather)
 	{
 		case AnimationGatheringInformation::JOINT_HIERARCHY:
 		{
+			ExportReport::ScopedTimer timer("hierarchy");
 			status = GetJoints(root, finalJoints, jointsDags);
 			status = GetJointsParentID(finalJoints);
 			GetJointsChildrenIDs(finalJoints);
@@ -32,16 +38,19 @@ MStatus MAF_Helper::GetAnimationData(MDagPath dagPath, Root& root, std::vector<J
 
 		case AnimationGatheringInformation::JOINT_TRANSFORMATION_OVER_THE_TIMELINE:
 		{			
-			status = GetJointTransformationsOvertTheTimeline(finalJoints);
+			if (clip) { status = GetJointTransformationsOvertTheTimeline(root, finalJoints, times ? *times : ClipTable::SampleTimes(PlaybackRange(), 1.0, 0.0), *clip); }
 		} break;
 
 		case AnimationGatheringInformation::BOTH:
 		{
-			status = GetJoints(root, finalJoints, jointsDags);
-			status = GetJointsParentID(finalJoints);
-			GetJointsChildrenIDs(finalJoints);
-			GetRootChildren(root, finalJoints);
-			status = GetJointTransformationsOvertTheTimeline(finalJoints);
+			{
+				ExportReport::ScopedTimer timer("hierarchy");
+				status = GetJoints(root, finalJoints, jointsDags);
+				status = GetJointsParentID(finalJoints);
+				GetJointsChildrenIDs(finalJoints);
+				GetRootChildren(root, finalJoints);
+			}
+			if (clip) { status = GetJointTransformationsOvertTheTimeline(root, finalJoints, times ? *times : ClipTable::SampleTimes(PlaybackRange(), 1.0, 0.0), *clip); }
 		} break;
 	}
 
@@ -51,6 +60,8 @@ MStatus MAF_Helper::GetAnimationData(MDagPath dagPath, Root& root, std::vector<J
 
 MStatus MAF_Helper::GetJoints(Root& root, std::vector<Joint>& finalJoints, MDagPathArray& jointsDags)
 {	
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
 	MStatus status = MStatus::kSuccess;
 
 	bool once = false;
@@ -63,7 +74,7 @@ MStatus MAF_Helper::GetJoints(Root& root, std::vector<Joint>& finalJoints, MDagP
 		if (!once)
 		{
 			MFnIkJoint	   firstChild(jointsDags[i]);			
-			root.rootObj = firstChild.parent(0);
+			root.rootObj = mayaCalls(firstChild.parent(0));
 			once		 = true;
 		}
 
@@ -75,9 +86,9 @@ MStatus MAF_Helper::GetJoints(Root& root, std::vector<Joint>& finalJoints, MDagP
 		
 		MFnIkJoint mayaJoint(jointsDags[i]);
 
-		for (unsigned int c = 0; c < mayaJoint.childCount(); c++)
+		for (unsigned int c = 0; c < mayaCalls(mayaJoint.childCount()); c++)
 		{
-			joint.AddChild(mayaJoint.child(c));
+			joint.AddChild(mayaCalls(mayaJoint.child(c)));
 		}
 
 		finalJoints.emplace_back(joint);
@@ -89,14 +100,16 @@ MStatus MAF_Helper::GetJoints(Root& root, std::vector<Joint>& finalJoints, MDagP
 
 MStatus MAF_Helper::GetJointsParentID(std::vector<Joint>& finalJoints)
 {
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
 	bool parentFound = false;
 	for (size_t jIdx = 0; jIdx < finalJoints.size(); jIdx++)
 	{
-		MFnIkJoint parentJoint = finalJoints[jIdx].GetThisJoint().parent(0);
+		MFnIkJoint parentJoint = mayaCalls(finalJoints[jIdx].GetThisJoint().parent(0));
 
 		for (size_t pIdx = 0; pIdx < finalJoints.size(); pIdx++)
 		{	
-			if (finalJoints[pIdx].GetThisJoint().name() == parentJoint.name())
+			if (mayaCalls(finalJoints[pIdx].GetThisJoint().name()) == mayaCalls(parentJoint.name()))
 			{
 				finalJoints[jIdx].parentID = pIdx;
 				parentFound = true;
@@ -118,16 +131,18 @@ MStatus MAF_Helper::GetJointsParentID(std::vector<Joint>& finalJoints)
 
 void MAF_Helper::GetJointsChildrenIDs(std::vector<Joint>& finalJoints)
 {
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
 	for (unsigned int jI = 0; jI < finalJoints.size(); jI++)
 	{
 		for (unsigned int cI = 0; cI < finalJoints[jI].childrenObjs.size(); cI++)
 		{
 			MFnIkJoint joint(finalJoints[jI].childrenObjs[cI]);
-			MString childName = joint.name();
+			MString childName = mayaCalls(joint.name());
 
 			for (unsigned int aL = 0; aL < finalJoints.size(); aL++)
 			{
-				if (finalJoints[aL].GetThisJoint().name() == childName)
+				if (mayaCalls(finalJoints[aL].GetThisJoint().name()) == childName)
 				{
 					finalJoints[jI].childrenIDs.emplace_back(aL);
 					break;
@@ -140,17 +155,18 @@ void MAF_Helper::GetJointsChildrenIDs(std::vector<Joint>& finalJoints)
 
 void MAF_Helper::GetRootChildren(Root& root, std::vector<Joint>& finalJoints)
 {
-	
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
 	MFnIkJoint rootJnt(root.rootObj);
 
-	for (unsigned int cI = 0; cI < rootJnt.childCount(); cI++)
+	for (unsigned int cI = 0; cI < mayaCalls(rootJnt.childCount()); cI++)
 	{
-		MFnIkJoint joint(rootJnt.child(cI));
-		MString    childName = joint.name();
+		MFnIkJoint joint(mayaCalls(rootJnt.child(cI)));
+		MString    childName = mayaCalls(joint.name());
 
 		for (unsigned int aL = 0; aL < finalJoints.size(); aL++)
 		{
-			if (finalJoints[aL].GetThisJoint().name() == childName)
+			if (mayaCalls(finalJoints[aL].GetThisJoint().name()) == childName)
 			{
 				root.childrenIDs.emplace_back(aL);
 				break;
@@ -161,27 +177,44 @@ void MAF_Helper::GetRootChildren(Root& root, std::vector<Joint>& finalJoints)
 
 
 // @note I think I have to retrieve the inverse matrix of each parent? << Just to note it down >>
-MStatus MAF_Helper::GetJointTransformationsOvertTheTimeline(std::vector<Joint>& finalJoints)
+// @note The samples go straight into their frame major slot of the clip, the root first and then every joint, so the
+// timeline is walked once and the writers only serialize what's already in the clip.
+// Keeping a vector of JointTransforms per joint and converting it afterwards held the whole animation twice, in doubles
+// @note Every frame is evaluated through an MDGContext on the plugs of the joints only. Setting the current time per
+// frame evaluated the whole scene and refreshed the viewport, which on long clips took most of the export
+// @note Clip frame i is timeline frame times[i], so a whole clip table gets sampled in this one pass. The times can fall
+// in between frames, the plugs get evaluated at exactly those (animation curves interpolated, constraints solved...)
+// @note The joints in skip (the curve ones) aren't evaluated, they stay at their rest value
+MStatus MAF_Helper::GetJointTransformationsOvertTheTimeline(Root& root, std::vector<Joint>& finalJoints, const std::vector<double>& times, AnimationClip& clip, const std::vector<bool>* skip)
 {
+	ExportReport::ScopedTimer timer("sample");
+
 	MStatus status = MStatus::kSuccess;
-	MTime   newTime;
-	MTime   endFrame;
 
-	endFrame = MAnimControl::animationEndTime();
+	clip.jointCount = (uint32_t)finalJoints.size() + 1;
+	clip.frameCount = (uint32_t)times.size();
+	clip.transforms.assign((size_t)clip.frameCount * clip.jointCount, Transform{});
+
+	// Same order as the clip, the root isn't one of the influences but it goes first
+	std::vector<JointPlugs> jointPlugs(clip.jointCount);
+	FindJointPlugs(root.rootObj, jointPlugs[0]);
+	for (size_t jointIdx = 0; jointIdx < finalJoints.size(); jointIdx++)
+	{
+		FindJointPlugs(finalJoints[jointIdx].ownDagPath.node(), jointPlugs[jointIdx + 1]);
+	}
 	
-	for (unsigned int cFrame = 0; cFrame <= endFrame.value(); cFrame++)
+	JointTransform transform{};
+	for (uint32_t cFrame = 0; cFrame < clip.frameCount; cFrame++)
 	{
-		newTime.setValue(cFrame);
-		MAnimControl::setCurrentTime(newTime);
+		MDGContext      context(MTime(times[cFrame], MTime::uiUnit()));
+		MDGContextGuard contextGuard(context);
 	
-		for (size_t jointIdx = 0; jointIdx < finalJoints.size(); jointIdx++)
+		for (uint32_t jointIdx = 0; jointIdx < clip.jointCount; jointIdx++)
 		{
-			MFnIkJoint joint = finalJoints[jointIdx].GetThisJoint();
-
-			JointTransform transform{};
-			status = GetTransform(joint, transform);
+			if (skip && (*skip)[jointIdx]) { continue; }
 
-			finalJoints[jointIdx].transformPerFrame.emplace_back(transform);
+			if (SampleJoint(jointPlugs[jointIdx], transform) != MStatus::kSuccess) { status = MStatus::kFailure; }
+			ToTransform(transform, clip.At(cFrame, jointIdx));
 		}
 	}
 
@@ -189,106 +222,303 @@ MStatus MAF_Helper::GetJointTransformationsOvertTheTimeline(std::vector<Joint>&
 }
 
 
-MStatus MAF_Helper::GetTransform(MFnIkJoint& joint, JointTransform& transform)
+MStatus MAF_Helper::GetCurveJoints(Root& root, std::vector<Joint>& finalJoints, std::vector<CurveJoint>& curves)
 {
-	MStatus status;	
-	
-	transform.position = joint.getTranslation(MSpace::kTransform, &status);
-	if (status == MStatus::kFailure)  
-	{
-		MString message = "GT - Failed to retrieve position information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
-	}
-	
-	status = joint.getRotation(transform.rotation);
-	if (status == MStatus::kFailure)  
-	{
-		MString message = "GT - Failed to retrieve Rotation information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
-	}
-	
-	double scale[3];
-	status = joint.getScale(scale);
-	if (status == MStatus::kFailure) 
+	ExportReport::ScopedTimer timer("curves");
+
+	curves.clear();
+
+	for (size_t jointIdx = 0; jointIdx <= finalJoints.size(); jointIdx++)
 	{
-		MString message = "GT - Failed to retrieve scale information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
+		JointPlugs plugs;
+		MStatus    status = FindJointPlugs(jointIdx == 0 ? root.rootObj : finalJoints[jointIdx - 1].ownDagPath.node(), plugs);
+		if (status != MStatus::kSuccess) { return status; }
+
+		CurveJoint joint;
+		joint.joint = (uint32_t)jointIdx;
+
+		if (GetCurveJoint(plugs, joint)) { curves.emplace_back(std::move(joint)); }
 	}
-	MVector vScale(scale[0], scale[1], scale[2]);
-	transform.scale = vScale;
 
-	double shear[3];
-	status = joint.getShear(shear);
-	if (status == MStatus::kFailure)  
+	return MStatus::kSuccess;
+}
+
+
+ClipRange MAF_Helper::PlaybackRange()
+{
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
+	ClipRange range;
+	range.start = (int32_t)std::lround(mayaCalls(MAnimControl::animationStartTime()).as(MTime::uiUnit()));
+	range.end   = std::max(range.start, (int32_t)std::lround(mayaCalls(MAnimControl::animationEndTime()).as(MTime::uiUnit())));
+
+	return range;
+}
+
+
+namespace
+{
+	void FindChildPlugs(const MPlug& compound, MPlug children[3], ExportReport::ScopedCount& mayaCalls)
 	{
-		MString message = "GT - Failed to retrieve shear information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
+		if (compound.isNull()) { return; }
+
+		for (unsigned int c = 0; c < 3; c++) { children[c] = mayaCalls(compound.child(c)); }
 	}
-	MVector vShear(shear[0], shear[1], shear[2]);
-	transform.shear = vShear;
-	
-	return status;
 }
 
 
-MStatus MAF_Helper::GetTransformInFrameX(MFnIkJoint& joint, JointTransform& transform, int x)
+MStatus MAF_Helper::FindJointPlugs(const MObject& joint, JointPlugs& plugs)
 {
-	MTime nTime;
-	nTime.setValue(x);
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
+	MStatus           status;
+	MFnDependencyNode node(joint, &status);
+	if (status != MStatus::kSuccess) { return status; }
+
+	plugs.translate   = mayaCalls(node.findPlug("translate",   true));
+	plugs.rotate      = mayaCalls(node.findPlug("rotate",      true));
+	plugs.rotateOrder = mayaCalls(node.findPlug("rotateOrder", true));
+	plugs.rotateAxis  = mayaCalls(node.findPlug("rotateAxis",  true));
+	plugs.jointOrient = mayaCalls(node.findPlug("jointOrient", true));   // Null on plain transforms, the root doesn't need to be a joint
+	plugs.scale       = mayaCalls(node.findPlug("scale",       true));
+	plugs.shear       = mayaCalls(node.findPlug("shear",       true));
+
+	FindChildPlugs(plugs.translate,   plugs.translateXYZ,   mayaCalls);
+	FindChildPlugs(plugs.rotate,      plugs.rotateXYZ,      mayaCalls);
+	FindChildPlugs(plugs.rotateAxis,  plugs.rotateAxisXYZ,  mayaCalls);
+	FindChildPlugs(plugs.jointOrient, plugs.jointOrientXYZ, mayaCalls);
+	FindChildPlugs(plugs.scale,       plugs.scaleXYZ,       mayaCalls);
+	FindChildPlugs(plugs.shear,       plugs.shearXYZ,       mayaCalls);
 
-	MAnimControl::setCurrentTime(nTime);
-	MStatus status;
+	return status;
+}
 
-	transform.position = joint.getTranslation(MSpace::kTransform, &status);
-	if (status == MStatus::kFailure) 
+
+namespace
+{
+	// The children of a double3 compound (JointPlugs::translateXYZ...) in internal units: centimeters and radians
+	bool ReadDouble3(const MPlug children[3], double values[3], ExportReport::ScopedCount& mayaCalls)
 	{
-		MString message = "GTX - Failed to retrieve position information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message); 
+		if (children[0].isNull()) { return false; }
+
+		MStatus status;
+		for (unsigned int c = 0; c < 3; c++)
+		{
+			values[c] = mayaCalls(children[c].asDouble(&status));
+			if (status != MStatus::kSuccess) { return false; }
+		}
+		return true;
 	}
+}
 
-	status = joint.getRotation(transform.rotation);
-	if (status == MStatus::kFailure) 
+
+namespace
+{
+	bool Driven(const MPlug& plug, const MPlug children[3], ExportReport::ScopedCount& mayaCalls)
 	{
-		MString message = "GTX - Failed to retrieve Rotation information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
+		if (plug.isNull())                   { return false; }
+		if (mayaCalls(plug.isDestination())) { return true; }
+
+		for (unsigned int c = 0; c < 3; c++)
+		{
+			if (mayaCalls(children[c].isDestination())) { return true; }
+		}
+		return false;
 	}
 
-	
-	double scale[3];
-	status = joint.getScale(scale);
-	if (status == MStatus::kFailure) 
+	// A channel with nothing connected holds its value, one keyed by an animCurveTL/TA/TU (time input, not a driven key)
+	// gets its keys. Only the curves the runtime evaluates the same way count: non weighted and holding the value outside
+	// of the keys. Anything else (constraints, expressions, IK, animation layers, driven keys...) has to be sampled
+	bool ReadCurveChannel(const MPlug& plug, CurveAttribute attribute, CurveJoint& joint, ExportReport::ScopedCount& mayaCalls)
 	{
-		MString message = "GTX - Failed to retrieve scale information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
+		MStatus status;
+
+		if (!mayaCalls(plug.isDestination()))
+		{
+			joint.values[(int)attribute] = (float)mayaCalls(plug.asDouble(&status));
+			return status == MStatus::kSuccess;
+		}
+
+		MObject curveNode = mayaCalls(mayaCalls(plug.source()).node());
+		if (!curveNode.hasFn(MFn::kAnimCurve)) { return false; }
+
+		MFnAnimCurve curve(curveNode, &status);
+		if (status != MStatus::kSuccess) { return false; }
+
+		MFnAnimCurve::AnimCurveType type = mayaCalls(curve.animCurveType());
+		if (type != MFnAnimCurve::kAnimCurveTL && type != MFnAnimCurve::kAnimCurveTA && type != MFnAnimCurve::kAnimCurveTU) { return false; }
+		if (mayaCalls(curve.isWeighted()) || mayaCalls(curve.preInfinityType()) != MFnAnimCurve::kConstant || mayaCalls(curve.postInfinityType()) != MFnAnimCurve::kConstant) { return false; }
+
+		const unsigned int keyCount = mayaCalls(curve.numKeys());
+		if (keyCount == 0) { return false; }
+
+		CurveChannel channel;
+		channel.attribute = attribute;
+		channel.keys.resize(keyCount);
+
+		// Values in internal units (centimeters, radians), the tangents x in seconds
+		for (unsigned int k = 0; k < keyCount; k++)
+		{
+			CurveKey& key = channel.keys[k];
+			key.time  = (float)mayaCalls(curve.time(k)).as(MTime::kSeconds);
+			key.value = (float)mayaCalls(curve.value(k));
+
+			double x = 0.0, y = 0.0;
+			mayaCalls(curve.getTangent(k, x, y, true));
+			key.inSlope  = (x != 0.0) ? (float)(y / x) : 0.0f;
+			mayaCalls(curve.getTangent(k, x, y, false));
+			key.outSlope = (x != 0.0) ? (float)(y / x) : 0.0f;
+
+			switch (mayaCalls(curve.outTangentType(k)))
+			{
+				case MFnAnimCurve::kTangentStep:     key.flags = CurveKey::STEP;      break;
+				case MFnAnimCurve::kTangentStepNext: key.flags = CurveKey::STEP_NEXT; break;
+				default:                                                              break;
+			}
+		}
+
+		joint.channels.emplace_back(std::move(channel));
+		return true;
 	}
-	MVector vScale(scale[0], scale[1], scale[2]);
-	transform.scale = vScale;
+}
 
-	double shear[3];
-	status = joint.getShear(shear);
-	if (status == MStatus::kFailure) 
+
+// @note rotateOrder, rotateAxis and jointOrient can't be driven, the curve joints get them once
+bool MAF_Helper::GetCurveJoint(const JointPlugs& plugs, CurveJoint& joint)
+{
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
+	if (plugs.translate.isNull() || plugs.rotate.isNull() || plugs.scale.isNull() || plugs.shear.isNull()) { return false; }
+	if (mayaCalls(plugs.translate.isDestination()) || mayaCalls(plugs.rotate.isDestination()) || mayaCalls(plugs.scale.isDestination()) || mayaCalls(plugs.shear.isDestination())) { return false; }
+	if ((!plugs.rotateOrder.isNull() && mayaCalls(plugs.rotateOrder.isDestination())) || Driven(plugs.rotateAxis, plugs.rotateAxisXYZ, mayaCalls) || Driven(plugs.jointOrient, plugs.jointOrientXYZ, mayaCalls)) { return false; }
+
+	// Same order as CurveAttribute
+	const MPlug* channels[] = { plugs.translateXYZ, plugs.rotateXYZ, plugs.scaleXYZ, plugs.shearXYZ };
+
+	for (int a = 0; a < (int)CurveAttribute::Count; a++)
 	{
-		MString message = "GTX - Failed to retrieve shear information. [ ";
-		message += joint.name();
-		message += " ]";
-		Print(message);
+		if (!ReadCurveChannel(channels[a / 3][a % 3], (CurveAttribute)a, joint, mayaCalls)) { return false; }
 	}
-	MVector vShear(shear[0], shear[1], shear[2]);
-	transform.shear = vShear;
 
-	return status;
+	double rotateAxis [3] = { 0.0, 0.0, 0.0 };
+	double jointOrient[3] = { 0.0, 0.0, 0.0 };
+	MStatus status;
+
+	if (!ReadDouble3(plugs.rotateAxisXYZ, rotateAxis, mayaCalls))                                      { return false; }
+	if (!plugs.jointOrient.isNull() && !ReadDouble3(plugs.jointOrientXYZ, jointOrient, mayaCalls))     { return false; }
+
+	joint.rotateOrder = plugs.rotateOrder.isNull() ? 0 : mayaCalls(plugs.rotateOrder.asShort(&status));
+	if (status != MStatus::kSuccess) { return false; }
+
+	MQuaternion rotateAxisQuaternion  = MEulerRotation(rotateAxis[0],  rotateAxis[1],  rotateAxis[2]).asQuaternion();
+	MQuaternion jointOrientQuaternion = MEulerRotation(jointOrient[0], jointOrient[1], jointOrient[2]).asQuaternion();
+
+	joint.rotateAxis [0] = (float)rotateAxisQuaternion.x;  joint.rotateAxis [1] = (float)rotateAxisQuaternion.y;  joint.rotateAxis [2] = (float)rotateAxisQuaternion.z;  joint.rotateAxis [3] = (float)rotateAxisQuaternion.w;
+	joint.jointOrient[0] = (float)jointOrientQuaternion.x; joint.jointOrient[1] = (float)jointOrientQuaternion.y; joint.jointOrient[2] = (float)jointOrientQuaternion.z; joint.jointOrient[3] = (float)jointOrientQuaternion.w;
+
+	return true;
+}
+
+
+// @note Failures get counted in the active ExportReport instead of printed, once per joint and frame they flood the script editor
+MStatus MAF_Helper::SampleJoint(const JointPlugs& plugs, JointTransform& transform)
+{
+	double translate  [3] = { 0.0, 0.0, 0.0 };
+	double rotate     [3] = { 0.0, 0.0, 0.0 };
+	double rotateAxis [3] = { 0.0, 0.0, 0.0 };
+	double jointOrient[3] = { 0.0, 0.0, 0.0 };
+	double scale      [3] = { 1.0, 1.0, 1.0 };
+	double shear      [3] = { 0.0, 0.0, 0.0 };
+	int    failures       = 0;
+
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
+	failures += !ReadDouble3(plugs.translateXYZ,  translate,  mayaCalls);
+	failures += !ReadDouble3(plugs.rotateXYZ,     rotate,     mayaCalls);
+	failures += !ReadDouble3(plugs.rotateAxisXYZ, rotateAxis, mayaCalls);
+	failures += !ReadDouble3(plugs.scaleXYZ,      scale,      mayaCalls);
+	failures += !ReadDouble3(plugs.shearXYZ,      shear,      mayaCalls);
+	if (!plugs.jointOrient.isNull()) { failures += !ReadDouble3(plugs.jointOrientXYZ, jointOrient, mayaCalls); }
+
+	// rotateOrder goes xyz, yzx, zxy, xzy, yxz, zyx, the same order as MEulerRotation::RotationOrder
+	MStatus status;
+	short   rotateOrder = plugs.rotateOrder.isNull() ? 0 : mayaCalls(plugs.rotateOrder.asShort(&status));
+	if (status != MStatus::kSuccess) { failures++; }
+
+	MQuaternion rotateAxisQuaternion  = MEulerRotation(rotateAxis[0],  rotateAxis[1],  rotateAxis[2]).asQuaternion();
+	MQuaternion rotateQuaternion      = MEulerRotation(rotate[0],      rotate[1],      rotate[2], (MEulerRotation::RotationOrder)rotateOrder).asQuaternion();
+	MQuaternion jointOrientQuaternion = MEulerRotation(jointOrient[0], jointOrient[1], jointOrient[2]).asQuaternion();
+
+	// Maya multiplies row vectors, so the rotation applied first goes on the left
+	transform.position = MVector(translate[0], translate[1], translate[2]);
+	transform.rotation = rotateAxisQuaternion * rotateQuaternion * jointOrientQuaternion;
+	transform.scale    = MVector(scale[0], scale[1], scale[2]);
+	transform.shear    = MVector(shear[0], shear[1], shear[2]);
+
+	if (failures > 0) { ExportReport::AddToActive("transform_read_failures", failures); return MStatus::kFailure; }
+	return MStatus::kSuccess;
+}
+
+
+MStatus MAF_Helper::GetTransform(MFnIkJoint& joint, JointTransform& transform)
+{
+	JointPlugs plugs;
+	MStatus    status = FindJointPlugs(joint.object(), plugs);
+	if (status != MStatus::kSuccess) { ExportReport::AddToActive("transform_read_failures", 1); return status; }
+
+	return SampleJoint(plugs, transform);
+}
+
+
+MStatus MAF_Helper::GetTransformInFrameX(MFnIkJoint& joint, JointTransform& transform, int x)
+{
+	MDGContext      context(MTime((double)x, MTime::uiUnit()));
+	MDGContextGuard contextGuard(context);
+
+	return GetTransform(joint, transform);
+}
+
+
+void MAF_Helper::ToTransform(const JointTransform& jointTransform, Transform& transform)
+{
+	transform.position[0] = (float)jointTransform.position.x; transform.position[1] = (float)jointTransform.position.y; transform.position[2] = (float)jointTransform.position.z;
+	transform.rotation[0] = (float)jointTransform.rotation.x; transform.rotation[1] = (float)jointTransform.rotation.y; transform.rotation[2] = (float)jointTransform.rotation.z; transform.rotation[3] = (float)jointTransform.rotation.w;
+	transform.scale   [0] = (float)jointTransform.scale.x;    transform.scale   [1] = (float)jointTransform.scale.y;    transform.scale   [2] = (float)jointTransform.scale.z;
+	transform.shear   [0] = (float)jointTransform.shear.x;    transform.shear   [1] = (float)jointTransform.shear.y;    transform.shear   [2] = (float)jointTransform.shear.z;
+}
+
+
+// @important 
+// @note The first frame of animation is the one that will be placed as the default A/T pose. Export the MOF file with an A pose 
+// as a base mesh if the model is animated
+//
+void MAF_Helper::BuildSkeleton(Root& root, std::vector<Joint>& finalJoints, Skeleton& skeleton)
+{
+	ExportReport::ScopedTimer timer("bind_pose");
+	ExportReport::ScopedCount mayaCalls("maya_calls");
+
+	MDGContext      context(mayaCalls(MAnimControl::animationStartTime()));
+	MDGContextGuard contextGuard(context);
+
+	JointTransform transform{};
+	MFnIkJoint     rootJnt(root.rootObj);
+
+	skeleton.rootName     = mayaCalls(rootJnt.name()).asUTF8();
+	skeleton.rootChildren = root.childrenIDs;
+	GetTransform(rootJnt, transform);
+	ToTransform(transform, skeleton.rootBindPose);
+
+	skeleton.joints.resize(finalJoints.size());
+	for (size_t jIdx = 0; jIdx < finalJoints.size(); jIdx++)
+	{
+		SkeletonJoint& joint = skeleton.joints[jIdx];
+		joint.name        = finalJoints[jIdx].name.asUTF8();
+		joint.parentID    = finalJoints[jIdx].parentID;
+		joint.influenceID = finalJoints[jIdx].influenceID;
+		joint.childrenIDs = finalJoints[jIdx].childrenIDs;
+
+		MFnIkJoint mayaJoint = finalJoints[jIdx].GetThisJoint();
+		GetTransform(mayaJoint, transform);
+		ToTransform(transform, joint.bindPose);
+	}
 }
@@ -8,19 +8,70 @@
 #include <maya/MDagPath.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MAnimControl.h>
+#include <maya/MPlug.h>
+#include <maya/MDGContext.h>
+#include <maya/MDGContextGuard.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnAnimCurve.h>
 
 
 #include "Skinner.h"
 #include "Types.h"
+#include "Skeleton.h"
+#include "ExportReport.h"
+#include "ClipTable.h"
+#include "AnimationCurves.h"
 
 namespace MAF_Helper
 {
-	MStatus GetAnimationData(MDagPath dagPath, Root& rootObj, std::vector<Joint>& finalJoints, AnimationGatheringInformation informationToGather);
+	// @note The plugs the local transform of a joint is built from. They're found once per joint and then evaluated
+	// under an MDGContext for every frame, so sampling never moves the current time (no scene evaluation or viewport
+	// refresh per frame). The x, y and z children of the compounds get resolved once too, a frame only reads values
+	struct JointPlugs
+	{
+		MPlug translate;
+		MPlug rotate;
+		MPlug rotateOrder;
+		MPlug rotateAxis;
+		MPlug jointOrient;
+		MPlug scale;
+		MPlug shear;
+
+		// Null when their compound is
+		MPlug translateXYZ  [3];
+		MPlug rotateXYZ     [3];
+		MPlug rotateAxisXYZ [3];
+		MPlug jointOrientXYZ[3];
+		MPlug scaleXYZ      [3];
+		MPlug shearXYZ      [3];
+	};
+
+	MStatus FindJointPlugs(const MObject& joint, JointPlugs& plugs);
+
+	// Has to run inside an MDGContextGuard of the time to sample. The rotation is the whole local one:
+	// rotateAxis, then rotate (in its rotate order), then jointOrient
+	MStatus SampleJoint(const JointPlugs& plugs, JointTransform& transform);
+
+	// @note clip is only needed when gathering the transformations over the timeline, they go straight into it.
+	// times are the timeline frames to sample, ascending and fractional ones too (ClipTable::UnionTimes). Null samples
+	// every frame of PlaybackRange
+	MStatus GetAnimationData(MDagPath dagPath, Root& rootObj, std::vector<Joint>& finalJoints, AnimationGatheringInformation informationToGather, AnimationClip* clip = nullptr, const std::vector<double>* times = nullptr);
 	MStatus GetJoints(Root& rootObj, std::vector<Joint>& finalJoints, MDagPathArray& jointDags);
 	MStatus GetJointsParentID(std::vector<Joint>& finalJoints);
 	void    GetJointsChildrenIDs(std::vector<Joint>& finalJoints);
 	void	GetRootChildren(Root& root, std::vector<Joint>& finalJoints);
-	MStatus GetJointTransformationsOvertTheTimeline(std::vector<Joint>& finalJoints);
-	MStatus GetTransform(MFnIkJoint& joint, JointTransform& transform);
+	MStatus GetJointTransformationsOvertTheTimeline(Root& root, std::vector<Joint>& finalJoints, const std::vector<double>& times, AnimationClip& clip, const std::vector<bool>* skip = nullptr);
+
+	// @note The joints (clip order, the root first) whose whole transform comes straight from animCurve nodes or never
+	// changes, with their authored keys. Key times are seconds of the timeline. Everything else has to be sampled
+	MStatus GetCurveJoints(Root& root, std::vector<Joint>& finalJoints, std::vector<CurveJoint>& curves);
+	bool    GetCurveJoint(const JointPlugs& plugs, CurveJoint& joint);
+	ClipRange PlaybackRange();                                                             // animationStartTime to animationEndTime
+	MStatus GetTransform(MFnIkJoint& joint, JointTransform& transform);                   // At the current time
 	MStatus GetTransformInFrameX(MFnIkJoint& joint, JointTransform& transform, int x);
+
+	// @note Conversions to the Maya independent data the MOF/MAF writers consume
+	void    ToTransform(const JointTransform& jointTransform, Transform& transform);
+	void    BuildSkeleton(Root& root, std::vector<Joint>& finalJoints, Skeleton& skeleton);
 }
\ No newline at end of file
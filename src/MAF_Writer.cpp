@@ -0,0 +1,750 @@
+#include "MAF_Writer.h"
+
+#include <fstream>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+
+#include "MAF_Format.h"
+#include "ChunkWriter.h"
+#include "ExportReport.h"
+
+
+namespace
+{
+    const float* ChannelOf(const Transform& transform, TrackChannel channel)
+    {
+        switch (channel)
+        {
+            case TrackChannel::Position: return transform.position;
+            case TrackChannel::Rotation: return transform.rotation;
+            case TrackChannel::Scale:    return transform.scale;
+            default:                     return transform.shear;
+        }
+    }
+
+    // CLIP, TRCK, KTIM and KVAL of a reduced clip
+    void AddReducedChunks(ChunkWriter& container, const ReducedClip& clip)
+    {
+        MAF_Format::ClipRecord clipRecord{};
+        clipRecord.jointCount = clip.jointCount;
+        clipRecord.frameCount = clip.frameCount;
+        clipRecord.frameRate  = clip.frameRate;
+        clipRecord.trackCount = (uint32_t)clip.tracks.size();
+
+        container.AddChunk(MAF_Format::CHUNK_CLIP).Write(clipRecord);
+
+        // Tracks
+        const size_t keyCount    = clip.KeyCount();
+        const bool   shortFrames = clip.frameCount <= 65536;
+        size_t       valueCount  = 0;
+
+        for (const AnimationTrack& track : clip.tracks) { valueCount += track.values.size(); }
+
+        BinaryWriter& trackChunk = container.AddChunk(MAF_Format::CHUNK_TRACKS,     sizeof(MAF_Format::TrackRecord), clip.tracks.size() * sizeof(MAF_Format::TrackRecord));
+        BinaryWriter& frameChunk = container.AddChunk(MAF_Format::CHUNK_KEY_FRAMES, shortFrames ? sizeof(uint16_t) : sizeof(uint32_t), keyCount * (shortFrames ? sizeof(uint16_t) : sizeof(uint32_t)));
+        BinaryWriter& valueChunk = container.AddChunk(MAF_Format::CHUNK_KEY_VALUES, sizeof(float), valueCount * sizeof(float));
+
+        uint32_t firstKey   = 0;
+        uint32_t firstValue = 0;
+
+        for (const AnimationTrack& track : clip.tracks)
+        {
+            MAF_Format::TrackRecord record{};
+            record.joint      = (uint16_t)track.joint;
+            record.channel    = (uint8_t)track.channel;
+            record.components = track.components;
+            record.keyCount   = (uint32_t)track.frames.size();
+            record.firstKey   = firstKey;
+            record.firstValue = firstValue;
+
+            trackChunk.Write(record);
+
+            if (shortFrames) { for (uint32_t frame : track.frames) { frameChunk.Write((uint16_t)frame); } }
+            else             { frameChunk.WriteArray(track.frames.data(), track.frames.size()); }
+
+            valueChunk.WriteArray(track.values.data(), track.values.size());
+
+            firstKey   += record.keyCount;
+            firstValue += (uint32_t)track.values.size();
+        }
+    }
+
+    // CLIP, QTRK, KTIM, RNGE and QDAT of a compressed clip
+    void AddCompressedChunks(ChunkWriter& container, const CompressedClip& clip)
+    {
+        MAF_Format::ClipRecord clipRecord{};
+        clipRecord.jointCount = clip.jointCount;
+        clipRecord.frameCount = clip.frameCount;
+        clipRecord.frameRate  = clip.frameRate;
+        clipRecord.trackCount = (uint32_t)clip.tracks.size();
+
+        container.AddChunk(MAF_Format::CHUNK_CLIP).Write(clipRecord);
+
+        const size_t keyCount    = clip.KeyCount();
+        const bool   shortFrames = clip.frameCount <= 65536;
+
+        BinaryWriter& trackChunk = container.AddChunk(MAF_Format::CHUNK_QUANTIZED_TRACKS, sizeof(MAF_Format::QuantizedTrackRecord), clip.tracks.size() * sizeof(MAF_Format::QuantizedTrackRecord));
+        BinaryWriter& frameChunk = container.AddChunk(MAF_Format::CHUNK_KEY_FRAMES,       shortFrames ? sizeof(uint16_t) : sizeof(uint32_t), keyCount * (shortFrames ? sizeof(uint16_t) : sizeof(uint32_t)));
+        BinaryWriter& rangeChunk = container.AddChunk(MAF_Format::CHUNK_RANGES,           sizeof(float));
+        BinaryWriter& dataChunk  = container.AddChunk(MAF_Format::CHUNK_QUANTIZED_DATA,   0, clip.DataBytes());
+
+        uint32_t firstKey = 0;
+
+        for (const QuantizedTrack& track : clip.tracks)
+        {
+            MAF_Format::QuantizedTrackRecord record{};
+            record.joint      = (uint16_t)track.joint;
+            record.channel    = (uint8_t)track.channel;
+            record.bits       = track.bits;
+            record.keyCount   = (uint32_t)track.frames.size();
+            record.firstKey   = firstKey;
+            record.firstRange = (uint32_t)(rangeChunk.Size() / sizeof(float));
+            record.dataOffset = (uint32_t)dataChunk.Size();
+
+            trackChunk.Write(record);
+
+            if (shortFrames) { for (uint32_t frame : track.frames) { frameChunk.Write((uint16_t)frame); } }
+            else             { frameChunk.WriteArray(track.frames.data(), track.frames.size()); }
+
+            if (track.channel != TrackChannel::Rotation)
+            {
+                rangeChunk.WriteArray(track.rangeMin,    3);
+                rangeChunk.WriteArray(track.rangeExtent, 3);
+            }
+
+            dataChunk.WriteBytes(track.data.data(), track.data.size());
+
+            firstKey += record.keyCount;
+        }
+    }
+
+    // The reduced chunks of the sampled joints plus CJNT, CCHN and CKEY
+    void AddCurveChunks(ChunkWriter& container, const ReducedClip& clip, const std::vector<CurveJoint>& curves)
+    {
+        AddReducedChunks(container, clip);
+
+        size_t channelCount = 0;
+        for (const CurveJoint& joint : curves) { channelCount += joint.channels.size(); }
+
+        BinaryWriter& jointChunk   = container.AddChunk(MAF_Format::CHUNK_CURVE_JOINTS,   sizeof(MAF_Format::CurveJointRecord),   curves.size() * sizeof(MAF_Format::CurveJointRecord));
+        BinaryWriter& channelChunk = container.AddChunk(MAF_Format::CHUNK_CURVE_CHANNELS, sizeof(MAF_Format::CurveChannelRecord), channelCount  * sizeof(MAF_Format::CurveChannelRecord));
+        BinaryWriter& keyChunk     = container.AddChunk(MAF_Format::CHUNK_CURVE_KEYS,     sizeof(CurveKey),                       AnimationCurves::KeyCount(curves) * sizeof(CurveKey));
+
+        uint32_t firstChannel = 0;
+        uint32_t firstKey     = 0;
+
+        for (const CurveJoint& joint : curves)
+        {
+            MAF_Format::CurveJointRecord record{};
+            record.joint        = (uint16_t)joint.joint;
+            record.rotateOrder  = (uint8_t)joint.rotateOrder;
+            record.channelCount = (uint8_t)joint.channels.size();
+            record.firstChannel = firstChannel;
+            std::copy_n(joint.rotateAxis,  4, record.rotateAxis);
+            std::copy_n(joint.jointOrient, 4, record.jointOrient);
+            std::copy_n(joint.values, (int)CurveAttribute::Count, record.values);
+
+            jointChunk.Write(record);
+
+            for (const CurveChannel& channel : joint.channels)
+            {
+                MAF_Format::CurveChannelRecord channelRecord{};
+                channelRecord.attribute = (uint8_t)channel.attribute;
+                channelRecord.keyCount  = (uint32_t)channel.keys.size();
+                channelRecord.firstKey  = firstKey;
+
+                channelChunk.Write(channelRecord);
+                keyChunk.WriteArray(channel.keys.data(), channel.keys.size());
+
+                firstKey += channelRecord.keyCount;
+            }
+
+            firstChannel += record.channelCount;
+        }
+    }
+
+    // CLIP and PALT
+    void AddPaletteChunks(ChunkWriter& container, const PaletteClip& clip, bool half)
+    {
+        MAF_Format::ClipRecord clipRecord{};
+        clipRecord.jointCount = clip.jointCount;
+        clipRecord.frameCount = clip.frameCount;
+        clipRecord.frameRate  = clip.frameRate;
+        clipRecord.trackCount = 0;
+
+        container.AddChunk(MAF_Format::CHUNK_CLIP).Write(clipRecord);
+
+        const size_t  valueSize    = half ? sizeof(uint16_t) : sizeof(float);
+        BinaryWriter& paletteChunk = container.AddChunk(MAF_Format::CHUNK_PALETTE, MatrixPalette::MATRIX_FLOATS * valueSize, clip.matrices.size() * valueSize);
+
+        if (half)
+        {
+            std::vector<uint16_t> halves(clip.matrices.size());
+            std::transform(clip.matrices.begin(), clip.matrices.end(), halves.begin(), MatrixPalette::ToHalf);
+
+            paletteChunk.WriteArray(halves.data(), halves.size());
+        }
+        else
+        {
+            paletteChunk.WriteArray(clip.matrices.data(), clip.matrices.size());
+        }
+    }
+
+    // CLIP, STRK, CONS, SEGS and SDAT
+    void AddSegmentedChunks(ChunkWriter& container, const AnimationClip& clip, uint32_t segmentFrames)
+    {
+        segmentFrames = std::max(segmentFrames, 1u);
+
+        // Tracks
+        struct AnimatedTrack
+        {
+            uint32_t     joint;
+            TrackChannel channel;
+            int          components;
+        };
+
+        std::vector<MAF_Format::SegmentedTrackRecord> trackRecords;
+        std::vector<AnimatedTrack>                    animated;
+        std::vector<float>                            constants;
+        uint32_t                                      animatedComponents = 0;
+
+        for (uint32_t joint = 0; joint < clip.jointCount && clip.frameCount > 0; joint++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                const TrackChannel channel    = (TrackChannel)c;
+                const int          components = (channel == TrackChannel::Rotation) ? 4 : 3;
+                const float*       first      = ChannelOf(clip.At(0, joint), channel);
+
+                bool constant = true;
+                for (uint32_t frame = 1; frame < clip.frameCount && constant; frame++)
+                {
+                    constant = std::memcmp(ChannelOf(clip.At(frame, joint), channel), first, components * sizeof(float)) == 0;
+                }
+
+                if (constant && std::memcmp(first, KeyframeReducer::RestValue(channel), components * sizeof(float)) == 0) { continue; }
+
+                MAF_Format::SegmentedTrackRecord record{};
+                record.joint    = (uint16_t)joint;
+                record.channel  = (uint8_t)channel;
+                record.constant = constant ? 1 : 0;
+
+                if (constant)
+                {
+                    record.offset = (uint32_t)constants.size();
+                    constants.insert(constants.end(), first, first + components);
+                }
+                else
+                {
+                    record.offset = animatedComponents;
+                    animatedComponents += components;
+                    animated.push_back({ joint, channel, components });
+                }
+
+                trackRecords.emplace_back(record);
+            }
+        }
+
+        // Segments, every block repeats the first frame of the next one
+        const uint32_t segmentCount = (clip.frameCount + segmentFrames - 1) / segmentFrames;
+
+        std::vector<MAF_Format::SegmentRecord> segments(segmentCount);
+        size_t                                 dataBytes = 0;
+
+        for (uint32_t s = 0; s < segmentCount; s++)
+        {
+            segments[s].firstFrame = s * segmentFrames;
+            segments[s].frameCount = std::min(segmentFrames + 1, clip.frameCount - segments[s].firstFrame);
+            segments[s].offset     = (uint64_t)dataBytes;
+            segments[s].size       = (uint64_t)segments[s].frameCount * animatedComponents * sizeof(float);
+
+            dataBytes = ChunkFile::AlignUp(dataBytes + (size_t)segments[s].size, ChunkFile::ALIGNMENT);
+        }
+
+        MAF_Format::ClipRecord clipRecord{};
+        clipRecord.jointCount = clip.jointCount;
+        clipRecord.frameCount = clip.frameCount;
+        clipRecord.frameRate  = clip.frameRate;
+        clipRecord.trackCount = (uint32_t)trackRecords.size();
+
+        container.AddChunk(MAF_Format::CHUNK_CLIP).Write(clipRecord);
+        container.AddChunk(MAF_Format::CHUNK_SEGMENTED_TRACKS, sizeof(MAF_Format::SegmentedTrackRecord)).WriteArray(trackRecords.data(), trackRecords.size());
+        container.AddChunk(MAF_Format::CHUNK_CONSTANTS,        sizeof(float)).WriteArray(constants.data(), constants.size());
+        container.AddChunk(MAF_Format::CHUNK_SEGMENTS,         sizeof(MAF_Format::SegmentRecord)).WriteArray(segments.data(), segments.size());
+
+        BinaryWriter& dataChunk = container.AddChunk(MAF_Format::CHUNK_SEGMENT_DATA, 0, dataBytes);
+
+        for (const MAF_Format::SegmentRecord& segment : segments)
+        {
+            dataChunk.Allocate((size_t)segment.offset - dataChunk.Size());     // Zeroed padding
+
+            float* block = reinterpret_cast<float*>(dataChunk.Allocate((size_t)segment.size));
+
+            for (const AnimatedTrack& track : animated)
+            {
+                for (uint32_t frame = 0; frame < segment.frameCount; frame++, block += track.components)
+                {
+                    std::memcpy(block, ChannelOf(clip.At(segment.firstFrame + frame, track.joint), track.channel), track.components * sizeof(float));
+                }
+            }
+        }
+
+        ExportReport::SetOnActive("segments", segmentCount);
+    }
+
+    // @note One clip in the mode of the settings (see WriteAnimation). The binary ones go into [file] when there's one (the
+    // data chunk of a clip library) and to [path] otherwise. [clip] is emptied once it's been converted, it isn't needed anymore.
+    // [curves] are the curve joints already cut to the clip
+    bool WriteClip(AnimationClip& clip, const std::vector<int>& parents, const AnimationExportSettings& settings, bool binary, const std::string& path, BinaryWriter* file,
+                   const std::vector<CurveJoint>& curves, const std::vector<Affine>& inverseBind, ClipWriteReport& report, unsigned int threadCount)
+    {
+        const KeyframeReducer::Tolerance tolerance = settings.deduplicate ? settings.keyTolerance : KeyframeReducer::Tolerance{ 0.0f, 0.0f, 0.0f };
+
+        report.frameCount = clip.frameCount;
+
+        if (!inverseBind.empty() && binary)
+        {
+            PaletteClip palette;
+            MatrixPalette::Bake(clip, parents, inverseBind, palette, threadCount);
+            clip = AnimationClip{};
+
+            report.encoding = ClipEncoding::Palette;
+            report.matrices = palette.matrices.size() / MatrixPalette::MATRIX_FLOATS;
+
+            if (file) { MAF_Writer::WritePalette(*file, palette, settings.halfMatrices); return true; }
+            return MAF_Writer::WritePalette(path, palette, settings.halfMatrices);
+        }
+
+        if (!curves.empty() && binary)
+        {
+            // @note The sampled joints get reduced like "Deduplicate Keyframes" does (losslessly when it's off), the curve
+            // joints are at their rest value in [clip] so they get no tracks. No quantization or segments for these
+            ReducedClip reduced;
+            KeyframeReducer::Reduce(clip, tolerance, reduced, threadCount);
+            clip = AnimationClip{};
+
+            report.encoding     = ClipEncoding::Curves;
+            report.curveJoints  = curves.size();
+            report.authoredKeys = AnimationCurves::KeyCount(curves);
+            report.keys         = reduced.KeyCount();
+            report.tracks       = reduced.tracks.size();
+
+            if (file) { MAF_Writer::WriteCurves(*file, reduced, curves); return true; }
+            return MAF_Writer::WriteCurves(path, reduced, curves);
+        }
+
+        if (settings.deduplicate || settings.compress)
+        {
+            // @note Sparse MAF v2, one track per animated joint channel. Compressing without the reduction only drops the
+            // keys interpolation gives back exactly
+            ReducedClip reduced;
+            KeyframeReducer::Reduce(clip, tolerance, reduced, threadCount);
+            clip = AnimationClip{};
+
+            report.encoding = ClipEncoding::Reduced;
+            report.keys     = reduced.KeyCount();
+            report.tracks   = reduced.tracks.size();
+
+            if (settings.compress)
+            {
+                CompressedClip compressed;
+                AnimationCompressor::Compress(reduced, parents, settings.compression, compressed, threadCount);
+
+                report.encoding       = ClipEncoding::Compressed;
+                report.quantizedBytes = compressed.DataBytes();
+                report.maxError       = compressed.maxError;
+
+                // Ascii gets the values the quantized keys decode to
+                if (!binary) { AnimationCompressor::Decode(compressed, reduced); return MAF_Writer::WriteReducedAscii(path, reduced); }
+                if (file)    { MAF_Writer::WriteCompressed(*file, compressed); return true; }
+                return MAF_Writer::WriteCompressed(path, compressed);
+            }
+
+            if (!binary) { return MAF_Writer::WriteReducedAscii(path, reduced); }
+            if (file)    { MAF_Writer::WriteReduced(*file, reduced); return true; }
+            return MAF_Writer::WriteReduced(path, reduced);
+        }
+
+        if (settings.segmentFrames > 0 && binary)
+        {
+            report.encoding = ClipEncoding::Segmented;
+
+            if (file) { MAF_Writer::WriteSegmented(*file, clip, settings.segmentFrames); return true; }
+            return MAF_Writer::WriteSegmented(path, clip, settings.segmentFrames);
+        }
+
+        if (!binary) { return MAF_Writer::WriteAscii(path, clip); }
+        if (file)    { MAF_Writer::WriteBinary(*file, clip); return true; }
+        return MAF_Writer::WriteBinary(path, clip);
+    }
+
+    // The curves from the first to the last timeline frame in [times], seconds from the first one like the clip frames
+    void CutCurves(const std::vector<CurveJoint>& curves, const std::vector<double>& times, double sceneRate, std::vector<CurveJoint>& cut)
+    {
+        if (curves.empty() || times.empty()) { cut.clear(); return; }
+
+        AnimationCurves::Cut(curves, (float)(times.front() / sceneRate), (float)(times.back() / sceneRate), cut);
+    }
+
+    // @note A clip library (MAF_Format.h) being written. The clips go one after the other straight into its data chunk
+    // with the BinaryWriter overloads, BeginClip aligns the next one and EndClip records it
+    struct Library
+    {
+        ChunkWriter   container;
+        BinaryWriter& clipChunk;
+        BinaryWriter& nameChunk;
+        BinaryWriter& dataChunk;
+
+        // [dataBytes] what the clips are expected to take, the data chunk grows past it if they need more
+        Library(size_t clipCount, size_t dataBytes)
+            : container(MAF_Format::MAGIC, MAF_Format::VERSION),
+              clipChunk(container.AddChunk(MAF_Format::CHUNK_LIBRARY_CLIPS, sizeof(MAF_Format::LibraryClipRecord), clipCount * sizeof(MAF_Format::LibraryClipRecord))),
+              nameChunk(container.AddChunk(MAF_Format::CHUNK_NAMES,         1)),
+              dataChunk(container.AddChunk(MAF_Format::CHUNK_LIBRARY_DATA,  0, dataBytes))
+        {
+        }
+
+        Library(const Library&)            = delete;     // The chunk references point into the container
+        Library& operator=(const Library&) = delete;
+
+        // Where the clip starts in the data chunk
+        size_t BeginClip()
+        {
+            dataChunk.Allocate(ChunkFile::AlignUp(dataChunk.Size(), ChunkFile::ALIGNMENT) - dataChunk.Size());     // Zeroed padding
+            return dataChunk.Size();
+        }
+
+        // The clip written to the data chunk since BeginClip returned [offset]
+        void EndClip(const ClipRange& range, size_t offset)
+        {
+            MAF_Format::LibraryClipRecord record{};
+            record.nameOffset = (uint32_t)nameChunk.Size();
+            record.nameLength = (uint32_t)range.name.size();
+            record.startFrame = range.start;
+            record.endFrame   = range.end;
+            record.flags      = range.loop ? MAF_Format::CLIP_LOOP : 0;
+            record.offset     = (uint64_t)offset;
+            record.size       = (uint64_t)(dataChunk.Size() - offset);
+
+            clipChunk.Write(record);
+            nameChunk.WriteBytes(range.name.data(), range.name.size());
+        }
+
+        bool SaveToFile(const std::string& path) const
+        {
+            ExportReport::ScopedTimer timer("write");
+            return container.SaveToFile(path);
+        }
+    };
+
+    // @note What a binary clip of [range] takes in a library when WriteClip stores every frame of it (palette,
+    // segmented or plain), a bit more for the segments and the container, so the data chunk gets sized once instead of
+    // moving every time it grows. The reduced and curve clips are a fraction of the frames and get 0, the chunk grows
+    // with them
+    size_t ClipBytesHint(const ClipRange& range, uint32_t jointCount, double sceneRate, double sampleRate, const AnimationExportSettings& settings,
+                         bool palette, bool curves)
+    {
+        constexpr size_t CONTAINER_BYTES = 1024;     // Header, directory, records and chunk padding
+
+        if (!palette && (curves || settings.deduplicate || settings.compress)) { return 0; }
+
+        size_t frames = ClipTable::SampleTimes(range, sceneRate, sampleRate).size();
+        if (palette) { return CONTAINER_BYTES + frames * jointCount * MatrixPalette::MATRIX_FLOATS * (settings.halfMatrices ? sizeof(uint16_t) : sizeof(float)); }
+
+        if (settings.segmentFrames > 0) { frames += frames / settings.segmentFrames + 1; }     // Every segment repeats the first frame of the next one
+
+        return CONTAINER_BYTES + frames * jointCount * MAF_Writer::TRANSFORM_FLOATS * sizeof(float);
+    }
+}
+
+
+bool MAF_Writer::WriteBinary(const std::string& path, const AnimationClip& clip)
+{
+    BinaryWriter file;
+    WriteBinary(file, clip);
+
+    return file.SaveToFile(path);
+}
+
+
+void MAF_Writer::WriteBinary(BinaryWriter& writer, const AnimationClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    // @note Header + one transform per joint per frame, the root included
+    writer.Reserve(writer.Size() + 2 * sizeof(int) + sizeof(float) + clip.transforms.size() * TRANSFORM_FLOATS * sizeof(float));
+
+    writer.Write((int)clip.jointCount);
+    writer.Write((int)clip.frameCount);
+    writer.Write(clip.frameRate);
+
+    // Already frame major with the root first
+    for (const Transform& transform : clip.transforms) { SerializeTransform(writer, transform); }
+}
+
+
+bool MAF_Writer::WriteAscii(const std::string& path, const AnimationClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    std::ofstream file(path, std::ios::out);
+    if (!file.is_open()) { return false; }
+
+    file << "Joint Count [ " << clip.jointCount << " ] \n"; 
+    file << "Frame Count [ " << clip.frameCount << " ] \n";
+    file << "Frame Rate  [ " << clip.frameRate  << " ] \n";
+
+    for (uint32_t cFrame = 0; cFrame < clip.frameCount; cFrame++)
+    {
+        file << "Frame " << cFrame << "\n{\n";
+
+        for (uint32_t jointIdx = 0; jointIdx < clip.jointCount; jointIdx++)
+        {
+            const Transform& transform = clip.At(cFrame, jointIdx);
+            file << "\n\t{\n";
+            file << "\t\tPosition [ " << transform.position[0] << ", " << transform.position[1] << ", " << transform.position[2] << " ]\n";
+            file << "\t\tRotation [ " << transform.rotation[0] << ", " << transform.rotation[1] << ", " << transform.rotation[2] << ", " << transform.rotation[3] << " ]\n";
+            file << "\t\tScale    [ " << transform.scale[0]    << ", " << transform.scale[1]    << ", " << transform.scale[2]    << " ]\n";
+            file << "\t\tShear    [ " << transform.shear[0]    << ", " << transform.shear[1]    << ", " << transform.shear[2]    << " ]\n";
+            file << "\t} \n";
+        }
+
+        file << "} \n\n";
+    }
+
+    if (!file.good()) { return false; }
+
+    ExportReport::AddToActive("bytes_written", (uint64_t)file.tellp());
+    return true;
+}
+
+
+// @note MAF v2, see MAF_Format.h for the chunks
+bool MAF_Writer::WriteReduced(const std::string& path, const ReducedClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddReducedChunks(container, clip);
+
+    return container.SaveToFile(path);
+}
+
+
+void MAF_Writer::WriteReduced(BinaryWriter& file, const ReducedClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddReducedChunks(container, clip);
+
+    container.WriteTo(file);
+}
+
+
+// @note Same container as WriteReduced with the quantized tracks (QTRK, RNGE, QDAT) instead of the float ones
+bool MAF_Writer::WriteCompressed(const std::string& path, const CompressedClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddCompressedChunks(container, clip);
+
+    return container.SaveToFile(path);
+}
+
+
+void MAF_Writer::WriteCompressed(BinaryWriter& file, const CompressedClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddCompressedChunks(container, clip);
+
+    container.WriteTo(file);
+}
+
+
+// @note Same container as WriteReduced, the sampled joints in the float tracks, plus the curve joints (CJNT, CCHN, CKEY)
+bool MAF_Writer::WriteCurves(const std::string& path, const ReducedClip& clip, const std::vector<CurveJoint>& curves)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddCurveChunks(container, clip, curves);
+
+    return container.SaveToFile(path);
+}
+
+
+void MAF_Writer::WriteCurves(BinaryWriter& file, const ReducedClip& clip, const std::vector<CurveJoint>& curves)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddCurveChunks(container, clip, curves);
+
+    container.WriteTo(file);
+}
+
+
+// @note MAF v2 matrix palette, see MAF_Format.h
+bool MAF_Writer::WritePalette(const std::string& path, const PaletteClip& clip, bool half)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddPaletteChunks(container, clip, half);
+
+    return container.SaveToFile(path);
+}
+
+
+void MAF_Writer::WritePalette(BinaryWriter& file, const PaletteClip& clip, bool half)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddPaletteChunks(container, clip, half);
+
+    container.WriteTo(file);
+}
+
+
+// @note MAF v2 segmented, see MAF_Format.h. Lossless, the channels that never change go once in CONS (or not at all
+// when they're at their rest value) and the rest get every frame
+bool MAF_Writer::WriteSegmented(const std::string& path, const AnimationClip& clip, uint32_t segmentFrames)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddSegmentedChunks(container, clip, segmentFrames);
+
+    return container.SaveToFile(path);
+}
+
+
+void MAF_Writer::WriteSegmented(BinaryWriter& file, const AnimationClip& clip, uint32_t segmentFrames)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    ChunkWriter container(MAF_Format::MAGIC, MAF_Format::VERSION);
+    AddSegmentedChunks(container, clip, segmentFrames);
+
+    container.WriteTo(file);
+}
+
+
+bool MAF_Writer::WriteReducedAscii(const std::string& path, const ReducedClip& clip)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    static const char* CHANNEL_NAMES[] = { "Position", "Rotation", "Scale", "Shear" };
+
+    std::ofstream file(path, std::ios::out);
+    if (!file.is_open()) { return false; }
+
+    file << "Joint Count [ " << clip.jointCount    << " ] \n";
+    file << "Frame Count [ " << clip.frameCount    << " ] \n";
+    file << "Frame Rate  [ " << clip.frameRate     << " ] \n";
+    file << "Track Count [ " << clip.tracks.size() << " ] \n";
+
+    for (const AnimationTrack& track : clip.tracks)
+    {
+        file << "Joint " << track.joint << " " << CHANNEL_NAMES[(int)track.channel] << " [ " << track.frames.size() << " keys ]\n{\n";
+
+        for (size_t key = 0; key < track.frames.size(); key++)
+        {
+            const float* value = &track.values[key * track.components];
+
+            file << "\t" << track.frames[key] << " [ ";
+            for (int c = 0; c < track.components; c++) { file << value[c] << (c + 1 < track.components ? ", " : " ]\n"); }
+        }
+
+        file << "} \n\n";
+    }
+
+    if (!file.good()) { return false; }
+
+    ExportReport::AddToActive("bytes_written", (uint64_t)file.tellp());
+    return true;
+}
+
+
+bool MAF_Writer::WriteAnimation(AnimationClip& sampled, const std::vector<double>& times, double sceneRate, double sampleRate, const std::vector<int>& parents,
+                                const AnimationExportSettings& settings, bool binary, const std::string& path, const std::vector<CurveJoint>& curves,
+                                const std::vector<Affine>& inverseBind, std::vector<ClipWriteReport>& reports, unsigned int threadCount)
+{
+    std::vector<CurveJoint> clipCurves;
+
+    if (settings.clips.empty())
+    {
+        reports.assign(1, ClipWriteReport{});
+
+        CutCurves(curves, times, sceneRate, clipCurves);
+        return WriteClip(sampled, parents, settings, binary, path, nullptr, clipCurves, inverseBind, reports[0], threadCount);
+    }
+
+    reports.assign(settings.clips.size(), ClipWriteReport{});
+
+    // @note Binary clips get written straight into one library file (or a single clip one each), Ascii ones always get
+    // a file each
+    const bool palette = !inverseBind.empty();
+
+    std::unique_ptr<Library> library;
+    if (binary && !settings.clipFiles)
+    {
+        size_t dataBytes = 0;
+        for (const ClipRange& range : settings.clips)
+        {
+            dataBytes = ChunkFile::AlignUp(dataBytes + ClipBytesHint(range, sampled.jointCount, sceneRate, sampleRate, settings, palette, !curves.empty()), ChunkFile::ALIGNMENT);
+        }
+
+        library = std::make_unique<Library>(settings.clips.size(), dataBytes);
+    }
+
+    bool written = true;
+    for (size_t c = 0; c < settings.clips.size() && written; c++)
+    {
+        const ClipRange&  range    = settings.clips[c];
+        const std::string clipPath = ClipTable::ClipPath(path, range.name);
+
+        AnimationClip clip;
+        ClipTable::Extract(sampled, times, range, sceneRate, sampleRate, clip);
+
+        reports[c].range = range;
+
+        std::unique_ptr<Library> single;
+        if (binary && settings.clipFiles) { single = std::make_unique<Library>(1, ClipBytesHint(range, sampled.jointCount, sceneRate, sampleRate, settings, palette, !curves.empty())); }
+
+        Library*     target = single ? single.get() : library.get();
+        const size_t offset = target ? target->BeginClip() : 0;
+
+        CutCurves(curves, ClipTable::SampleTimes(range, sceneRate, sampleRate), sceneRate, clipCurves);
+        written = WriteClip(clip, parents, settings, binary, clipPath, target ? &target->dataChunk : nullptr, clipCurves, inverseBind, reports[c], threadCount);
+
+        if (written && target) { target->EndClip(range, offset); }
+        if (written && single) { written = single->SaveToFile(clipPath); }
+    }
+
+    sampled = AnimationClip{};
+
+    if (written && library) { written = library->SaveToFile(path); }
+
+    return written;
+}
+
+
+void MAF_Writer::SerializeTransform(BinaryWriter& writer, const Transform& transform)
+{
+    float frameTransform[TRANSFORM_FLOATS] =
+    {
+        transform.position[0], transform.position[1], transform.position[2],
+        transform.rotation[0], transform.rotation[1], transform.rotation[2], transform.rotation[3],
+        transform.scale[0],    transform.scale[1],    transform.scale[2],
+        transform.shear[0],    transform.shear[1],    transform.shear[2],
+    };
+
+    writer.WriteArray(frameTransform, TRANSFORM_FLOATS);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+
+#include "Skeleton.h"
+#include "BinaryWriter.h"
+#include "KeyframeReducer.h"
+#include "AnimationCompressor.h"
+#include "ClipTable.h"
+#include "AnimationCurves.h"
+#include "MatrixPalette.h"
+#include "ExportSettings.h"
+
+// @note Serializes an animation clip, no Maya in here.
+//
+//  int      jointCount    Root included
+//  int      frameCount
+//  float    frameRate
+//  float    transforms    [frameCount][jointCount][13] position xyz, rotation xyzw, scale xyz, shear xyz
+//
+// Reduced clips go in a v2 container instead, one track per animated joint channel (MAF_Format.h), with float or
+// quantized keys, or with the authored curves of the keyed joints, or baked to skinning matrices. The BinaryWriter overloads build the same files in memory, to put them in a clip library
+//
+// @note What WriteAnimation made of every clip, the exporters turn it into their messages (like MeshProcessReport)
+enum class ClipEncoding : uint8_t { Frames, Segmented, Reduced, Compressed, Curves, Palette };
+
+struct ClipWriteReport
+{
+    ClipRange    range;                     // The clip of the table, empty name for the whole timeline
+    ClipEncoding encoding       = ClipEncoding::Frames;
+    uint32_t     frameCount     = 0;
+    size_t       matrices       = 0;        // Palette
+    size_t       curveJoints    = 0;        // Curves, the joints with authored keys
+    size_t       authoredKeys   = 0;
+    size_t       keys           = 0;        // Reduced, compressed and curves (the sampled joints)
+    size_t       tracks         = 0;
+    size_t       quantizedBytes = 0;        // Compressed
+    float        maxError       = 0.0f;
+};
+
+namespace MAF_Writer
+{
+    constexpr size_t TRANSFORM_FLOATS = 13;
+
+    bool WriteBinary(const std::string& path, const AnimationClip& clip);
+    void WriteBinary(BinaryWriter& file,      const AnimationClip& clip);
+    bool WriteAscii (const std::string& path, const AnimationClip& clip);
+
+    bool WriteReduced     (const std::string& path, const ReducedClip& clip);
+    void WriteReduced     (BinaryWriter& file,      const ReducedClip& clip);
+    bool WriteReducedAscii(const std::string& path, const ReducedClip& clip);
+    bool WriteCompressed  (const std::string& path, const CompressedClip& clip);
+    void WriteCompressed  (BinaryWriter& file,      const CompressedClip& clip);
+
+    // [clip] the sampled joints, the curve ones have no tracks in it
+    bool WriteCurves      (const std::string& path, const ReducedClip& clip, const std::vector<CurveJoint>& curves);
+    void WriteCurves      (BinaryWriter& file,      const ReducedClip& clip, const std::vector<CurveJoint>& curves);
+
+    // [half] stores the matrices as IEEE half floats, half the size
+    bool WritePalette     (const std::string& path, const PaletteClip& clip, bool half);
+    void WritePalette     (BinaryWriter& file,      const PaletteClip& clip, bool half);
+
+    // Every frame, in blocks of [segmentFrames] (MAF_Format.h), instead of one frame after the other
+    bool WriteSegmented   (const std::string& path, const AnimationClip& clip, uint32_t segmentFrames);
+    void WriteSegmented   (BinaryWriter& file,      const AnimationClip& clip, uint32_t segmentFrames);
+
+    // @note Every clip of settings.clips cut out of [sampled] (a frame per [times] entry, see ClipTable::Extract), or
+    // [sampled] as it is without a clip table. Binary clips go into one library at [path] (a file each with clipFiles),
+    // Ascii ones always get a file each. Every clip goes in the first mode that applies: a matrix palette with
+    // [inverseBind] matrices, the authored keys of [curves], reduced or compressed, segmented, every frame.
+    // [parents] in clip order (Skeleton::ClipParents). [sampled] gets emptied, it isn't needed afterwards
+    bool WriteAnimation(AnimationClip& sampled, const std::vector<double>& times, double sceneRate, double sampleRate, const std::vector<int>& parents,
+                        const AnimationExportSettings& settings, bool binary, const std::string& path, const std::vector<CurveJoint>& curves,
+                        const std::vector<Affine>& inverseBind, std::vector<ClipWriteReport>& reports, unsigned int threadCount = 0);
+
+    void SerializeTransform(BinaryWriter& writer, const Transform& transform);
+}
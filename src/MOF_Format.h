@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ChunkFile.h"
+
+// @note Chunks of the v2 MOF container (see ChunkFile.h). Every struct here is written as is.
+//
+//  VFMT  VertexFormatRecord followed by streamCount VertexFormat::Stream
+//  BNDS  VertexQuantizer::QuantizationBounds, computed for every layout (the float one doesn't need them to decode)
+//  VERT  vertexCount * stride bytes, interleaved as VFMT describes
+//  INDX  uint16 indices when every vertex fits, uint32 otherwise (elementStride says which)
+//  SKEL  JointRecord per joint, the root first. Only for skinned meshes, like the rest of the skeleton chunks
+//  CHLD  int32 children IDs, sliced by JointRecord::firstChild/childCount
+//  NAME  null terminated UTF-8 joint names, sliced by JointRecord::nameOffset/nameLength
+//
+namespace MOF_Format
+{
+    constexpr char     MAGIC[4] = { 'M', 'O', 'F', '\0' };
+    constexpr uint16_t VERSION  = 2;
+
+    constexpr uint32_t CHUNK_VERTEX_FORMAT = ChunkFile::MakeID('V', 'F', 'M', 'T');
+    constexpr uint32_t CHUNK_BOUNDS        = ChunkFile::MakeID('B', 'N', 'D', 'S');
+    constexpr uint32_t CHUNK_VERTICES      = ChunkFile::MakeID('V', 'E', 'R', 'T');
+    constexpr uint32_t CHUNK_INDICES       = ChunkFile::MakeID('I', 'N', 'D', 'X');
+    constexpr uint32_t CHUNK_SKELETON      = ChunkFile::MakeID('S', 'K', 'E', 'L');
+    constexpr uint32_t CHUNK_CHILDREN      = ChunkFile::MakeID('C', 'H', 'L', 'D');
+    constexpr uint32_t CHUNK_NAMES         = ChunkFile::MakeID('N', 'A', 'M', 'E');
+
+    struct VertexFormatRecord
+    {
+        int32_t  layout;            // 0 float, 1 compact
+        int32_t  stride;            // Bytes
+        uint32_t attributeMask;     // VertexFormat::Attribute bits
+        int32_t  influences;        // Per vertex, 0 for static meshes
+        int32_t  uvSetCount;
+        int32_t  streamCount;
+    };
+
+    // @note IDs keep the legacy convention, the root is 0 and every joint is its influence ID + 1
+    struct JointRecord
+    {
+        int32_t  id;
+        int32_t  parentID;
+        uint32_t nameOffset;        // Bytes into NAME
+        uint32_t nameLength;        // Without the null terminator
+        uint32_t firstChild;        // Elements into CHLD
+        uint32_t childCount;
+        float    position[3];
+        float    rotation[4];       // Quaternion xyzw
+        float    scale   [3];
+        float    shear   [3];
+    };
+
+    static_assert(sizeof(VertexFormatRecord) == 24, "The MOF records are part of the file format");
+    static_assert(sizeof(JointRecord)        == 76, "The MOF records are part of the file format");
+}
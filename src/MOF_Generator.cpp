@@ -1,19 +1,19 @@
 #include "MOF_Generator.h"
 
 // @note add the possibility of exporting multiple meshes affected by the same skeleton
-MStatus MOF_Generator::ExportMesh(std::string& path, std::string& format, bool deduplicate)
+MStatus MOF_Generator::ExportMesh(std::string& path, std::string& format, const MeshExportSettings& settings)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    ExportReport        exportReport;
+    ExportReport::Scope reportScope(exportReport);
 
     MStatus                         status;
     Type                            meshType = Type::Static;
     MDagPath                        selection_DagPath;
     MSelectionList                  selectionList;
-    std::vector<Vertex>             finalVertices;
-    std::vector<int>                indices;
-    std::unordered_map<Vertex, int> hashedVertices;
-    int                             counter            = 0;
-    int                             duplicatedVertices = 0;
+
+    exportReport.SetInfo("exporter", "MOF");
+    exportReport.SetInfo("file",     path);
+    exportReport.SetInfo("format",   (!format.compare("Binary") && settings.chunkedFile) ? "Binary v2" : format);
 
     // ==========================================================================================================
     // Extract Mesh from selection
@@ -29,499 +29,203 @@ MStatus MOF_Generator::ExportMesh(std::string& path, std::string& format, bool d
 
     MFnMesh mesh(selection_DagPath, &status);
     if (status != MStatus::kSuccess) { return Status("Failed to access selected mesh", status); }
+
+    exportReport.SetInfo("mesh", selection_DagPath.partialPathName().asUTF8());
     
 
     // ==========================================================================================================
     // Get components: Positions, Normals, UVs, Colors, Weights and Influence IDs
     // ==========================================================================================================
-    MFloatVectorArray normals;
-    mesh.getNormals(normals, MSpace::kWorld);
-    
-    MString uvSetName;
-    mesh.getCurrentUVSetName(uvSetName);
-    MFloatArray uArray, vArray;
-    mesh.getUVs(uArray, vArray, &uvSetName);
-    
-    MString colorSetName;
-    if (mesh.numColorSets() > 0) { mesh.getCurrentColorSetName(colorSetName); }
+    MeshArrays meshArrays;
+    status = ExtractMeshArrays(mesh, meshArrays);
+    if (status != MStatus::kSuccess) { return Status("Failed to extract the mesh data", status); }
 
-    std::vector<Vertex> verticesWithWeightsAndIDs;   
-    status = Skinner::FindMeshWeightsAndInfluences(selection_DagPath, verticesWithWeightsAndIDs);
+    // @note Indexed by the Maya vertex ID
+    SkinInfluences skinInfluences;   
+    status = Skinner::FindMeshWeightsAndInfluences(selection_DagPath, settings.maxInfluences, skinInfluences);
     // if (status == MStatus::kFailure) { return status; }
-    if (verticesWithWeightsAndIDs.size() != 0) { meshType = Type::Animated; }
+    if (skinInfluences.weights.size() != 0) { meshType = Type::Animated; }
+
     // ==========================================================================================================
-    // Iterate through the mesh and create vertices to then generate the .mof file
+    // Weld, assign the weights, optimize and pick the vertex format
     // ==========================================================================================================
-    MObject        meshObj = selection_DagPath.node();
-    MItMeshPolygon polyIt(meshObj, &status);
+    MeshData          meshData;
+    MeshProcessReport report;
+    MeshProcessor::Process(meshArrays, std::move(skinInfluences), settings, meshData, report);
 
-    if (status != MStatus::kSuccess) { return Status("Failed to create polygon iterator", status); }
+    // @note Nothing reads the Maya arrays after this, on big meshes they take more than the processed mesh itself
+    meshArrays = MeshArrays{};
 
-    for (; !polyIt.isDone(); polyIt.next())
+    if (report.optimized)
     {
-        // Triangulated vertex indices
-        MPointArray triPoints;
-        MIntArray   triVertIds;
-        polyIt.getTriangles(triPoints, triVertIds);
-
-        // Polygon vertex indices
-        MIntArray polygonVertices;
-        polyIt.getVertices(polygonVertices);
-        
-        int faceIndex = polyIt.index();
-
-        int triIdx = 0;
-        for (unsigned int i = 0; i < triVertIds.length(); ++i)
-        {
-            int globalVertexId = triVertIds[triIdx];
-            triIdx++;
-
-            Vertex vert{};            
-            mesh.getPoint(globalVertexId, vert.position, MSpace::kObject);
-            vert.color  = MColor(1.0f, 1.0f, 1.0f);
-            vert.normal = { 0.0f, 0.0f, 0.0f };
-            vert.u      = 0.0f;
-            vert.v      = 0.0f;
-
-
-            // Local vertex index
-            int localIndex = -1;
-            for (unsigned int k = 0; k < polygonVertices.length(); ++k) 
-            {
-                if (polygonVertices[k] == globalVertexId) 
-                {
-                    localIndex = k; 
-                    break; 
-                }
-            }
-                                             
-            if (localIndex >= 0)
-            {                               
-                unsigned int nIdx = polyIt.normalIndex(localIndex, &status);
-                vert.normal = normals[nIdx];                                              
-
-                int uvIndex = -1;
-                if (polyIt.getUVIndex(localIndex, uvIndex, &uvSetName) == MStatus::kSuccess)
-                {
-                    if (uvIndex >= 0 && uvIndex < (int)uArray.length()) 
-                    {
-                        vert.u = uArray[uvIndex];
-                        vert.v = vArray[uvIndex];
-                    }
-                }
-             
-                if (mesh.numColors() > 0)
-                {
-                    int colorIndex = -1;
-                    if (polyIt.getColorIndex(localIndex, colorIndex, &colorSetName) == MStatus::kSuccess)
-                    {
-                        mesh.getColor(colorIndex, vert.color, &colorSetName);
-                    }
-                }
-            }
-
-            if (deduplicate) 
-            {            
-                if (!hashedVertices.contains(vert)) 
-                {
-                    hashedVertices[vert] = counter;
-                    finalVertices.emplace_back(vert);
-                    counter++;
-                }
-                else
-                {            
-                    duplicatedVertices++;
-                }               
-
-                indices.emplace_back(hashedVertices[vert]);
-            }
-            else 
-            {
-                if (!hashedVertices.contains(vert))
-                {
-                    hashedVertices[vert] = duplicatedVertices;
-                    duplicatedVertices++;
-                }
-
-                finalVertices.emplace_back(vert);                
-                indices.emplace_back(counter);
-                counter++;                
-            }
-        }
+        MString info = "Index buffer optimized in "; info += report.optimizeSeconds; info += " seconds";
+        info += " | ACMR [ "; info += report.cacheBefore.acmr; info += " -> "; info += report.cacheAfter.acmr; info += " ]";
+        info += " | ATVR [ "; info += report.cacheBefore.atvr; info += " -> "; info += report.cacheAfter.atvr; info += " ]";
+        MGlobal::displayInfo(info);
     }
 
-    // ==========================================================================================================
-    // Assign the influence IDs and their respective weights
-    // ==========================================================================================================   
-
-    MGlobal::displayInfo("NAN");
-
-    for (size_t fvIdx = 0; fvIdx < finalVertices.size(); fvIdx++)
+    if (report.compactFallback)
     {
-        for (size_t wIdvIdx = 0; wIdvIdx < verticesWithWeightsAndIDs.size(); wIdvIdx++)
-        {
-            if (finalVertices[fvIdx].Compare(verticesWithWeightsAndIDs[wIdvIdx]))
-            {
-                // Cop-Cop Copy
-                for (size_t cpyIdx = 0; cpyIdx < 4; cpyIdx++)
-                {   
-                    finalVertices[fvIdx].jointID[cpyIdx] = verticesWithWeightsAndIDs[wIdvIdx].jointID[cpyIdx];
-                    finalVertices[fvIdx].weight[cpyIdx]  = verticesWithWeightsAndIDs[wIdvIdx].weight [cpyIdx];
-                }
-            }
-        }
+        MGlobal::displayWarning("The skin has too many influences for 8 bit joint IDs, the mesh is going to be written with the float layout");
     }
 
     // ==========================================================================================================
     // Get Skeleton bones IDs 
     // ==========================================================================================================    
-    std::vector<Joint> skeleton{};
-    Root               root;
-    MAF_Helper::GetAnimationData(selection_DagPath, root, skeleton, AnimationGatheringInformation::JOINT_HIERARCHY);
+    Skeleton skeleton;
+    if (meshType == Type::Animated)
+    {
+        std::vector<Joint> joints{};
+        Root               root;
+        MAF_Helper::GetAnimationData(selection_DagPath, root, joints, AnimationGatheringInformation::JOINT_HIERARCHY);
+        MAF_Helper::BuildSkeleton(root, joints, skeleton);
+
+        exportReport.SetCount("joints",     skeleton.joints.size() + 1);
+        exportReport.SetCount("influences", (uint64_t)meshData.skin.maxInfluences);
+    }
 
     // ==========================================================================================================
     // Write file and display the time that it took to process the model export
     // ==========================================================================================================   
-    WriteFile(finalVertices, indices, skeleton, root, path, format, meshType);
+    const Skeleton* fileSkeleton = (meshType == Type::Animated) ? &skeleton : nullptr;
+    bool            written      = false;
 
-    Print("Unique Vertices [", counter, "]  Duplicated Vertices [", duplicatedVertices, "]", -1);
+    if      (format.compare("Binary")) { written = MOF_Writer::WriteAscii  (path, meshData, fileSkeleton); }
+    else if (settings.chunkedFile)     { written = MOF_Writer::WriteChunked(path, meshData, fileSkeleton); }
+    else                               { written = MOF_Writer::WriteBinary (path, meshData, fileSkeleton); }
 
-    auto end       = std::chrono::high_resolution_clock::now();
-    float duration = std::chrono::duration<float>(end - start).count();
+    if (!written) { return Status(MString("Couldn't write ") + MString(path.c_str()), MStatus::kFailure); }
 
-    Print("Processed ", (float)finalVertices.size(), " vertices in ", duration, " seconds", -1.0f);
+    MString info = "Exported [ "; info += (int)meshData.vertices.size(); info += " ] vertices ( "; info += (int)report.duplicated; info += " duplicated ) and [ ";
+    info += (int)(meshData.indices.size() / 3); info += " ] triangles in "; info += exportReport.TotalSeconds(); info += " seconds | ";
+    info += (double)exportReport.GetCount("bytes_written"); info += " bytes";
+    MGlobal::displayInfo(info);
+
+    FinishExportReport(exportReport, path, settings.writeReport);
 
     return MStatus::kSuccess;
 }
 
-void MOF_Generator::WriteFile(std::vector<Vertex>& finalVertices, std::vector<int>& indices, std::vector<Joint> skeleton, Root& root, std::string& path, std::string& format, Type meshType)
-{	
-	std::ofstream file;
-    MFnIkJoint   rootJnt(root.rootObj);
-
-	if (!format.compare("Binary"))
-	{
-		int vCount = (int)finalVertices.size();
-		int stride = 11;
-        if (meshType == Type::Animated) { stride = 19; }
-
-		file.open(path, std::ios::out | std::ios::binary);
-
-		file.write(reinterpret_cast<char*>(&vCount), sizeof(int));
-		file.write(reinterpret_cast<char*>(&stride), sizeof(int));
-
-		for (size_t v = 0; v < finalVertices.size(); v++)
-		{
-			Vertex tmpVertex = finalVertices[v];
 
-			float pX = (float)tmpVertex.position.x;
-			float pY = (float)tmpVertex.position.y;
-			float pZ = (float)tmpVertex.position.z;
+// @note Pulls the whole mesh with a few bulk calls instead of querying MItMeshPolygon for every triangle corner.
+// getTriangleOffsets already gives the face-vertex offset of every triangle corner, so there's no need to look
+// for the local index of a vertex inside its polygon anymore.
+MStatus MOF_Generator::ExtractMeshArrays(MFnMesh& mesh, MeshArrays& meshArrays)
+{
+    ExportReport::ScopedTimer timer("extract");
+    ExportReport::ScopedCount mayaCalls("maya_calls");
 
-			file.write(reinterpret_cast<char*>(&pX), sizeof(float));
-			file.write(reinterpret_cast<char*>(&pY), sizeof(float));
-			file.write(reinterpret_cast<char*>(&pZ), sizeof(float));
+    MStatus status;
 
-			float cR = (float)tmpVertex.color.r;
-			float cG = (float)tmpVertex.color.g;
-			float cB = (float)tmpVertex.color.b;
+    // Triangles
+    MIntArray triangleCounts, triangleCorners;
+    status = mayaCalls(mesh.getTriangleOffsets(triangleCounts, triangleCorners));
+    if (status != MStatus::kSuccess) { return status; }
 
-			file.write(reinterpret_cast<char*>(&cR), sizeof(float));
-			file.write(reinterpret_cast<char*>(&cG), sizeof(float));
-			file.write(reinterpret_cast<char*>(&cB), sizeof(float));
+    CopyArray(triangleCounts,  meshArrays.triangleCounts);
+    CopyArray(triangleCorners, meshArrays.triangleCorners);
 
-			float nX = (float)tmpVertex.normal.x;
-			float nY = (float)tmpVertex.normal.y;
-			float nZ = (float)tmpVertex.normal.z;
+    // Vertex IDs
+    MIntArray polygonCounts, polygonConnects;
+    status = mayaCalls(mesh.getVertices(polygonCounts, polygonConnects));
+    if (status != MStatus::kSuccess) { return status; }
 
-			file.write(reinterpret_cast<char*>(&nX), sizeof(float));
-			file.write(reinterpret_cast<char*>(&nY), sizeof(float));
-			file.write(reinterpret_cast<char*>(&nZ), sizeof(float));
+    CopyArray(polygonConnects, meshArrays.faceVertexIDs);
 
-			file.write(reinterpret_cast<char*>(&tmpVertex.u), sizeof(float));
-			file.write(reinterpret_cast<char*>(&tmpVertex.v), sizeof(float));
+    // Positions
+    int          vertexCount = mayaCalls(mesh.numVertices());
+    const float* rawPoints   = mayaCalls(mesh.getRawPoints(&status));
+    if (status != MStatus::kSuccess) { return status; }
 
-            if (meshType == Type::Animated)
-            {
-                int nIdx0 = (tmpVertex.jointID[0] + 1);
-                int nIdx1 = (tmpVertex.jointID[1] + 1);
-                int nIdx2 = (tmpVertex.jointID[2] + 1);
-                int nIdx3 = (tmpVertex.jointID[3] + 1);
-			    file.write(reinterpret_cast<char*>(&nIdx0), sizeof(int));
-			    file.write(reinterpret_cast<char*>(&nIdx1), sizeof(int));
-			    file.write(reinterpret_cast<char*>(&nIdx2), sizeof(int));
-			    file.write(reinterpret_cast<char*>(&nIdx3), sizeof(int));
-            
-                file.write(reinterpret_cast<char*>(&tmpVertex.weight[0]), sizeof(float));
-                file.write(reinterpret_cast<char*>(&tmpVertex.weight[1]), sizeof(float));
-                file.write(reinterpret_cast<char*>(&tmpVertex.weight[2]), sizeof(float));
-                file.write(reinterpret_cast<char*>(&tmpVertex.weight[3]), sizeof(float));
-            }
-		}
-
-		int iCount = indices.size();				
-		file.write(reinterpret_cast<char*>(&iCount), sizeof(int));
-		for (size_t i = 0; i < indices.size(); i++)
-		{
-			file.write(reinterpret_cast<char*>(&indices[i]), sizeof(int));			
-		}
-
-        if (meshType == Type::Animated)
-        {         
-            MAnimControl::setCurrentTime(MAnimControl::animationStartTime());
-
-            // @note the +1 is the root.
-            int size = skeleton.size() + 1;
-            file.write(reinterpret_cast<const char*>(&size), sizeof(int));
-            
-            WriteRoot(file, root);
-            
-            for (size_t jnt = 0; jnt < skeleton.size(); jnt++)
-            {   
-                Joint tmpJoint = skeleton[jnt];
-                WriteJoint(file, tmpJoint);
-            }
-        }
+    meshArrays.points.assign(rawPoints, rawPoints + (size_t)vertexCount * 3);
 
-	}
-	else // Just for debuggin purposes
-	{
-        int stride = 11;
-        if (meshType == Type::Animated) { stride = 19; }
+    // Normals
+    MIntArray         normalCounts, normalIDs;
+    MFloatVectorArray normals;
+    mayaCalls(mesh.getNormalIds(normalCounts, normalIDs));
+    mayaCalls(mesh.getNormals(normals, MSpace::kWorld));
 
-		file.open(path, std::ios::out);
+    CopyArray(normalIDs, meshArrays.faceVertexNormalIDs);
 
-		file << finalVertices.size() << "\n";
-		file << stride << "\n";
-		
-		for (size_t i = 0; i < finalVertices.size(); i++)
-		{
-			Vertex tmpVertex = finalVertices[i];
-			file << tmpVertex.position.x << ", ";
-			file << tmpVertex.position.y << ", ";
-			file << tmpVertex.position.z << ", ";
+    meshArrays.normals.resize((size_t)normals.length() * 3);
+    for (unsigned int n = 0; n < normals.length(); n++)
+    {
+        meshArrays.normals[n * 3 + 0] = normals[n].x;
+        meshArrays.normals[n * 3 + 1] = normals[n].y;
+        meshArrays.normals[n * 3 + 2] = normals[n].z;
+    }
 
-			file << tmpVertex.color.r << ", ";
-			file << tmpVertex.color.g << ", ";
-			file << tmpVertex.color.b << ", ";
+    // UVs
+    // @note Every UV set with at least one face mapped gets extracted, starting with the current one.
+    // getAssignedUVs skips the faces without UVs, so the face-vertex list is rebuilt with -1 on those
+    MString      currentUVSet;
+    MStringArray uvSetNames;
+    mayaCalls(mesh.getCurrentUVSetName(currentUVSet));
+    mayaCalls(mesh.getUVSetNames(uvSetNames));
 
-			file << tmpVertex.normal.x << ", ";
-			file << tmpVertex.normal.y << ", ";
-			file << tmpVertex.normal.z << ", ";
+    std::vector<MString> orderedSets{ currentUVSet };
+    for (unsigned int s = 0; s < uvSetNames.length(); s++)
+    {
+        if (uvSetNames[s] != currentUVSet) { orderedSets.emplace_back(uvSetNames[s]); }
+    }
 
-			file << tmpVertex.u << ", ";
-			file << tmpVertex.v << ", ";
+    meshArrays.uvSets.clear();
+    for (MString& uvSetName : orderedSets)
+    {
+        if (meshArrays.UVSetCount() == MAX_UV_SETS) { break; }
 
-            if (meshType == Type::Animated)
-            {
-                // Need to add 1 because, the Root is the index 0 of the skeleton joints...
-                file << tmpVertex.jointID[0] + 1 << ", ";
-                file << tmpVertex.jointID[1] + 1 << ", ";
-                file << tmpVertex.jointID[2] + 1 << ", ";
-                file << tmpVertex.jointID[3] + 1 << ", ";
-
-                file << tmpVertex.weight[0] << ", ";
-                file << tmpVertex.weight[1] << ", ";
-                file << tmpVertex.weight[2] << ", ";
-                file << tmpVertex.weight[3] << ", \n";
-            }
-            else
-            {
-                file << "\n";
-            }
-		}
+        MFloatArray uArray, vArray;
+        MIntArray   uvCounts, uvIDs;
+        mayaCalls(mesh.getUVs(uArray, vArray, &uvSetName));
+        mayaCalls(mesh.getAssignedUVs(uvCounts, uvIDs, &uvSetName));
 
-		file << indices.size() << ", \n";
+        if (uvIDs.length() == 0) { continue; }
 
-		int nLine = -1;
+        UVSet uvSet;
+        CopyArray(uArray, uvSet.us);
+        CopyArray(vArray, uvSet.vs);
 
-		for (size_t i = 0; i < indices.size(); i++)
-		{
-			file << indices[i] << ", ";
-			if ((nLine = (nLine + 1) % 3) == 2)
-			{
-				file << "\n";
-			}
-		}
+        uvSet.faceVertexUVIDs.assign(polygonConnects.length(), -1);
 
-        if (meshType == Type::Animated)
+        unsigned int faceVertex = 0;
+        unsigned int uvOffset   = 0;
+        for (unsigned int p = 0; p < polygonCounts.length(); p++)
         {
-            // @important 
-            // @note The first frame of animation is the one that will be placed as the default A/T pose. Export the MOF file with an A pose as a base mesh
-            // if the model is animated
-            //
-            JointTransform transform{};
-            MAnimControl::setCurrentTime(MAnimControl::animationStartTime());
-
-            // @warning Right now I don't have the root children!!!
-            // @note the +1 is the root.
-            file << skeleton.size() + 1 << "\n";
-            file << rootJnt.name() << " --- Idx [0] | Parent Idx [0] --- Children [ " << root.childrenIDs.size() << " ] | ";
-
-            for (unsigned int cI = 0; cI < root.childrenIDs.size(); cI++)
-            {
-                file << root.childrenIDs[cI] + 1 << " ";
-            }
-
-            file << "\n";
+            bool hasUVs = p < uvCounts.length() && uvCounts[p] == polygonCounts[p];
 
-            MAF_Helper::GetTransform(rootJnt, transform);
-            file << "Position [ " << transform.position.x << ", " << transform.position.y << ", " << transform.position.z << "]\n";
-            file << "Rotation [ " << transform.rotation.x << ", " << transform.rotation.y << ", " << transform.rotation.z << ", " << transform.rotation.w << "]\n";
-            file << "Scale    [ " << transform.scale.x << ", " << transform.scale.y << ", " << transform.scale.z << "]\n";
-            file << "Shear    [ " << transform.shear.x << ", " << transform.shear.y << ", " << transform.shear.z << "]\n\n";
-
-            for (size_t jnt = 0; jnt < skeleton.size(); jnt++)
+            for (int c = 0; c < polygonCounts[p]; c++, faceVertex++)
             {
-
-                file << skeleton[jnt].name << " --- Idx [" << skeleton[jnt].influenceID + 1 << "] | Parent Idx [" << skeleton[jnt].parentID + 1 << "] --- ";
-                
-                file << "Children [" << skeleton[jnt].childrenIDs.size() << "] | ";
-                for (unsigned int cI = 0; cI < skeleton[jnt].childrenIDs.size(); cI++)
-                {
-                    file << skeleton[jnt].childrenIDs[cI] + 1 << " ";
+                if (hasUVs) 
+                { 
+                    int uvIndex = uvIDs[uvOffset + c];
+                    if (uvIndex >= 0 && uvIndex < (int)uArray.length()) { uvSet.faceVertexUVIDs[faceVertex] = uvIndex; }
                 }
-                file << "\n";
-
-                MFnIkJoint joint = skeleton[jnt].GetThisJoint();
-                MAF_Helper::GetTransform(joint, transform);
-                file << "Position [ " << transform.position.x << ", " << transform.position.y << ", " << transform.position.z << "]\n";
-                file << "Rotation [ " << transform.rotation.x << ", " << transform.rotation.y << ", " << transform.rotation.z << ", " << transform.rotation.w << "]\n";
-                file << "Scale    [ " << transform.scale.x << ", " << transform.scale.y << ", " << transform.scale.z << "]\n";
-                file << "Shear    [ " << transform.shear.x << ", " << transform.shear.y << ", " << transform.shear.z << "]\n\n";
-
             }
-        }
-	}
 
-	file.close();
-}
-
-
-void MOF_Generator::WriteJoint(std::ofstream& file, Joint& joint)
-{
-    MFnIkJoint     mJoint = joint.GetThisJoint();
-    JointTransform transform{};
-    MAF_Helper::GetTransform(mJoint, transform);
+            if (p < uvCounts.length()) { uvOffset += uvCounts[p]; }
+        }
 
-    
-    // NAME
-    //
-    int nameLength = strlen(joint.name.asUTF8());
-    file.write(reinterpret_cast<char*>(&nameLength),               sizeof(int));
-    file.write(reinterpret_cast<const char*>(joint.name.asUTF8()), sizeof(char) * nameLength); // @note check this ones
-
-    // IDs
-    //
-    int ownId  = joint.influenceID + 1;
-    int parent = joint.parentID    + 1;
-    file.write(reinterpret_cast<char*>(&ownId),  sizeof(int));
-    file.write(reinterpret_cast<char*>(&parent), sizeof(int));
-
-    // Childrens
-    //
-    int childCount = joint.childrenIDs.size();
-    file.write(reinterpret_cast<char*>(&childCount), sizeof(int));
-
-    for (unsigned int cI = 0; cI < childCount; cI++)
-    {
-        int idx = joint.childrenIDs[cI] + 1;
-        file.write(reinterpret_cast<char*>(&idx), sizeof(int));
+        meshArrays.uvSets.emplace_back(std::move(uvSet));
     }
 
-    // Transform
-    //
-    float pX = (float)transform.position.x;
-    float pY = (float)transform.position.y;
-    float pZ = (float)transform.position.z;
-    file.write(reinterpret_cast<char*>(&pX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&pY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&pZ), sizeof(float));
-
-    float rX = (float)transform.rotation.x;
-    float rY = (float)transform.rotation.y;
-    float rZ = (float)transform.rotation.z;
-    float rW = (float)transform.rotation.w;
-    file.write(reinterpret_cast<char*>(&rX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rZ), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rW), sizeof(float));
-
-    float sX = (float)transform.scale.x;
-    float sY = (float)transform.scale.y;
-    float sZ = (float)transform.scale.z;
-    file.write(reinterpret_cast<char*>(&sX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&sY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&sZ), sizeof(float));
-
-    float shX = (float)transform.shear.x;
-    float shY = (float)transform.shear.y;
-    float shZ = (float)transform.shear.z;
-    file.write(reinterpret_cast<char*>(&shX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&shY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&shZ), sizeof(float));            
-}
-
-
-void MOF_Generator::WriteRoot(std::ofstream& file, Root& root)
-{    
-    MFnIkJoint rootJnt(root.rootObj);
-    JointTransform transform{};
-    MAF_Helper::GetTransform(rootJnt, transform);
-       
-    // NAME
-    //
-    int nameLength = strlen(rootJnt.name().asUTF8());
-    file.write(reinterpret_cast<char*>(&nameLength),                sizeof(int));
-    file.write(reinterpret_cast<const char*>(rootJnt.name().asUTF8()), sizeof(char) * nameLength); // @note check this ones
-
-    // IDs
-    //
-    int ids = 0;
-    file.write(reinterpret_cast<char*>(&ids), sizeof(int));
-    file.write(reinterpret_cast<char*>(&ids), sizeof(int));
-
-    // Childrens
-    //
-    int childCount = root.childrenIDs.size();
-    file.write(reinterpret_cast<char*>(&childCount), sizeof(int));
-
-    for (unsigned int cI = 0; cI < childCount; cI++)
+    // Colors
+    meshArrays.faceVertexColors.clear();
+    if (mayaCalls(mesh.numColorSets()) > 0)
     {
-        int idx = root.childrenIDs[cI] + 1;
-        file.write(reinterpret_cast<char*>(&idx), sizeof(int));        
+        MString     colorSetName;
+        MColorArray colors;
+        MColor      unsetColor(1.0f, 1.0f, 1.0f);
+        mayaCalls(mesh.getCurrentColorSetName(colorSetName));
+        mayaCalls(mesh.getFaceVertexColors(colors, &colorSetName, &unsetColor));
+
+        meshArrays.faceVertexColors.resize((size_t)colors.length() * 3);
+        for (unsigned int c = 0; c < colors.length(); c++)
+        {
+            meshArrays.faceVertexColors[c * 3 + 0] = colors[c].r;
+            meshArrays.faceVertexColors[c * 3 + 1] = colors[c].g;
+            meshArrays.faceVertexColors[c * 3 + 2] = colors[c].b;
+        }
     }
 
-    // Transform
-    //
-    float pX = (float)transform.position.x;
-    float pY = (float)transform.position.y;
-    float pZ = (float)transform.position.z;
-    file.write(reinterpret_cast<char*>(&pX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&pY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&pZ), sizeof(float));
-
-    float rX = (float)transform.rotation.x;
-    float rY = (float)transform.rotation.y;
-    float rZ = (float)transform.rotation.z;
-    float rW = (float)transform.rotation.w;
-    file.write(reinterpret_cast<char*>(&rX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rZ), sizeof(float));
-    file.write(reinterpret_cast<char*>(&rW), sizeof(float));
-
-    float sX = (float)transform.scale.x;
-    float sY = (float)transform.scale.y;
-    float sZ = (float)transform.scale.z;
-    file.write(reinterpret_cast<char*>(&sX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&sY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&sZ), sizeof(float));
-
-    float shX = (float)transform.shear.x;
-    float shY = (float)transform.shear.y;
-    float shZ = (float)transform.shear.z;
-    file.write(reinterpret_cast<char*>(&shX), sizeof(float));
-    file.write(reinterpret_cast<char*>(&shY), sizeof(float));
-    file.write(reinterpret_cast<char*>(&shZ), sizeof(float));
-    
-}
\ No newline at end of file
+    return MStatus::kSuccess;
+}
@@ -4,9 +4,10 @@
 #include <fstream>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <map>
 #include <chrono>
+#include <algorithm>
+#include <utility>
 
 #include <maya/MGlobal.h>  
 
@@ -21,37 +22,26 @@
 #include <maya/MFnSkinCluster.h> // @note Needs OpenMayaAnim.lib to be included
 #include <maya/MItGeometry.h>
 #include <maya/MWeight.h>
-#include <maya/MItMeshPolygon.h>
+#include <maya/MColorArray.h>
 
 #include "Types.h"
+#include "MeshArrays.h"
+#include "MeshProcessor.h"
 #include "Skinner.h"
 #include "MAF_Helper.h"
+#include "MOF_Writer.h"
 #include "Utilities.h" 
 
 namespace MOF_Generator
-{		
-	MStatus ExportMesh(std::string& path, std::string& format, bool deduplicate);
-	void	WriteFile(std::vector<Vertex>& finalVertices, std::vector<int>& indices, std::vector<Joint> skeleton, Root& root, std::string& path, std::string& format, Type meshType);
-	void	WriteJoint(std::ofstream& file, Joint& joint);
-	void	WriteRoot (std::ofstream& file, Root& root);
+{
+	MStatus ExportMesh(std::string& path, std::string& format, const MeshExportSettings& settings);
+	MStatus ExtractMeshArrays(MFnMesh& mesh, MeshArrays& meshArrays);
 
-	template <typename T>
-	void Print(MString first, T fVal, MString second, T sVal, MString third, T tVal)
+	template <typename MayaArray, typename T>
+	void CopyArray(const MayaArray& source, std::vector<T>& destination)
 	{
-		MString finalSentence = "";
-		finalSentence += first;
-		finalSentence += fVal;
-
-		finalSentence += second;
-		if (sVal != -1)
-			finalSentence += sVal;
-
-		finalSentence += third;
-
-		if (tVal != -1)
-			finalSentence += tVal;
-
-		MGlobal::displayInfo(finalSentence);
+		destination.resize(source.length());
+		if (source.length() > 0) { source.get(destination.data()); }
 	}
  
 }
@@ -0,0 +1,309 @@
+#include "MOF_Writer.h"
+
+#include <fstream>
+#include <cstring>
+
+#include "ChunkWriter.h"
+#include "MOF_Format.h"
+#include "MAF_Writer.h"
+#include "VertexQuantizer.h"
+#include "ExportReport.h"
+
+namespace
+{
+    void WriteJointRecord(BinaryWriter& writer, const std::string& name, int id, int parentID, const std::vector<int>& childrenIDs, const Transform& transform)
+    {
+        // NAME
+        //
+        writer.WriteString(name.c_str());
+
+        // IDs
+        //
+        writer.Write(id);
+        writer.Write(parentID);
+
+        // Childrens
+        //
+        writer.Write((int)childrenIDs.size());
+
+        for (int childID : childrenIDs) { writer.Write((int)(childID + 1)); }
+
+        // Transform
+        //
+        MAF_Writer::SerializeTransform(writer, transform);
+    }
+
+    void WriteTransformText(std::ofstream& file, const Transform& transform)
+    {
+        file << "Position [ " << transform.position[0] << ", " << transform.position[1] << ", " << transform.position[2] << "]\n";
+        file << "Rotation [ " << transform.rotation[0] << ", " << transform.rotation[1] << ", " << transform.rotation[2] << ", " << transform.rotation[3] << "]\n";
+        file << "Scale    [ " << transform.scale[0]    << ", " << transform.scale[1]    << ", " << transform.scale[2]    << "]\n";
+        file << "Shear    [ " << transform.shear[0]    << ", " << transform.shear[1]    << ", " << transform.shear[2]    << "]\n\n";
+    }
+}
+
+
+// @note The vertices only carry the streams of the descriptor. Files with the legacy channels and the float layout keep the
+// old header [vCount, stride in floats (11, 19 or 27)]. The rest of them put 0 in the stride slot (the old format always has
+// at least 11 floats) followed by:
+//
+//  int      layoutID          0 float, 1 compact
+//  int      stride            Bytes
+//  uint32   attributeMask     VertexFormat::Attribute bits
+//  int      influences        Per vertex, 0 for static meshes
+//  int      streamCount
+//  Stream   streams[streamCount]
+//  float    bounds            Compact only [posMin xyz, posMax xyz] and then [uvMin uv, uvMax uv] per UV set
+//
+bool MOF_Writer::WriteBinary(const std::string& path, const MeshData& mesh, const Skeleton* skeleton)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    const VertexFormat::Descriptor& vertexFormat = mesh.format;
+
+    int vCount = (int)mesh.vertices.size();
+    int iCount = (int)mesh.indices.size();
+
+    // @note Size the whole file up front so the staging buffer never grows: header (+ bounds), vertices, indices and skeleton
+    size_t fileSize = 64 * sizeof(int) + vertexFormat.streams.size() * sizeof(VertexFormat::Stream)
+                    + mesh.vertices.size() * vertexFormat.stride 
+                    + sizeof(int) + mesh.indices.size() * sizeof(int);
+
+    if (skeleton)
+    {
+        fileSize += sizeof(int) + (skeleton->joints.size() + 1) * JOINT_RECORD_SIZE;
+        fileSize += skeleton->rootName.size() + skeleton->rootChildren.size() * sizeof(int);
+        for (const SkeletonJoint& joint : skeleton->joints) { fileSize += joint.name.size() + joint.childrenIDs.size() * sizeof(int); }
+    }
+
+    BinaryWriter writer(fileSize);
+
+    writer.Write(vCount);
+
+    VertexQuantizer::QuantizationBounds bounds{};
+    
+    if (vertexFormat.IsLegacy())
+    {
+        writer.Write((int)(vertexFormat.stride / sizeof(float)));
+    }
+    else
+    {
+        writer.Write((int)0);
+        writer.Write((int)vertexFormat.layout);
+        writer.Write((int)vertexFormat.stride);
+        writer.Write(vertexFormat.attributeMask);
+        writer.Write((int)vertexFormat.maxInfluences);
+        writer.Write((int)vertexFormat.streams.size());
+        writer.WriteArray(vertexFormat.streams.data(), vertexFormat.streams.size());
+
+        if (vertexFormat.layout == VertexLayout::Compact)
+        {
+            bounds = VertexQuantizer::ComputeBounds(mesh.vertices, vertexFormat.uvSetCount);
+
+            writer.WriteArray(bounds.positionMin, 3);
+            writer.WriteArray(bounds.positionMax, 3);
+
+            for (int set = 0; set < vertexFormat.uvSetCount; set++)
+            {
+                writer.WriteArray(bounds.uvMin[set], 2);
+                writer.WriteArray(bounds.uvMax[set], 2);
+            }
+        }
+    }
+
+    unsigned char* packed = writer.Allocate(mesh.vertices.size() * vertexFormat.stride);
+    VertexFormat::PackVertices(mesh.vertices, mesh.Influences(), vertexFormat, bounds, packed);
+
+    writer.Write(iCount);
+    writer.WriteArray(mesh.indices.data(), mesh.indices.size());
+
+    if (skeleton) { WriteSkeleton(writer, *skeleton); }
+
+    return writer.SaveToFile(path);
+}
+
+
+// @note MOF v2, see MOF_Format.h for the chunks. Same data as WriteBinary, but every section can be used straight from a mapped file
+bool MOF_Writer::WriteChunked(const std::string& path, const MeshData& mesh, const Skeleton* skeleton)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    const VertexFormat::Descriptor& vertexFormat = mesh.format;
+
+    ChunkWriter container(MOF_Format::MAGIC, MOF_Format::VERSION);
+
+    // Vertex format
+    MOF_Format::VertexFormatRecord formatRecord{};
+    formatRecord.layout        = (int32_t)vertexFormat.layout;
+    formatRecord.stride        = (int32_t)vertexFormat.stride;
+    formatRecord.attributeMask = vertexFormat.attributeMask;
+    formatRecord.influences    = (int32_t)vertexFormat.maxInfluences;
+    formatRecord.uvSetCount    = (int32_t)vertexFormat.uvSetCount;
+    formatRecord.streamCount   = (int32_t)vertexFormat.streams.size();
+
+    BinaryWriter& formatChunk = container.AddChunk(MOF_Format::CHUNK_VERTEX_FORMAT);
+    formatChunk.Write(formatRecord);
+    formatChunk.WriteArray(vertexFormat.streams.data(), vertexFormat.streams.size());
+
+    // Bounds
+    VertexQuantizer::QuantizationBounds bounds = VertexQuantizer::ComputeBounds(mesh.vertices, vertexFormat.uvSetCount);
+    container.AddChunk(MOF_Format::CHUNK_BOUNDS).Write(bounds);
+
+    // Vertices
+    size_t        vertexBytes = mesh.vertices.size() * vertexFormat.stride;
+    BinaryWriter& vertexChunk = container.AddChunk(MOF_Format::CHUNK_VERTICES, vertexFormat.stride, vertexBytes);
+    VertexFormat::PackVertices(mesh.vertices, mesh.Influences(), vertexFormat, bounds, vertexChunk.Allocate(vertexBytes));
+
+    // Indices
+    if (mesh.vertices.size() <= 65536)
+    {
+        BinaryWriter& indexChunk = container.AddChunk(MOF_Format::CHUNK_INDICES, sizeof(uint16_t), mesh.indices.size() * sizeof(uint16_t));
+        std::vector<uint16_t> shortIndices(mesh.indices.begin(), mesh.indices.end());
+        indexChunk.WriteArray(shortIndices.data(), shortIndices.size());
+    }
+    else
+    {
+        BinaryWriter& indexChunk = container.AddChunk(MOF_Format::CHUNK_INDICES, sizeof(int32_t), mesh.indices.size() * sizeof(int32_t));
+        indexChunk.WriteArray(mesh.indices.data(), mesh.indices.size());
+    }
+
+    // Skeleton, the root first and then every joint
+    if (skeleton)
+    {
+        BinaryWriter& jointChunk    = container.AddChunk(MOF_Format::CHUNK_SKELETON, sizeof(MOF_Format::JointRecord), (skeleton->joints.size() + 1) * sizeof(MOF_Format::JointRecord));
+        BinaryWriter& childrenChunk = container.AddChunk(MOF_Format::CHUNK_CHILDREN, sizeof(int32_t));
+        BinaryWriter& nameChunk     = container.AddChunk(MOF_Format::CHUNK_NAMES);
+
+        auto addJoint = [&](int id, int parentID, const std::string& name, const std::vector<int>& childrenIDs, const Transform& transform)
+        {
+            MOF_Format::JointRecord record{};
+            record.id         = id;
+            record.parentID   = parentID;
+            record.nameOffset = (uint32_t)nameChunk.Size();
+            record.nameLength = (uint32_t)name.size();
+            record.firstChild = (uint32_t)(childrenChunk.Size() / sizeof(int32_t));
+            record.childCount = (uint32_t)childrenIDs.size();
+
+            for (int i = 0; i < 3; i++) { record.position[i] = transform.position[i]; }
+            for (int i = 0; i < 4; i++) { record.rotation[i] = transform.rotation[i]; }
+            for (int i = 0; i < 3; i++) { record.scale   [i] = transform.scale   [i]; }
+            for (int i = 0; i < 3; i++) { record.shear   [i] = transform.shear   [i]; }
+
+            jointChunk.Write(record);
+            nameChunk .WriteBytes(name.c_str(), record.nameLength + 1);
+            for (int childID : childrenIDs) { childrenChunk.Write((int32_t)(childID + 1)); }
+        };
+
+        addJoint(0, 0, skeleton->rootName, skeleton->rootChildren, skeleton->rootBindPose);
+
+        for (const SkeletonJoint& joint : skeleton->joints)
+        {
+            addJoint(joint.influenceID + 1, joint.parentID + 1, joint.name, joint.childrenIDs, joint.bindPose);
+        }
+    }
+
+    return container.SaveToFile(path);
+}
+
+
+// Just for debuggin purposes, always written with the float layout
+bool MOF_Writer::WriteAscii(const std::string& path, const MeshData& mesh, const Skeleton* skeleton)
+{
+    ExportReport::ScopedTimer timer("write");
+
+    VertexFormat::Descriptor floatFormat = VertexFormat::Build(mesh.format.attributeMask, VertexLayout::Float, mesh.format.maxInfluences);
+
+    std::ofstream file(path, std::ios::out);
+    if (!file.is_open()) { return false; }
+
+    file << mesh.vertices.size() << "\n";
+    if (!floatFormat.IsLegacy()) { file << 0 << "\n" << floatFormat.attributeMask << "\n"; }
+    file << floatFormat.stride / sizeof(float) << "\n";
+    
+    for (const Vertex& tmpVertex : mesh.vertices)
+    {
+        const int*   jointIDs = mesh.Skinned() ? &mesh.skin.jointIDs[(size_t)tmpVertex.vertexID * mesh.skin.maxInfluences] : nullptr;
+        const float* weights  = mesh.Skinned() ? &mesh.skin.weights [(size_t)tmpVertex.vertexID * mesh.skin.maxInfluences] : nullptr;
+
+        for (const VertexFormat::Stream& stream : floatFormat.streams)
+        {
+            switch (stream.semantic)
+            {
+                case VertexFormat::Semantic::Position: for (int c = 0; c < 3; c++) { file << tmpVertex.position[c] << ", "; } break;
+                case VertexFormat::Semantic::Color:    for (int c = 0; c < 3; c++) { file << tmpVertex.color   [c] << ", "; } break;
+                case VertexFormat::Semantic::Normal:   for (int c = 0; c < 3; c++) { file << tmpVertex.normal  [c] << ", "; } break;
+
+                // Need to add 1 because, the Root is the index 0 of the skeleton joints...
+                case VertexFormat::Semantic::JointIDs: for (int c = 0; c < stream.components; c++) { file << jointIDs[c] + 1 << ", "; } break;
+                case VertexFormat::Semantic::Weights:  for (int c = 0; c < stream.components; c++) { file << weights [c]     << ", "; } break;
+
+                default:
+                {
+                    int set = (int)stream.semantic - (int)VertexFormat::Semantic::UV0;
+                    file << tmpVertex.uv[set][0] << ", " << tmpVertex.uv[set][1] << ", ";
+                    break;
+                }
+            }
+        }
+
+        file << "\n";
+    }
+
+    file << mesh.indices.size() << ", \n";
+
+    int nLine = -1;
+
+    for (size_t i = 0; i < mesh.indices.size(); i++)
+    {
+        file << mesh.indices[i] << ", ";
+        if ((nLine = (nLine + 1) % 3) == 2)
+        {
+            file << "\n";
+        }
+    }
+
+    if (skeleton)
+    {
+        // @important 
+        // @note The bind pose is the first frame of animation, export the MOF file with an A pose as a base mesh if the model is animated
+        //
+        // @note the +1 is the root.
+        file << skeleton->joints.size() + 1 << "\n";
+        file << skeleton->rootName << " --- Idx [0] | Parent Idx [0] --- Children [ " << skeleton->rootChildren.size() << " ] | ";
+
+        for (int childID : skeleton->rootChildren) { file << childID + 1 << " "; }
+        file << "\n";
+
+        WriteTransformText(file, skeleton->rootBindPose);
+
+        for (const SkeletonJoint& joint : skeleton->joints)
+        {
+            file << joint.name << " --- Idx [" << joint.influenceID + 1 << "] | Parent Idx [" << joint.parentID + 1 << "] --- ";
+            
+            file << "Children [" << joint.childrenIDs.size() << "] | ";
+            for (int childID : joint.childrenIDs) { file << childID + 1 << " "; }
+            file << "\n";
+
+            WriteTransformText(file, joint.bindPose);
+        }
+    }
+
+    if (!file.good()) { return false; }
+
+    ExportReport::AddToActive("bytes_written", (uint64_t)file.tellp());
+    return true;
+}
+
+
+// @note the +1 is the root, written first with the ID 0 and 0 as its parent
+void MOF_Writer::WriteSkeleton(BinaryWriter& writer, const Skeleton& skeleton)
+{
+    writer.Write((int)(skeleton.joints.size() + 1));
+
+    WriteJointRecord(writer, skeleton.rootName, 0, 0, skeleton.rootChildren, skeleton.rootBindPose);
+
+    for (const SkeletonJoint& joint : skeleton.joints)
+    {
+        WriteJointRecord(writer, joint.name, joint.influenceID + 1, joint.parentID + 1, joint.childrenIDs, joint.bindPose);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "MeshProcessor.h"
+#include "Skeleton.h"
+#include "BinaryWriter.h"
+
+// @note Serializes a processed mesh, no Maya in here. skeleton is nullptr for static meshes.
+// The bind pose written for every joint is Skeleton::bindPose, the first frame of the animation on the Maya side.
+//
+namespace MOF_Writer
+{
+    // @note Bytes of a skeleton joint without its name and its children: name length, IDs, children count and the transform
+    constexpr size_t JOINT_RECORD_SIZE = 4 * sizeof(int) + 13 * sizeof(float);
+
+    bool WriteBinary (const std::string& path, const MeshData& mesh, const Skeleton* skeleton);
+    bool WriteChunked(const std::string& path, const MeshData& mesh, const Skeleton* skeleton);
+    bool WriteAscii  (const std::string& path, const MeshData& mesh, const Skeleton* skeleton);
+
+    void WriteSkeleton(BinaryWriter& writer, const Skeleton& skeleton);
+}
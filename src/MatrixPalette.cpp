@@ -0,0 +1,270 @@
+#include "MatrixPalette.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Parallel.h"
+#include "ExportReport.h"
+
+
+void MatrixPalette::ToAffine(const float* position, const float* rotation, const float* scale, const float* shear, Affine& out)
+{
+    const float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+
+    const float r[9] =
+    {
+        1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z),        2.0f * (x * z + w * y),
+        2.0f * (x * y + w * z),        1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x),
+        2.0f * (x * z - w * y),        2.0f * (y * z + w * x),        1.0f - 2.0f * (x * x + y * y),
+    };
+
+    // Shear xy, xz, yz as upper triangular, then the scale of every column
+    const float h[9] =
+    {
+        1.0f, shear[0], shear[1],
+        0.0f, 1.0f,     shear[2],
+        0.0f, 0.0f,     1.0f,
+    };
+
+    for (int row = 0; row < 3; row++)
+    {
+        for (int column = 0; column < 3; column++)
+        {
+            float value = 0.0f;
+            for (int k = 0; k < 3; k++) { value += r[row * 3 + k] * h[k * 3 + column]; }
+            out.linear[row * 3 + column] = value * scale[column];
+        }
+        out.translation[row] = position[row];
+    }
+}
+
+
+void MatrixPalette::ToAffine(const Transform& transform, Affine& out)
+{
+    ToAffine(transform.position, transform.rotation, transform.scale, transform.shear, out);
+}
+
+
+void MatrixPalette::Compose(const Affine& parent, const Affine& local, Affine& out)
+{
+    for (int row = 0; row < 3; row++)
+    {
+        for (int column = 0; column < 3; column++)
+        {
+            out.linear[row * 3 + column] = parent.linear[row * 3 + 0] * local.linear[0 * 3 + column] +
+                                           parent.linear[row * 3 + 1] * local.linear[1 * 3 + column] +
+                                           parent.linear[row * 3 + 2] * local.linear[2 * 3 + column];
+        }
+
+        out.translation[row] = parent.linear[row * 3 + 0] * local.translation[0] +
+                               parent.linear[row * 3 + 1] * local.translation[1] +
+                               parent.linear[row * 3 + 2] * local.translation[2] + parent.translation[row];
+    }
+}
+
+
+// Adjugate over the determinant, in doubles. The translation goes back through the inverted linear part
+void MatrixPalette::Invert(const Affine& affine, Affine& out)
+{
+    const float* m = affine.linear;
+
+    double adjugate[9] =
+    {
+        (double)m[4] * m[8] - (double)m[5] * m[7], (double)m[2] * m[7] - (double)m[1] * m[8], (double)m[1] * m[5] - (double)m[2] * m[4],
+        (double)m[5] * m[6] - (double)m[3] * m[8], (double)m[0] * m[8] - (double)m[2] * m[6], (double)m[2] * m[3] - (double)m[0] * m[5],
+        (double)m[3] * m[7] - (double)m[4] * m[6], (double)m[1] * m[6] - (double)m[0] * m[7], (double)m[0] * m[4] - (double)m[1] * m[3],
+    };
+
+    const double determinant = m[0] * adjugate[0] + m[1] * adjugate[3] + m[2] * adjugate[6];
+    const double inverse     = (determinant != 0.0) ? 1.0 / determinant : 0.0;
+
+    for (int row = 0; row < 3; row++)
+    {
+        double translation = 0.0;
+        for (int column = 0; column < 3; column++)
+        {
+            out.linear[row * 3 + column] = (float)(adjugate[row * 3 + column] * inverse);
+            translation -= adjugate[row * 3 + column] * inverse * affine.translation[column];
+        }
+        out.translation[row] = (float)translation;
+    }
+}
+
+
+std::vector<uint32_t> MatrixPalette::HierarchyOrder(const std::vector<int>& parents, std::vector<int>& parentOf)
+{
+    const uint32_t jointCount = (uint32_t)parents.size();
+
+    parentOf.assign(jointCount, -1);
+    for (uint32_t joint = 0; joint < jointCount; joint++)
+    {
+        if (parents[joint] >= 0 && (uint32_t)parents[joint] < jointCount) { parentOf[joint] = parents[joint]; }
+    }
+
+    // Walks up from every joint until an already placed one, then places the chain from the top down.
+    // A chain that runs into itself is a loop, its last joint becomes a root
+    enum : uint8_t { NEW, WALKED, PLACED };
+
+    std::vector<uint8_t>  state(jointCount, NEW);
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> chain;
+    order.reserve(jointCount);
+
+    for (uint32_t joint = 0; joint < jointCount; joint++)
+    {
+        chain.clear();
+
+        int current = (int)joint;
+        while (current >= 0 && state[current] == NEW)
+        {
+            state[current] = WALKED;
+            chain.emplace_back((uint32_t)current);
+            current = parentOf[current];
+        }
+
+        if (current >= 0 && state[current] == WALKED) { parentOf[chain.back()] = -1; }
+
+        for (size_t c = chain.size(); c-- > 0; )
+        {
+            state[chain[c]] = PLACED;
+            order.emplace_back(chain[c]);
+        }
+    }
+
+    return order;
+}
+
+
+void MatrixPalette::InverseBind(const std::vector<Transform>& bindPose, const std::vector<int>& parents, std::vector<Affine>& inverseBind)
+{
+    std::vector<int> bindParents(parents);
+    bindParents.resize(bindPose.size(), 0);
+
+    std::vector<int>      parentOf;
+    std::vector<uint32_t> order = HierarchyOrder(bindParents, parentOf);
+
+    std::vector<Affine> world(bindPose.size());
+    inverseBind.resize(bindPose.size());
+
+    Affine local;
+    for (uint32_t joint : order)
+    {
+        ToAffine(bindPose[joint], local);
+
+        if (parentOf[joint] >= 0) { Compose(world[parentOf[joint]], local, world[joint]); }
+        else                      { world[joint] = local; }
+
+        Invert(world[joint], inverseBind[joint]);
+    }
+}
+
+
+// @note The frames don't depend on each other, every thread bakes a range of them with its own object space transforms
+void MatrixPalette::Bake(const AnimationClip& clip, const std::vector<int>& parents, const std::vector<Affine>& inverseBind, PaletteClip& palette, unsigned int threadCount)
+{
+    ExportReport::ScopedTimer timer("palette");
+
+    palette.frameRate  = clip.frameRate;
+    palette.jointCount = clip.jointCount;
+    palette.frameCount = clip.frameCount;
+    palette.matrices.assign((size_t)clip.frameCount * clip.jointCount * MATRIX_FLOATS, 0.0f);
+
+    std::vector<int> clipParents(parents);
+    clipParents.resize(clip.jointCount, 0);
+
+    std::vector<int>      parentOf;
+    std::vector<uint32_t> order = HierarchyOrder(clipParents, parentOf);
+
+    Parallel::ForChunks(clip.frameCount, Parallel::ThreadCount(threadCount),
+        [&](size_t begin, size_t end, unsigned int)
+        {
+            std::vector<Affine> world(clip.jointCount);
+            Affine              local, skin;
+
+            for (size_t frame = begin; frame < end; frame++)
+            {
+                float* matrices = &palette.matrices[frame * clip.jointCount * MATRIX_FLOATS];
+
+                for (uint32_t joint : order)
+                {
+                    ToAffine(clip.At((uint32_t)frame, joint), local);
+
+                    if (parentOf[joint] >= 0) { Compose(world[parentOf[joint]], local, world[joint]); }
+                    else                      { world[joint] = local; }
+
+                    if (joint < inverseBind.size()) { Compose(world[joint], inverseBind[joint], skin); }
+                    else                            { skin = world[joint]; }
+
+                    float* matrix = matrices + (size_t)joint * MATRIX_FLOATS;
+                    for (int row = 0; row < 3; row++)
+                    {
+                        matrix[row * 4 + 0] = skin.linear[row * 3 + 0];
+                        matrix[row * 4 + 1] = skin.linear[row * 3 + 1];
+                        matrix[row * 4 + 2] = skin.linear[row * 3 + 2];
+                        matrix[row * 4 + 3] = skin.translation[row];
+                    }
+                }
+            }
+        }
+    );
+}
+
+
+uint16_t MatrixPalette::ToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign     = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t       mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFF) { return (uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u)); }   // Infinity and NaN
+
+    const int halfExponent = (int)exponent - 127 + 15;
+    if (halfExponent >= 31) { return (uint16_t)(sign | 0x7C00u); }                          // Too big, infinity
+
+    // Subnormal (or 0), the implicit 1 goes into the mantissa
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10) { return (uint16_t)sign; }
+
+        mantissa |= 0x800000u;
+
+        const uint32_t shift   = (uint32_t)(14 - halfExponent);
+        uint32_t       half    = mantissa >> shift;
+        const uint32_t rest    = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+
+        if (rest > halfway || (rest == halfway && (half & 1u))) { half++; }
+        return (uint16_t)(sign | half);
+    }
+
+    // Rounding up can carry into the exponent, up to infinity, which is still the right result
+    uint32_t       half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) { half++; }
+    return (uint16_t)(sign | half);
+}
+
+
+float MatrixPalette::FromHalf(uint16_t half)
+{
+    const uint32_t sign     = (uint32_t)(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+
+    if (exponent == 0)
+    {
+        float value = std::ldexp((float)mantissa, -24);
+        return sign ? -value : value;
+    }
+
+    uint32_t bits = (exponent == 31) ? (sign | 0x7F800000u | (mantissa << 13))
+                                     : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Skeleton.h"
+
+// @note Skinning matrices of every joint on every frame, what "Bake Matrix Palette" exports instead of the local
+// transforms. The matrix of a joint takes a vertex of the bind pose to where the joint moves it: its object space
+// transform on that frame (every parent multiplied in) times the inverse of its object space transform in the bind pose.
+// A runtime uploads them as they are (a buffer or a texture, frames x joints) and skins with them, no hierarchy walk
+// per instance.
+//
+// Column vectors, p' = M * p. Every matrix is the 3 top rows of the 4x4 one, row major, 12 floats (a float4 per row)
+//
+struct Affine
+{
+    float linear[9];            // Row major
+    float translation[3];
+};
+
+// @note Frame major like AnimationClip, the root at slot 0 and influence i at slot i + 1. The 0 based influence indices
+// SkinWeights::PackInfluences leaves in the vertices read slot jointID + 1, which is the joint ID the MOF files store
+struct PaletteClip
+{
+    float              frameRate  = 30.0f;
+    uint32_t           jointCount = 0;      // Root included
+    uint32_t           frameCount = 0;
+    std::vector<float> matrices;            // [frameCount * jointCount * MATRIX_FLOATS]
+};
+
+namespace MatrixPalette
+{
+    constexpr size_t MATRIX_FLOATS = 12;
+
+    // Maya's order: scale, shear, rotation and then translation
+    void ToAffine(const float* position, const float* rotation, const float* scale, const float* shear, Affine& out);
+    void ToAffine(const Transform& transform, Affine& out);
+    void Compose (const Affine& parent, const Affine& local, Affine& out);
+    void Invert  (const Affine& affine, Affine& out);      // A singular one (0 scale) gives 0
+
+    // Every joint after its parent. [parents] in clip order (the root first, -1 for it), see Skeleton::ClipParents.
+    // Parents out of range or in a loop are taken as the root, [parentOf] gets the ones that are actually used
+    std::vector<uint32_t> HierarchyOrder(const std::vector<int>& parents, std::vector<int>& parentOf);
+
+    // [bindPose] the local transforms of the bind pose in clip order (Skeleton::rootBindPose and every bindPose)
+    void InverseBind(const std::vector<Transform>& bindPose, const std::vector<int>& parents, std::vector<Affine>& inverseBind);
+
+    void Bake(const AnimationClip& clip, const std::vector<int>& parents, const std::vector<Affine>& inverseBind, PaletteClip& palette, unsigned int threadCount = 0);
+
+    // IEEE 754 binary16, rounded to the nearest even. What the half precision palettes store
+    uint16_t ToHalf  (float value);
+    float    FromHalf(uint16_t half);
+}
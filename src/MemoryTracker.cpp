@@ -0,0 +1,179 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t> heapBytes  { 0 };
+    std::atomic<uint64_t> heapPeak   { 0 };
+    std::atomic<uint64_t> allocations{ 0 };
+
+#if defined(__linux__)
+    // "VmRSS:    1234 kB" style lines of /proc/self/status
+    uint64_t ReadStatusKilobytes(const char* key)
+    {
+        FILE* status = std::fopen("/proc/self/status", "r");
+        if (!status) { return 0; }
+
+        char     line[256];
+        size_t   keyLength = std::strlen(key);
+        uint64_t kilobytes = 0;
+
+        while (std::fgets(line, sizeof(line), status))
+        {
+            if (std::strncmp(line, key, keyLength) == 0) { kilobytes = std::strtoull(line + keyLength, nullptr, 10); break; }
+        }
+
+        std::fclose(status);
+        return kilobytes * 1024;
+    }
+#endif
+}
+
+
+bool MemoryTracker::HeapTracking()
+{
+#if defined(MXF_TRACK_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t MemoryTracker::HeapBytes()     { return heapBytes.load(std::memory_order_relaxed);   }
+uint64_t MemoryTracker::HeapPeakBytes() { return heapPeak.load(std::memory_order_relaxed);    }
+uint64_t MemoryTracker::Allocations()   { return allocations.load(std::memory_order_relaxed); }
+
+
+uint64_t MemoryTracker::ResetHeapPeak()
+{
+    return heapPeak.exchange(heapBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+void MemoryTracker::RestoreHeapPeak(uint64_t previousPeak)
+{
+    uint64_t peak = heapPeak.load(std::memory_order_relaxed);
+    while (peak < previousPeak && !heapPeak.compare_exchange_weak(peak, previousPeak, std::memory_order_relaxed)) {}
+}
+
+
+uint64_t MemoryTracker::ProcessBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? (uint64_t)counters.WorkingSetSize : 0;
+#elif defined(__linux__)
+    return ReadStatusKilobytes("VmRSS:");
+#else
+    return 0;
+#endif
+}
+
+
+uint64_t MemoryTracker::ProcessPeakBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? (uint64_t)counters.PeakWorkingSetSize : 0;
+#elif defined(__linux__)
+    return ReadStatusKilobytes("VmHWM:");
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)usage.ru_maxrss;   // Bytes on macOS
+#endif
+}
+
+
+#if defined(MXF_TRACK_ALLOCATIONS)
+
+// ==========================================================================================================
+// Global operator new/delete. Every block carries a header right before the pointer handed out with the
+// pointer malloc returned and the requested size, so the aligned versions can share the same path
+// ==========================================================================================================
+namespace
+{
+    struct BlockHeader
+    {
+        void*  raw;
+        size_t size;
+    };
+
+    constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    void* TrackedAllocate(size_t size, size_t alignment)
+    {
+        alignment = (alignment < DEFAULT_ALIGNMENT) ? DEFAULT_ALIGNMENT : alignment;
+
+        size_t headerSpace = (sizeof(BlockHeader) + alignment - 1) / alignment * alignment;
+        void*  raw         = std::malloc(size + headerSpace + alignment);
+        if (!raw) { return nullptr; }
+
+        uintptr_t user = ((uintptr_t)raw + headerSpace + alignment - 1) / alignment * alignment;
+        reinterpret_cast<BlockHeader*>(user)[-1] = { raw, size };
+
+        uint64_t now  = heapBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = heapPeak.load(std::memory_order_relaxed);
+        while (peak < now && !heapPeak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return reinterpret_cast<void*>(user);
+    }
+
+    void TrackedFree(void* pointer)
+    {
+        if (!pointer) { return; }
+
+        BlockHeader header = static_cast<BlockHeader*>(pointer)[-1];
+        heapBytes.fetch_sub(header.size, std::memory_order_relaxed);
+        std::free(header.raw);
+    }
+
+    void* AllocateOrThrow(size_t size, size_t alignment)
+    {
+        void* pointer = TrackedAllocate(size ? size : 1, alignment);
+        if (!pointer) { throw std::bad_alloc(); }
+        return pointer;
+    }
+}
+
+void* operator new  (size_t size)                                         { return AllocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size)                                         { return AllocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new  (size_t size, const std::nothrow_t&) noexcept         { return TrackedAllocate(size ? size : 1, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept         { return TrackedAllocate(size ? size : 1, DEFAULT_ALIGNMENT); }
+void* operator new  (size_t size, std::align_val_t alignment)             { return AllocateOrThrow(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment)             { return AllocateOrThrow(size, (size_t)alignment); }
+void* operator new  (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size ? size : 1, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size ? size : 1, (size_t)alignment); }
+
+void operator delete  (void* pointer) noexcept                                           { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept                                           { TrackedFree(pointer); }
+void operator delete  (void* pointer, size_t) noexcept                                   { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept                                   { TrackedFree(pointer); }
+void operator delete  (void* pointer, const std::nothrow_t&) noexcept                    { TrackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept                    { TrackedFree(pointer); }
+void operator delete  (void* pointer, std::align_val_t) noexcept                         { TrackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept                         { TrackedFree(pointer); }
+void operator delete  (void* pointer, size_t, std::align_val_t) noexcept                 { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept                 { TrackedFree(pointer); }
+void operator delete  (void* pointer, std::align_val_t, const std::nothrow_t&) noexcept  { TrackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept  { TrackedFree(pointer); }
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// @note Heap and process memory numbers for the export report.
+//
+// Heap tracking replaces the global operator new/delete, so it's only compiled in with MXF_TRACK_ALLOCATIONS (the
+// CMake tools build). The Maya plugin leaves it off: Qt and Maya free some of the objects the plugin allocates with
+// their own allocator, which would choke on the tracking header. Without it the heap functions return 0 and only the
+// process numbers (working set / resident set) are available.
+//
+namespace MemoryTracker
+{
+    bool     HeapTracking();          // Compiled with MXF_TRACK_ALLOCATIONS
+
+    uint64_t HeapBytes();             // Live bytes allocated through operator new
+    uint64_t HeapPeakBytes();         // Highest HeapBytes since the last ResetHeapPeak
+    uint64_t Allocations();           // operator new calls since the start of the process
+
+    // Sets the peak to the current bytes and returns the old peak, RestoreHeapPeak puts the highest of both back.
+    // That way a stage can measure its own peak while the one of the stage around it keeps counting
+    uint64_t ResetHeapPeak();
+    void     RestoreHeapPeak(uint64_t previousPeak);
+
+    uint64_t ProcessBytes();          // Resident set / working set of the whole process, 0 if the platform doesn't say
+    uint64_t ProcessPeakBytes();      // Highest ProcessBytes since the process started
+}
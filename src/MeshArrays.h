@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "Vertex.h"
+
+// @note Flat, Maya independent copy of everything the exporter needs from a mesh. It's filled with a handful of
+// bulk MFnMesh calls and from there on every triangle corner is resolved with plain array indexing.
+// 
+// Face-vertex arrays are indexed by the face-vertex offset, which is the position of the corner inside the
+// polygon connects list (the one returned by MFnMesh::getVertices). Triangle corners store those offsets.
+//
+struct UVSet
+{
+    std::vector<int>   faceVertexUVIDs;       // Index into us/vs, -1 if the face has no UVs assigned
+    std::vector<float> us;
+    std::vector<float> vs;
+};
+
+struct MeshArrays
+{
+    std::vector<int>   triangleCounts;        // Triangles per polygon
+    std::vector<int>   triangleCorners;       // 3 face-vertex offsets per triangle
+
+    std::vector<int>   faceVertexIDs;         // Maya vertex ID of each face-vertex
+    std::vector<int>   faceVertexNormalIDs;   // Index into normals
+    std::vector<float> faceVertexColors;      // RGB per face-vertex, empty if the mesh has no color sets
+
+    std::vector<float> points;                // XYZ per Maya vertex (Object space)
+    std::vector<float> normals;               // XYZ per normal ID  (World space)
+    std::vector<UVSet> uvSets;                // Only the sets with UVs assigned (up to MAX_UV_SETS), the current one first
+
+    size_t CornerCount() const { return triangleCorners.size(); }
+    bool   HasColors()   const { return !faceVertexColors.empty(); }
+    int    UVSetCount()  const { return (int)uvSets.size(); }
+};
@@ -0,0 +1,403 @@
+#include "MeshOptimizer.h"
+
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+
+namespace
+{
+    // Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" constants
+    const int   kCacheSize      = 32;
+    const float kCacheDecay     = 1.5f;
+    const float kLastTriScore   = 0.75f;
+    const float kValenceScale   = 2.0f;
+    const float kValencePower   = 0.5f;
+
+    // Cache size used to find the cluster boundaries of the overdraw pass
+    const unsigned int kOverdrawCacheSize = 16;
+
+    float VertexScore(int cachePosition, int liveTriangles)
+    {
+        // Nothing left to draw with this vertex
+        if (liveTriangles == 0) { return -1.0f; }
+
+        float score = 0.0f;
+
+        if (cachePosition >= 0)
+        {
+            // The vertices of the last triangle get a fixed score, so the next one doesn't just reuse the same edge all the time
+            if (cachePosition < 3) { score = kLastTriScore; }
+            else
+            {
+                float scaler = 1.0f - (float)(cachePosition - 3) / (float)(kCacheSize - 3);
+                score = std::pow(scaler, kCacheDecay);
+            }
+        }
+
+        // Vertices with few triangles left go first, to get rid of lonely triangles 
+        score += kValenceScale * std::pow((float)liveTriangles, -kValencePower);
+
+        return score;
+    }
+
+    // Misses of every triangle when drawn in [begin, end) order starting with an empty FIFO cache
+    void SimulateClusterMisses(const std::vector<int>& indices, size_t begin, size_t end, std::vector<unsigned int>& timestamps, unsigned int& time, std::vector<unsigned char>& triangleMisses)
+    {
+        // Moving the time past the cache size empties the cache
+        time += kOverdrawCacheSize + 1;
+
+        for (size_t t = begin; t < end; t++)
+        {
+            unsigned char misses = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                int vertex = indices[t * 3 + k];
+                if (time - timestamps[vertex] > kOverdrawCacheSize)
+                {
+                    timestamps[vertex] = time++;
+                    misses++;
+                }
+            }
+            triangleMisses[t] = misses;
+        }
+    }
+}
+
+
+MeshOptimizer::CacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+    CacheStatistics statistics;
+    if (indices.empty() || vertexCount == 0) { return statistics; }
+
+    // @note A vertex is in the cache if less than [cacheSize] vertices got transformed after it
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    std::vector<bool>         used      (vertexCount, false);
+    unsigned int              time         = cacheSize + 1;
+    size_t                    misses       = 0;
+    size_t                    usedVertices = 0;
+
+    for (int vertex : indices)
+    {
+        if (time - timestamps[vertex] > cacheSize)
+        {
+            timestamps[vertex] = time++;
+            misses++;
+        }
+
+        if (!used[vertex])
+        {
+            used[vertex] = true;
+            usedVertices++;
+        }
+    }
+
+    statistics.acmr = (float)misses / (float)(indices.size() / 3);
+    statistics.atvr = (float)misses / (float)usedVertices;
+
+    return statistics;
+}
+
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<int>& indices, size_t vertexCount)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) { return; }
+
+    // ==========================================================================================================
+    // Vertex -> Triangles adjacency
+    // ==========================================================================================================
+    std::vector<int> liveTriangles(vertexCount, 0);
+    for (int vertex : indices) { liveTriangles[vertex]++; }
+
+    std::vector<int> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) { adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v]; }
+
+    std::vector<int> adjacency(indices.size());
+    {
+        std::vector<int> filled(vertexCount, 0);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                int vertex = indices[t * 3 + k];
+                adjacency[adjacencyOffsets[vertex] + filled[vertex]++] = (int)t;
+            }
+        }
+    }
+
+    // ==========================================================================================================
+    // Initial scores
+    // ==========================================================================================================
+    std::vector<int>   cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore  (vertexCount);
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool>  emitted      (triangleCount, false);
+
+    for (size_t v = 0; v < vertexCount; v++) { vertexScore[v] = VertexScore(-1, liveTriangles[v]); }
+
+    int   bestTriangle = -1;
+    float bestScore    = -1.0f;
+
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+        if (triangleScore[t] > bestScore)
+        {
+            bestScore    = triangleScore[t];
+            bestTriangle = (int)t;
+        }
+    }
+
+    // ==========================================================================================================
+    // Greedy emission
+    // ==========================================================================================================
+    std::vector<int> output;
+    std::vector<int> cache;
+    std::vector<int> newCache;
+    size_t           scanCursor = 0;
+
+    output  .reserve(indices.size());
+    cache   .reserve(kCacheSize + 3);
+    newCache.reserve(kCacheSize + 3);
+
+    while (output.size() < indices.size())
+    {
+        // Nothing in the cache has triangles left, carry on with the first triangle still pending
+        if (bestTriangle < 0)
+        {
+            while (scanCursor < triangleCount && emitted[scanCursor]) { scanCursor++; }
+            if (scanCursor == triangleCount) { break; }
+
+            bestTriangle = (int)scanCursor;
+        }
+
+        const int* triangle = &indices[(size_t)bestTriangle * 3];
+        emitted[bestTriangle] = true;
+
+        for (int k = 0; k < 3; k++)
+        {
+            int vertex = triangle[k];
+            output.emplace_back(vertex);
+
+            // Remove the triangle from the live list of the vertex
+            int* begin = &adjacency[adjacencyOffsets[vertex]];
+            int* end   = begin + liveTriangles[vertex];
+            int* found = std::find(begin, end, bestTriangle);
+            std::swap(*found, *(end - 1));
+            liveTriangles[vertex]--;
+        }
+
+        // The triangle vertices go to the front of the LRU cache
+        newCache.assign(triangle, triangle + 3);
+        for (int vertex : cache)
+        {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) { newCache.emplace_back(vertex); }
+        }
+
+        // Update the scores of everything that moved, including the vertices that fell out of the cache
+        for (size_t position = 0; position < newCache.size(); position++)
+        {
+            int vertex      = newCache[position];
+            int newPosition = (position < (size_t)kCacheSize) ? (int)position : -1;
+
+            cachePosition[vertex] = newPosition;
+
+            float score = VertexScore(newPosition, liveTriangles[vertex]);
+            float delta = score - vertexScore[vertex];
+            vertexScore[vertex] = score;
+
+            const int* triangles = &adjacency[adjacencyOffsets[vertex]];
+            for (int l = 0; l < liveTriangles[vertex]; l++) { triangleScore[triangles[l]] += delta; }
+        }
+
+        if (newCache.size() > (size_t)kCacheSize) { newCache.resize(kCacheSize); }
+        std::swap(cache, newCache);
+
+        // Next triangle, the best one around the cache
+        bestTriangle = -1;
+        bestScore    = -1.0f;
+
+        for (int vertex : cache)
+        {
+            const int* triangles = &adjacency[adjacencyOffsets[vertex]];
+            for (int l = 0; l < liveTriangles[vertex]; l++)
+            {
+                int t = triangles[l];
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore    = triangleScore[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<int>& indices, size_t vertexCount, const float* positions, size_t positionStride, float threshold)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0 || positions == nullptr) { return; }
+
+    auto position = [positions, positionStride](int vertex) 
+    { 
+        return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + positionStride * vertex); 
+    };
+
+    // ==========================================================================================================
+    // Hard boundaries, the cache gets fully flushed (every vertex of the triangle is a miss)
+    // ==========================================================================================================
+    std::vector<unsigned int>  timestamps(vertexCount, 0);
+    std::vector<unsigned char> triangleMisses(triangleCount, 0);
+    unsigned int               time = 0;
+
+    SimulateClusterMisses(indices, 0, triangleCount, timestamps, time, triangleMisses);
+
+    std::vector<size_t> hardBoundaries;
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        if (t == 0 || triangleMisses[t] == 3) { hardBoundaries.emplace_back(t); }
+    }
+    hardBoundaries.emplace_back(triangleCount);
+
+    // ==========================================================================================================
+    // Soft boundaries, split a cluster as soon as the ACMR of the part drawn so far is good enough
+    // ==========================================================================================================
+    std::vector<size_t> clusters;
+
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+    {
+        size_t begin = hardBoundaries[h];
+        size_t end   = hardBoundaries[h + 1];
+
+        SimulateClusterMisses(indices, begin, end, timestamps, time, triangleMisses);
+
+        size_t clusterMisses = 0;
+        for (size_t t = begin; t < end; t++) { clusterMisses += triangleMisses[t]; }
+
+        float acmrThreshold = (float)clusterMisses / (float)(end - begin) * threshold;
+
+        // Running simulation restarted at every split
+        time += kOverdrawCacheSize + 1;
+
+        size_t runningMisses    = 0;
+        size_t runningTriangles = 0;
+
+        clusters.emplace_back(begin);
+
+        for (size_t t = begin; t < end; t++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                int vertex = indices[t * 3 + k];
+                if (time - timestamps[vertex] > kOverdrawCacheSize)
+                {
+                    timestamps[vertex] = time++;
+                    runningMisses++;
+                }
+            }
+            runningTriangles++;
+
+            if (t + 1 < end && (float)runningMisses / (float)runningTriangles <= acmrThreshold)
+            {
+                clusters.emplace_back(t + 1);
+                time            += kOverdrawCacheSize + 1;
+                runningMisses    = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+    clusters.emplace_back(triangleCount);
+
+    // ==========================================================================================================
+    // Sort the clusters, the ones facing away from the mesh center go first
+    // ==========================================================================================================
+    double meshCentroid[3] = { 0.0, 0.0, 0.0 };
+    double meshArea        = 0.0;
+
+    size_t             clusterCount = clusters.size() - 1;
+    std::vector<float> sortKeys(clusterCount);
+    std::vector<float> clusterCentroids(clusterCount * 3);
+    std::vector<float> clusterNormals  (clusterCount * 3);
+
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        double centroid[3] = { 0.0, 0.0, 0.0 };
+        double normal  [3] = { 0.0, 0.0, 0.0 };
+        double area        = 0.0;
+
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+        {
+            const float* a = position(indices[t * 3 + 0]);
+            const float* b = position(indices[t * 3 + 1]);
+            const float* d = position(indices[t * 3 + 2]);
+
+            double ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            double ad[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+
+            // Area weighted normal
+            double n[3] = { ab[1] * ad[2] - ab[2] * ad[1], ab[2] * ad[0] - ab[0] * ad[2], ab[0] * ad[1] - ab[1] * ad[0] };
+            double triangleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (int i = 0; i < 3; i++)
+            {
+                centroid[i] += (a[i] + b[i] + d[i]) / 3.0 * triangleArea;
+                normal  [i] += n[i];
+            }
+            area += triangleArea;
+        }
+
+        for (int i = 0; i < 3; i++)
+        {
+            meshCentroid[i] += centroid[i];
+            clusterCentroids[c * 3 + i] = (float)(area > 0.0 ? centroid[i] / area : 0.0);
+        }
+        meshArea += area;
+
+        double normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int i = 0; i < 3; i++) { clusterNormals[c * 3 + i] = (float)(normalLength > 0.0 ? normal[i] / normalLength : 0.0); }
+    }
+
+    for (int i = 0; i < 3; i++) { meshCentroid[i] = (meshArea > 0.0) ? meshCentroid[i] / meshArea : 0.0; }
+
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        float key = 0.0f;
+        for (int i = 0; i < 3; i++) { key += (clusterCentroids[c * 3 + i] - (float)meshCentroid[i]) * clusterNormals[c * 3 + i]; }
+        sortKeys[c] = key;
+    }
+
+    std::vector<size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<int> output;
+    output.reserve(indices.size());
+
+    for (size_t c : order)
+    {
+        output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+
+    indices.swap(output);
+}
+
+size_t MeshOptimizer::RemapVertexFetch(std::vector<int>& indices, size_t vertexCount, std::vector<int>& remap)
+{
+    remap.assign(vertexCount, -1);
+
+    int nextVertex = 0;
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        int& index = indices[i];
+        if (remap[index] < 0) { remap[index] = nextVertex++; }
+
+        index = remap[index];
+    }
+
+    return (size_t)nextVertex;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// @note GPU friendly triangle ordering for the index buffer, runs between welding and writing the file.
+// 1. OptimizeVertexCache reorders the triangles so the vertices get reused while they're still in the post transform cache (Forsyth)
+// 2. OptimizeOverdraw splits that order in clusters that don't hurt the cache much and sorts them outside in, so the
+//    triangles that are more likely to be in front get drawn first (Sander et al. "Fast triangle reordering", Tipsify)
+// 3. OptimizeVertexFetch renumbers the vertices in the order the new index buffer uses them, so the vertex buffer is read front to back
+//
+namespace MeshOptimizer
+{
+    struct CacheStatistics
+    {
+        float acmr = 0.0f;  // Average cache miss ratio,  transformed vertices per triangle (0.5 is the best a regular grid can get, 3 the worst)
+        float atvr = 0.0f;  // Average transform to vertex ratio, transformed vertices per vertex (1 is the best)
+    };
+
+    // FIFO cache simulation
+    CacheStatistics AnalyzeVertexCache(const std::vector<int>& indices, size_t vertexCount, unsigned int cacheSize = 16);
+
+    void OptimizeVertexCache(std::vector<int>& indices, size_t vertexCount);
+
+    // positions      -> first float of the position of vertex 0
+    // positionStride -> bytes between the positions of two consecutive vertices
+    // threshold      -> how much the ACMR of a cluster is allowed to get worse to split it further (1.05 = 5%)
+    void OptimizeOverdraw(std::vector<int>& indices, size_t vertexCount, const float* positions, size_t positionStride, float threshold = 1.05f);
+
+    // Rewrites the indices in first use order and fills remap[oldVertex] = newVertex (-1 for vertices no triangle uses)
+    // Returns the amount of vertices that are still referenced
+    size_t RemapVertexFetch(std::vector<int>& indices, size_t vertexCount, std::vector<int>& remap);
+
+    // @note Works on whole vertices so it doesn't care whether they get written with the static or the skinned layout
+    template<typename T>
+    void OptimizeVertexFetch(std::vector<int>& indices, std::vector<T>& vertices)
+    {
+        std::vector<int> remap;
+        size_t usedVertices = RemapVertexFetch(indices, vertices.size(), remap);
+
+        std::vector<T> reordered(usedVertices);
+        for (size_t v = 0; v < vertices.size(); v++)
+        {
+            if (remap[v] >= 0) { reordered[remap[v]] = std::move(vertices[v]); }
+        }
+
+        vertices.swap(reordered);
+    }
+}
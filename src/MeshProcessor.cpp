@@ -0,0 +1,134 @@
+#include "MeshProcessor.h"
+
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+#include "Welder.h"
+#include "ExportReport.h"
+
+
+void MeshProcessor::Process(const MeshArrays& meshArrays, SkinInfluences skin, const MeshExportSettings& settings, MeshData& mesh, MeshProcessReport& report)
+{
+    bool skinned = !skin.Empty();
+
+    report         = MeshProcessReport{};
+    report.corners = meshArrays.CornerCount();
+
+    // ==========================================================================================================
+    // Weld the triangle corners and create the unique vertices
+    // ==========================================================================================================
+    {
+        auto                      weldStart = std::chrono::high_resolution_clock::now();
+        ExportReport::ScopedTimer weldTimer("weld");
+
+        std::vector<int> uniqueCorners;
+        report.duplicated = Welder::WeldCorners(meshArrays, skinned, settings.deduplicate, WeldSettings{}, mesh.indices, uniqueCorners, settings.threadCount);
+
+        mesh.vertices.resize(uniqueCorners.size());
+        for (size_t vIdx = 0; vIdx < uniqueCorners.size(); vIdx++)
+        {
+            BuildVertex(meshArrays, uniqueCorners[vIdx], skinned, mesh.vertices[vIdx]);
+        }
+
+        report.weldSeconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - weldStart).count();
+    }
+
+    // ==========================================================================================================
+    // Influence IDs and their respective weights
+    // ==========================================================================================================   
+
+    // @note Every vertex carries the vertex ID it was generated from, so the table is kept as it is and the writers
+    // look the influences up. Only the highest joint the vertices use is needed here, for the compact layout
+    auto weightsStart = std::chrono::high_resolution_clock::now();
+    int  highestJoint = 0;
+
+    if (skinned)
+    {
+        ExportReport::ScopedTimer weightsTimer("weights");
+
+        const int maxInfluences = skin.maxInfluences;
+
+        for (const Vertex& vertex : mesh.vertices)
+        {
+            const int* jointIDs = &skin.jointIDs[(size_t)vertex.vertexID * maxInfluences];
+
+            for (int i = 0; i < maxInfluences; i++) { highestJoint = std::max(highestJoint, jointIDs[i] + 1); }
+        }
+    }
+
+    mesh.skin             = std::move(skin);
+    report.weightsSeconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - weightsStart).count();
+
+    // ==========================================================================================================
+    // Reorder the triangles for the post transform cache and overdraw, then the vertices for fetching
+    // ==========================================================================================================
+    // @note Nothing to reorder on an empty mesh, and the overdraw pass reads the positions from mesh.vertices[0]
+    if (settings.optimizeIndices && !mesh.vertices.empty() && !mesh.indices.empty())
+    {
+        auto                      optimizeStart = std::chrono::high_resolution_clock::now();
+        ExportReport::ScopedTimer optimizeTimer("optimize");
+
+        report.cacheBefore = MeshOptimizer::AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+        MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+        MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices.size(), mesh.vertices[0].position, sizeof(Vertex));
+
+        report.cacheAfter = MeshOptimizer::AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+        // The triangles don't come in the welding order anymore, put the vertices back in the order they get fetched
+        MeshOptimizer::OptimizeVertexFetch(mesh.indices, mesh.vertices);
+
+        report.optimized       = true;
+        report.optimizeSeconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - optimizeStart).count();
+    }
+
+    // ==========================================================================================================
+    // Vertex format, only the channels that carry data get written
+    // ==========================================================================================================
+    uint32_t     attributeMask = VertexFormat::AttributeMask(meshArrays.HasColors(), meshArrays.UVSetCount(), skinned);
+    VertexLayout layout        = settings.vertexLayout;
+
+    if (layout == VertexLayout::Compact && skinned && highestJoint > VertexQuantizer::MAX_COMPACT_JOINT)
+    {
+        layout                 = VertexLayout::Float;
+        report.compactFallback = true;
+    }
+
+    mesh.format = VertexFormat::Build(attributeMask, layout, mesh.skin.maxInfluences);
+
+    ExportReport::SetOnActive("corners",    report.corners);
+    ExportReport::SetOnActive("triangles",  report.corners / 3);
+    ExportReport::SetOnActive("vertices",   mesh.vertices.size());
+    ExportReport::SetOnActive("duplicated", report.duplicated);
+    ExportReport::SetOnActive("uv_sets",    (uint64_t)meshArrays.UVSetCount());
+    ExportReport::SetOnActive("stride",     mesh.format.stride);
+}
+
+
+void MeshProcessor::BuildVertex(const MeshArrays& meshArrays, size_t corner, bool skinned, Vertex& vert)
+{
+    int faceVertex     = meshArrays.triangleCorners[corner];
+    int globalVertexId = meshArrays.faceVertexIDs[faceVertex];
+    int normalId       = meshArrays.faceVertexNormalIDs[faceVertex];
+
+    vert = Vertex{};
+
+    for (int i = 0; i < 3; i++)
+    {
+        vert.position[i] = meshArrays.points [globalVertexId * 3 + i];
+        vert.normal  [i] = meshArrays.normals[normalId       * 3 + i];
+        vert.color   [i] = meshArrays.HasColors() ? meshArrays.faceVertexColors[faceVertex * 3 + i] : 1.0f;
+    }
+
+    for (int set = 0; set < meshArrays.UVSetCount(); set++)
+    {
+        const UVSet& uvSet = meshArrays.uvSets[set];
+        int          uvId  = uvSet.faceVertexUVIDs[faceVertex];
+
+        vert.uv[set][0] = (uvId >= 0) ? uvSet.us[uvId] : 0.0f;
+        vert.uv[set][1] = (uvId >= 0) ? uvSet.vs[uvId] : 0.0f;
+    }
+
+    vert.vertexID = skinned ? globalVertexId : -1;
+}
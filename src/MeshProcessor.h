@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Vertex.h"
+#include "MeshArrays.h"
+#include "SkinWeights.h"
+#include "ExportSettings.h"
+#include "VertexFormat.h"
+#include "MeshOptimizer.h"
+
+// @note Everything between reading the scene and writing the MOF, without touching Maya:
+// weld the triangle corners, build the unique vertices, optimise the index buffer and pick the vertex format.
+// The influences stay in the per Maya vertex table they came in, the vertices point into it with their vertexID.
+//
+struct MeshData
+{
+    std::vector<Vertex>      vertices;
+    std::vector<int>         indices;
+    SkinInfluences           skin;       // Indexed by Vertex::vertexID, empty for static meshes
+    VertexFormat::Descriptor format;
+
+    bool                  Skinned()    const { return format.HasAttribute(VertexFormat::ATTRIBUTE_SKIN); }
+    const SkinInfluences* Influences() const { return Skinned() ? &skin : nullptr; }
+};
+
+struct MeshProcessReport
+{
+    size_t                         corners         = 0;
+    size_t                         duplicated      = 0;
+    float                          weldSeconds     = 0.0f;
+    float                          weightsSeconds  = 0.0f;
+    float                          optimizeSeconds = 0.0f;
+
+    bool                           optimized       = false;
+    MeshOptimizer::CacheStatistics cacheBefore;
+    MeshOptimizer::CacheStatistics cacheAfter;
+
+    bool                           compactFallback = false;   // Too many influences for 8 bit joint IDs, written with the float layout
+};
+
+namespace MeshProcessor
+{
+    // skin -> indexed by the vertex IDs of meshArrays, empty for static meshes. It ends up in mesh.skin, move it in
+    // if it isn't needed afterwards
+    void Process(const MeshArrays& meshArrays, SkinInfluences skin, const MeshExportSettings& settings, MeshData& mesh, MeshProcessReport& report);
+
+    void BuildVertex(const MeshArrays& meshArrays, size_t corner, bool skinned, Vertex& vert);
+}
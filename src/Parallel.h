@@ -0,0 +1,47 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// @note Tiny helper to split [0, count) in contiguous chunks, one per thread. The chunk boundaries only depend on
+// count and threadCount, so anything that writes per chunk results and merges them in chunk order stays deterministic.
+namespace Parallel
+{
+    inline unsigned int ThreadCount(unsigned int requested)
+    {
+        if (requested > 0) { return requested; }
+
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return (hardware > 0) ? hardware : 1;
+    }
+
+    // function(begin, end, chunkIdx)
+    template <typename Function>
+    void ForChunks(size_t count, unsigned int threadCount, Function function)
+    {
+        threadCount = (unsigned int)std::min<size_t>(std::max(threadCount, 1u), std::max<size_t>(count, 1));
+
+        if (threadCount == 1)
+        {
+            function((size_t)0, count, 0u);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+
+        size_t chunkSize = (count + threadCount - 1) / threadCount;
+
+        for (unsigned int chunkIdx = 0; chunkIdx < threadCount; chunkIdx++)
+        {
+            size_t begin = std::min(count, chunkIdx * chunkSize);
+            size_t end   = std::min(count, begin + chunkSize);
+
+            threads.emplace_back(function, begin, end, chunkIdx);
+        }
+
+        for (std::thread& thread : threads) { thread.join(); }
+    }
+}
@@ -0,0 +1,39 @@
+#include "Skeleton.h"
+
+
+void Skeleton::LinkChildren()
+{
+    rootChildren.clear();
+    for (SkeletonJoint& joint : joints) { joint.childrenIDs.clear(); }
+
+    for (size_t j = 0; j < joints.size(); j++)
+    {
+        int parentID = joints[j].parentID;
+
+        if (parentID >= 0 && parentID < (int)joints.size()) { joints[parentID].childrenIDs.emplace_back((int)j); }
+        else                                                { rootChildren.emplace_back((int)j);                 }
+    }
+}
+
+
+std::vector<int> Skeleton::ClipParents() const
+{
+    std::vector<int> parents(joints.size() + 1, 0);
+    parents[0] = -1;
+
+    for (size_t j = 0; j < joints.size(); j++)
+    {
+        int parentID = joints[j].parentID;
+        parents[j + 1] = (parentID >= 0 && parentID < (int)joints.size()) ? parentID + 1 : 0;
+    }
+
+    return parents;
+}
+
+
+void AnimationClip::SetTrack(uint32_t joint, const Transform* track)
+{
+    Transform* slot = transforms.data() + joint;
+
+    for (uint32_t frame = 0; frame < frameCount; frame++, slot += jointCount) { *slot = track[frame]; }
+}
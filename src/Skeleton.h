@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// @note Maya independent skeleton and animation data, what the MOF/MAF writers consume.
+// The Maya side fills it from the skin cluster influences (MAF_Helper), the stand-in scene from its JSON description.
+//
+// @note Floats, what the files store anyway. A clip keeps one per joint and frame, so with doubles a long clip of a big
+// skeleton took twice the memory for precision that got thrown away when writing it
+struct Transform
+{
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };   // Quaternion xyzw
+    float scale   [3] = { 1.0f, 1.0f, 1.0f };
+    float shear   [3] = { 0.0f, 0.0f, 0.0f };
+};
+
+struct SkeletonJoint
+{
+    std::string      name;
+    int              parentID    = -1;   // Index into Skeleton::joints, -1 if the parent is the root
+    int              influenceID = 0;    // Skin influence index, the joint IDs stored in the vertices
+    std::vector<int> childrenIDs;        // Indices into Skeleton::joints
+    Transform        bindPose;           // Local transform at the start of the animation
+};
+
+// @note The root doesn't influence the mesh, it's written first with the ID 0 and every joint goes after it with
+// its influence ID + 1
+struct Skeleton
+{
+    std::string                rootName;
+    std::vector<int>           rootChildren;
+    Transform                  rootBindPose;
+    std::vector<SkeletonJoint> joints;
+
+    // Fills childrenIDs and rootChildren from the parentIDs
+    void LinkChildren();
+
+    // Parent of every clip joint (the root first, -1 for it), the hierarchy AnimationClip and MAF use
+    std::vector<int> ClipParents() const;
+};
+
+// @note Local transforms of every joint for every frame. Frame major and the root first, the same order MAF stores them
+struct AnimationClip
+{
+    float                  frameRate  = 30.0f;
+    uint32_t               jointCount = 0;      // Root included
+    uint32_t               frameCount = 0;
+    std::vector<Transform> transforms;          // [frameCount * jointCount]
+
+    const Transform& At(uint32_t frame, uint32_t joint) const { return transforms[(size_t)frame * jointCount + joint]; }
+    Transform&       At(uint32_t frame, uint32_t joint)       { return transforms[(size_t)frame * jointCount + joint]; }
+
+    // Copies the [frameCount] transforms of one joint, sampled joint by joint, into their frame major slots
+    void SetTrack(uint32_t joint, const Transform* track);
+};
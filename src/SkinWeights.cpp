@@ -0,0 +1,51 @@
+#include "SkinWeights.h"
+
+#include <algorithm>
+
+
+// @note Keeps the [maxInfluences] heaviest non-zero weights of each vertex (ties go to the lowest influence index so the
+// result is deterministic) and renormalises them so they add up to 1 again after dropping the lightest ones.
+void SkinWeights::PackInfluences(const double* weights, unsigned int vertexCount, unsigned int influenceCount, int maxInfluences, SkinInfluences& influences)
+{
+    maxInfluences = std::clamp(maxInfluences, 1, MAX_INFLUENCES);
+
+    influences.maxInfluences = maxInfluences;
+    influences.jointIDs.assign((size_t)vertexCount * maxInfluences, 0);
+    influences.weights .assign((size_t)vertexCount * maxInfluences, 0.0f);
+
+    std::vector<unsigned int> candidates;
+    candidates.reserve(influenceCount);
+
+    for (unsigned int vIdx = 0; vIdx < vertexCount; vIdx++)
+    {
+        const double* vertexWeights = weights + (size_t)vIdx * influenceCount;
+
+        candidates.clear();
+        for (unsigned int InfluenceIdx = 0; InfluenceIdx < influenceCount; InfluenceIdx++)
+        {
+            if (vertexWeights[InfluenceIdx] > 1.0e-6) { candidates.emplace_back(InfluenceIdx); }
+        }
+
+        auto heavier = [vertexWeights](unsigned int a, unsigned int b)
+        {
+            if (vertexWeights[a] != vertexWeights[b]) { return vertexWeights[a] > vertexWeights[b]; }
+            return a < b;
+        };
+
+        size_t kept = std::min(candidates.size(), (size_t)maxInfluences);
+        std::partial_sort(candidates.begin(), candidates.begin() + kept, candidates.end(), heavier);
+
+        double total = 0.0;
+        for (size_t k = 0; k < kept; k++) { total += vertexWeights[candidates[k]]; }
+        if (total <= 0.0) { continue; }
+
+        int*   jointIDs = &influences.jointIDs[(size_t)vIdx * maxInfluences];
+        float* packed   = &influences.weights [(size_t)vIdx * maxInfluences];
+
+        for (size_t k = 0; k < kept; k++)
+        {
+            jointIDs[k] = (int)candidates[k];
+            packed  [k] = (float)(vertexWeights[candidates[k]] / total);
+        }
+    }
+}
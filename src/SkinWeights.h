@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "Vertex.h"
+
+// @note Sparse influence table. Each vertex owns [maxInfluences] consecutive slots sorted by weight (heaviest first),
+// the weights of a vertex add up to 1 and the unused slots have a weight of 0
+struct SkinInfluences
+{
+    int                maxInfluences = 4;
+    std::vector<int>   jointIDs;
+    std::vector<float> weights;
+
+    bool Empty() const { return weights.empty(); }
+};
+
+namespace SkinWeights
+{
+    // weights -> vertex major [vertexCount * influenceCount] matrix, the same one MFnSkinCluster::getWeights returns
+    void PackInfluences(const double* weights, unsigned int vertexCount, unsigned int influenceCount, int maxInfluences, SkinInfluences& influences);
+}
@@ -19,89 +19,77 @@
 // Vtx [11]  0.00000     0.37800     0.378000000     0.12200     0.122000000
 //
 // If I compare the 'Component Editor' table to the data I gather using this function the results are identical.
-// So the plan here is to gather the positions, (No need for the normals, if the positions are the same, the weights should 
-// be applied to that vertex even if the normals arent the same)  it's weights, and the influence name.
-// positions and normals will be used to get a hash to compare witht the deduplicate vertices list.
+// So the plan here is to gather the weights and influence IDs of each vertex and store them at its Maya vertex index, 
+// that way the mesh exporter can pick them straight away using the vertex ID of each triangle corner, no position matching needed.
 //
-// Weights and influence names will be used to generate a joint ID's table and assign the weights or do i Have the influence idx? maybe? 
-// 
-// @note --- Remember that the MAXIMUM INFLUENCES PER VERTEX HAS TO BE 4 AT MAX
-MStatus Skinner::FindMeshWeightsAndInfluences(MDagPath dagPath, std::vector<Vertex>& verticesWithWeightsAndIDs)
+// @note The whole weight matrix is fetched with a single getWeights call over a complete vertex component
+// instead of one call (and one MDoubleArray) per vertex. The matrix is then packed into a sparse table of
+// [maxInfluences] slots per vertex, so a vertex with more influences than slots can't overflow them anymore.
+MStatus Skinner::FindMeshWeightsAndInfluences(MDagPath dagPath, int maxInfluences, SkinInfluences& influences)
 {    
+    ExportReport::ScopedTimer timer("skin");
+    ExportReport::ScopedCount mayaCalls("maya_calls");
+
     MStatus             status = MStatus::kSuccess;
-    MString             info   = "";
 
     MObject             skinCluster = FindSkinCluster(dagPath);
     MFnSkinCluster      skinClusterFn(skinCluster, &status);
-    MDagPathArray       influences;
-    unsigned int        influenceCount = skinClusterFn.influenceObjects(influences);
+    MDagPathArray       influenceObjs;
+    unsigned int        influenceCount = mayaCalls(skinClusterFn.influenceObjects(influenceObjs));
     
-    if (influenceCount == 0) 
-    {
-        status = MS::kFailure;
-        Print("No influence objects found.", status);
-        return status;
-    }
+    // @note Static meshes end here, no need to say it every time
+    if (influenceCount == 0) { return MS::kFailure; }
     
-    unsigned int nGeoms = skinClusterFn.numOutputConnections();      
+    unsigned int nGeoms = mayaCalls(skinClusterFn.numOutputConnections());      
 
     for (unsigned int geometryIdx = 0; geometryIdx < nGeoms; ++geometryIdx) 
     {
-        unsigned int index = skinClusterFn.indexForOutputConnection(geometryIdx, &status);
+        unsigned int index = mayaCalls(skinClusterFn.indexForOutputConnection(geometryIdx, &status));
         if (status == MStatus::kFailure) { MGlobal::displayError("Failed to get geometry index"); }
 
 
         MDagPath skinPath;
-        status = skinClusterFn.getPathAtIndex(index, skinPath);
+        status = mayaCalls(skinClusterFn.getPathAtIndex(index, skinPath));
         
         if (status == MStatus::kFailure) 
         {
             MGlobal::displayError("Error getting geometry path"); 
             return status;
         }
-        
 
-        // iterate through the components of this geometry        
-        MItGeometry geometryIter(skinPath);
+        // @note The skin cluster may drive more than one geometry, only the selected one matters
+        if (skinPath.node() != dagPath.node()) { continue; }
+
+        // A complete component covers every vertex of the geometry in index order
+        MItGeometry  geometryIter(skinPath);
+        unsigned int vertexCount = mayaCalls(geometryIter.count());
+
+        MFnSingleIndexedComponent componentFn;
+        MObject                   allVertices = mayaCalls(componentFn.create(MFn::kMeshVertComponent));
+        mayaCalls(componentFn.setCompleteData(vertexCount));
+
+        // Vertex major, [vertexCount * infCount] weights
+        MDoubleArray wts;
+        unsigned int infCount = 0;
+        status = mayaCalls(skinClusterFn.getWeights(skinPath, allVertices, wts, infCount));
 
-        for (; !geometryIter.isDone(); geometryIter.next()) 
+        if (status == MStatus::kFailure) 
+        { 
+            MGlobal::displayError("Failed to retrieve the weights"); 
+            return status;
+        }
+
+        if (0 == infCount || wts.length() != vertexCount * infCount) 
         {
-            Vertex vert{};
-            vert.position = geometryIter.position(MSpace::kObject);            
-            MObject comp  = geometryIter.currentItem(&status);
-            if (status == MStatus::kFailure) { MGlobal::displayError("Failed to get component"); }        
-         
-            // Get the weights for this vertex (one per influence object)             
-            MDoubleArray wts;
-            unsigned int infCount;
-            status = skinClusterFn.getWeights(skinPath, comp, wts, infCount);
-                      
-            if (status == MStatus::kFailure) { MGlobal::displayError("Failed to retrieve the weights"); }        
-
-            if (0 == infCount) 
-            {
-                status = MS::kFailure;                
-                info   = "Error: 0 influence objects atached to vertex number ["; info += geometryIter.index(); info += "]";
-                MGlobal::displayError(info);
-            }
-                    
-            // IDs and weights assignations
-            int internalDWeightIdx = 0;
-            for (unsigned int InfluenceIdx = 0; InfluenceIdx < infCount; InfluenceIdx++)
-            {              
-                if (wts[InfluenceIdx] > 1.0e-6)
-                {
-                    vert.jointID[internalDWeightIdx] = InfluenceIdx;
-                    vert.weight [internalDWeightIdx] = wts[InfluenceIdx];
-                    internalDWeightIdx++;
-                }
-
-                // info = "Value of ["; info += InfluenceIdx; info += "] = ["; info += wts[InfluenceIdx]; info += "]";
-                // MGlobal::displayInfo(info);
-            }
-
-            verticesWithWeightsAndIDs.emplace_back(vert);
+            status = MS::kFailure;
+            MGlobal::displayError("Error: The weight matrix doesn't match the geometry vertex count");
+            return status;
         }
+
+        std::vector<double> weightMatrix(wts.length());
+        wts.get(weightMatrix.data());
+
+        SkinWeights::PackInfluences(weightMatrix.data(), vertexCount, infCount, maxInfluences, influences);
     }
    
     return status;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 
 #include <maya/MItDependencyGraph.h>
 #include <maya/MDagPath.h>
@@ -15,14 +16,17 @@
 #include <maya/MItDependencyNodes.h>
 #include <maya/MFnWeightGeometryFilter.h>
 #include <maya/MFnSet.h>
+#include <maya/MFnSingleIndexedComponent.h>
+#include <maya/MDoubleArray.h>
 
 #include "Utilities.h"
 #include "Types.h"
+#include "SkinWeights.h"
 
 // Some of the code has been taken from https://help.autodesk.com/view/MAYAUL/2024/ENU/?guid=MAYA_API_REF_cpp_ref_skin_cluster_weights_2skin_cluster_weights_8cpp_example_html
 namespace Skinner
 {
-    MStatus FindMeshWeightsAndInfluences(MDagPath dagPath, std::vector<Vertex>& verticesWithWeightsAndIDs);
+    MStatus FindMeshWeightsAndInfluences(MDagPath dagPath, int maxInfluences, SkinInfluences& influences);
    
     bool    IsSkinClusterIncluded(MObjectArray& skinClusterArray, MObject& node);
     MObject FindSkinCluster(MDagPath& dagPath);       
@@ -0,0 +1,31 @@
+#include "Triangulator.h"
+
+#include <algorithm>
+
+
+void Triangulator::Fan(const std::vector<int>& polygonCounts, std::vector<int>& triangleCounts, std::vector<int>& triangleCorners)
+{
+    size_t triangles = 0;
+    for (int corners : polygonCounts) { triangles += (size_t)std::max(corners - 2, 0); }
+
+    triangleCounts.resize(polygonCounts.size());
+    triangleCorners.resize(triangles * 3);
+
+    int* out       = triangleCorners.data();
+    int  faceStart = 0;
+
+    for (size_t p = 0; p < polygonCounts.size(); p++)
+    {
+        int corners       = polygonCounts[p];
+        triangleCounts[p] = std::max(corners - 2, 0);
+
+        for (int t = 0; t < corners - 2; t++)
+        {
+            *out++ = faceStart;
+            *out++ = faceStart + t + 1;
+            *out++ = faceStart + t + 2;
+        }
+
+        faceStart += std::max(corners, 0);
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+// @note Triangulation for the sources that don't hand out triangles already (Maya does, through getTriangleOffsets).
+// The output matches getTriangleOffsets: triangles per polygon and 3 face-vertex offsets per triangle.
+//
+namespace Triangulator
+{
+    // polygonCounts -> corners per polygon, polygons are laid out one after the other in the face-vertex list.
+    // Fan from the first corner, fine for convex polygons. Polygons with less than 3 corners get no triangles
+    void Fan(const std::vector<int>& polygonCounts, std::vector<int>& triangleCounts, std::vector<int>& triangleCorners);
+}
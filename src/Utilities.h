@@ -5,6 +5,10 @@
 
 #include <maya/MTime.h>
 
+#include <string>
+
+#include "ExportReport.h"
+
 template<typename T>
 inline void Print(T t)
 {
@@ -120,4 +124,23 @@ inline double GetFrameRate()
 	}
 
 	return frameRate;
-}
\ No newline at end of file
+}
+
+
+// @note Warns about the joint transform reads that failed (counted instead of printed per joint) and saves the report
+// as [path].report.json when it was asked for
+inline void FinishExportReport(const ExportReport& report, const std::string& path, bool writeReport)
+{
+	uint64_t failures = report.GetCount("transform_read_failures");
+	if (failures > 0)
+	{
+		MString warning = "Failed to read [ "; warning += (int)failures; warning += " ] joint transform values, those joints may have been written with default values";
+		MGlobal::displayWarning(warning);
+	}
+
+	if (!writeReport) { return; }
+
+	std::string reportPath = path + ".report.json";
+	if (report.SaveJson(reportPath)) { MGlobal::displayInfo(MString("Export report written to ") + MString(reportPath.c_str())); }
+	else                             { MGlobal::displayWarning(MString("Couldn't write ") + MString(reportPath.c_str()));    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// @note Upper bound of influences a vertex can store, the exported amount is selected through MeshExportSettings::maxInfluences
+constexpr int MAX_INFLUENCES = 8;
+
+// @note UV sets exported per vertex, the current UV set always goes first
+constexpr int MAX_UV_SETS = 4;
+
+// @note Welding happens on the quantized keys built by the Welder, so this is plain data now
+// @note The joint IDs and weights aren't stored here, vertexID indexes the SkinInfluences table of the mesh (MeshData::skin).
+// Every corner of a Maya vertex has the same influences, so copying them into each unique vertex just took
+// MAX_INFLUENCES * 8 bytes per vertex, static meshes included
+struct Vertex 
+{
+    float        position[3];
+    float        color   [3];
+    float        normal  [3];
+    float        uv[MAX_UV_SETS][2];
+    int          vertexID;                 // Maya vertex index the corner came from. Only set for skinned meshes (-1 otherwise) so distinct vertices
+                                           // sharing a position never get welded together, as their weights may differ
+};
@@ -0,0 +1,186 @@
+#include "VertexFormat.h"
+#include "Parallel.h"
+
+#include <cstring>
+#include <algorithm>
+
+
+size_t VertexFormat::ComponentSize(ComponentFormat format)
+{
+    switch (format)
+    {
+        case ComponentFormat::Float32: return 4;
+        case ComponentFormat::Int32:   return 4;
+        case ComponentFormat::Unorm16: return 2;
+        case ComponentFormat::Snorm16: return 2;
+        case ComponentFormat::Unorm8:  return 1;
+        case ComponentFormat::Uint8:   return 1;
+    }
+    return 0;
+}
+
+
+namespace
+{
+    void AddStream(VertexFormat::Descriptor& descriptor, VertexFormat::Semantic semantic, VertexFormat::ComponentFormat format, int components)
+    {
+        descriptor.streams.push_back({ semantic, format, (uint8_t)components, (uint8_t)descriptor.stride });
+        descriptor.stride += (uint32_t)(VertexFormat::ComponentSize(format) * components);
+    }
+}
+
+
+bool VertexFormat::Descriptor::IsLegacy() const
+{
+    uint32_t legacyMask = ATTRIBUTE_POSITION | ATTRIBUTE_NORMAL | ATTRIBUTE_COLOR | ATTRIBUTE_UV0;
+
+    return layout == VertexLayout::Float && (attributeMask & ~ATTRIBUTE_SKIN) == legacyMask;
+}
+
+
+uint32_t VertexFormat::AttributeMask(bool hasColors, int uvSetCount, bool skinned)
+{
+    uint32_t mask = ATTRIBUTE_POSITION | ATTRIBUTE_NORMAL;
+
+    if (hasColors) { mask |= ATTRIBUTE_COLOR; }
+    if (skinned)   { mask |= ATTRIBUTE_SKIN;  }
+
+    for (int set = 0; set < std::min(uvSetCount, MAX_UV_SETS); set++) { mask |= (uint32_t)ATTRIBUTE_UV0 << set; }
+
+    return mask;
+}
+
+
+VertexFormat::Descriptor VertexFormat::Build(uint32_t attributeMask, VertexLayout layout, int maxInfluences)
+{
+    Descriptor descriptor;
+    descriptor.layout        = layout;
+    descriptor.attributeMask = attributeMask;
+    descriptor.maxInfluences = (attributeMask & ATTRIBUTE_SKIN) ? maxInfluences : 0;
+
+    bool compact = (layout == VertexLayout::Compact);
+
+    if (attributeMask & ATTRIBUTE_POSITION) { compact ? AddStream(descriptor, Semantic::Position, ComponentFormat::Unorm16, 4) : AddStream(descriptor, Semantic::Position, ComponentFormat::Float32, 3); }
+    if (attributeMask & ATTRIBUTE_COLOR)    { compact ? AddStream(descriptor, Semantic::Color,    ComponentFormat::Unorm8,  4) : AddStream(descriptor, Semantic::Color,    ComponentFormat::Float32, 3); }
+    if (attributeMask & ATTRIBUTE_NORMAL)   { compact ? AddStream(descriptor, Semantic::Normal,   ComponentFormat::Snorm16, 2) : AddStream(descriptor, Semantic::Normal,   ComponentFormat::Float32, 3); }
+
+    for (int set = 0; set < MAX_UV_SETS; set++)
+    {
+        if (!(attributeMask & ((uint32_t)ATTRIBUTE_UV0 << set))) { continue; }
+
+        Semantic semantic = (Semantic)((int)Semantic::UV0 + set);
+        compact ? AddStream(descriptor, semantic, ComponentFormat::Unorm16, 2) : AddStream(descriptor, semantic, ComponentFormat::Float32, 2);
+
+        descriptor.uvSetCount = set + 1;
+    }
+
+    if (attributeMask & ATTRIBUTE_SKIN)
+    {
+        compact ? AddStream(descriptor, Semantic::JointIDs, ComponentFormat::Uint8,  maxInfluences) : AddStream(descriptor, Semantic::JointIDs, ComponentFormat::Int32,   maxInfluences);
+        compact ? AddStream(descriptor, Semantic::Weights,  ComponentFormat::Unorm8, maxInfluences) : AddStream(descriptor, Semantic::Weights,  ComponentFormat::Float32, maxInfluences);
+    }
+
+    return descriptor;
+}
+
+
+void VertexFormat::PackVertex(const Vertex& vertex, const SkinInfluences* skin, const Descriptor& descriptor, const VertexQuantizer::QuantizationBounds& bounds, unsigned char* output)
+{
+    using namespace VertexQuantizer;
+
+    size_t skinSlot = (skin && vertex.vertexID >= 0) ? (size_t)vertex.vertexID * skin->maxInfluences : 0;
+
+    for (const Stream& stream : descriptor.streams)
+    {
+        unsigned char* out   = output + stream.offset;
+        bool           fp32  = (stream.format == ComponentFormat::Float32 || stream.format == ComponentFormat::Int32);
+
+        switch (stream.semantic)
+        {
+            case Semantic::Position:
+            {
+                if (fp32) { std::memcpy(out, vertex.position, sizeof(float) * 3); break; }
+
+                uint16_t position[4];
+                for (int i = 0; i < 3; i++) { position[i] = QuantizeUnorm16(vertex.position[i], bounds.positionMin[i], bounds.positionMax[i]); }
+                position[3] = 0;
+
+                std::memcpy(out, position, sizeof(position));
+                break;
+            }
+
+            case Semantic::Color:
+            {
+                if (fp32) { std::memcpy(out, vertex.color, sizeof(float) * 3); break; }
+
+                for (int i = 0; i < 3; i++) { out[i] = QuantizeUnorm8(vertex.color[i]); }
+                out[3] = 255;
+                break;
+            }
+
+            case Semantic::Normal:
+            {
+                if (fp32) { std::memcpy(out, vertex.normal, sizeof(float) * 3); break; }
+
+                int16_t normal[2];
+                EncodeOctahedral(vertex.normal, normal);
+
+                std::memcpy(out, normal, sizeof(normal));
+                break;
+            }
+
+            case Semantic::JointIDs:
+            {
+                // Need to add 1 because, the Root is the index 0 of the skeleton joints...
+                for (int i = 0; i < descriptor.maxInfluences; i++)
+                {
+                    int jointID = skin->jointIDs[skinSlot + i] + 1;
+
+                    if (fp32) { std::memcpy(out + i * sizeof(int), &jointID, sizeof(int)); }
+                    else      { out[i] = (uint8_t)std::clamp(jointID, 0, MAX_COMPACT_JOINT); }
+                }
+                break;
+            }
+
+            case Semantic::Weights:
+            {
+                const float* weights = &skin->weights[skinSlot];
+
+                if (fp32) { std::memcpy(out, weights, sizeof(float) * descriptor.maxInfluences); break; }
+
+                QuantizeWeights(weights, descriptor.maxInfluences, out);
+                break;
+            }
+
+            default: // UV sets
+            {
+                int set = (int)stream.semantic - (int)Semantic::UV0;
+
+                if (fp32) { std::memcpy(out, vertex.uv[set], sizeof(float) * 2); break; }
+
+                uint16_t uv[2];
+                uv[0] = QuantizeUnorm16(vertex.uv[set][0], bounds.uvMin[set][0], bounds.uvMax[set][0]);
+                uv[1] = QuantizeUnorm16(vertex.uv[set][1], bounds.uvMin[set][1], bounds.uvMax[set][1]);
+
+                std::memcpy(out, uv, sizeof(uv));
+                break;
+            }
+        }
+    }
+}
+
+
+void VertexFormat::PackVertices(const std::vector<Vertex>& vertices, const SkinInfluences* skin, const Descriptor& descriptor, const VertexQuantizer::QuantizationBounds& bounds, unsigned char* output, unsigned int threadCount)
+{
+    threadCount = (vertices.size() < PARALLEL_PACK_THRESHOLD) ? 1 : Parallel::ThreadCount(threadCount);
+
+    Parallel::ForChunks(vertices.size(), threadCount,
+        [&](size_t begin, size_t end, unsigned int)
+        {
+            for (size_t v = begin; v < end; v++)
+            {
+                PackVertex(vertices[v], skin, descriptor, bounds, output + v * descriptor.stride);
+            }
+        }
+    );
+}
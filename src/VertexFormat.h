@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Vertex.h"
+#include "SkinWeights.h"
+#include "VertexQuantizer.h"
+
+enum class VertexLayout
+{
+    Float,      // 32 bit floats and ints for everything (44 bytes static, 76/108 skinned with every channel present)
+    Compact,    // Quantized, see VertexQuantizer.h (20 bytes static, 28/36 skinned with every channel present)
+};
+
+// @note Describes which channels a MOF actually stores and where they are inside a vertex.
+// Only the channels that carry data get a stream: no color sets -> no color stream, no UV sets -> no UV stream, etc.
+//
+// Streams always come in this order (the absent ones are just skipped):
+//
+//  semantic    Float layout        Compact layout
+//  Position    Float32 x 3         Unorm16 x 4 (against the bounds, the 4th is padding)
+//  Color       Float32 x 3         Unorm8  x 4 (the 4th is padding, always 255)
+//  Normal      Float32 x 3         Snorm16 x 2 (octahedral)
+//  UV0..UV3    Float32 x 2         Unorm16 x 2 (against the bounds of the set)
+//  JointIDs    Int32   x K         Uint8   x K (+1, the root is the joint 0)
+//  Weights     Float32 x K         Unorm8  x K (adding up to 255)
+//
+// Position, Color, Normal, UV0 (+ JointIDs, Weights) with the float layout is the legacy 11/19/27 float vertex, 
+// those files keep the old header so the old readers still load them.
+//
+namespace VertexFormat
+{
+    enum Attribute : uint32_t
+    {
+        ATTRIBUTE_POSITION = 1 << 0,
+        ATTRIBUTE_NORMAL   = 1 << 1,
+        ATTRIBUTE_COLOR    = 1 << 2,
+        ATTRIBUTE_UV0      = 1 << 3,     // UV set n -> ATTRIBUTE_UV0 << n
+        ATTRIBUTE_SKIN     = 1 << 7,     // Joint IDs and weights
+    };
+
+    enum class Semantic : uint8_t
+    {
+        Position,
+        Color,
+        Normal,
+        UV0,                             // UV set n -> UV0 + n
+        JointIDs = UV0 + MAX_UV_SETS,
+        Weights,
+    };
+
+    enum class ComponentFormat : uint8_t
+    {
+        Float32,
+        Int32,
+        Unorm16,
+        Snorm16,
+        Unorm8,
+        Uint8,
+    };
+
+    // @note Written as is in the header, 4 bytes
+    struct Stream
+    {
+        Semantic        semantic;
+        ComponentFormat format;
+        uint8_t         components;
+        uint8_t         offset;          // Bytes from the start of the vertex
+    };
+
+    static_assert(sizeof(Stream) == 4, "The vertex streams are part of the file format");
+
+    struct Descriptor
+    {
+        VertexLayout        layout        = VertexLayout::Float;
+        uint32_t            attributeMask = 0;
+        int                 maxInfluences = 0;    // 0 without ATTRIBUTE_SKIN
+        int                 uvSetCount    = 0;
+        uint32_t            stride        = 0;    // Bytes
+        std::vector<Stream> streams;
+
+        bool HasAttribute(uint32_t attribute) const { return (attributeMask & attribute) != 0; }
+        
+        // The vertices are exactly the ones of the old 11/19/27 floats format
+        bool IsLegacy() const;
+    };
+
+    size_t     ComponentSize(ComponentFormat format);      // Bytes, 0 for an unknown format
+    uint32_t   AttributeMask(bool hasColors, int uvSetCount, bool skinned);
+    Descriptor Build(uint32_t attributeMask, VertexLayout layout, int maxInfluences);
+
+    // Writes descriptor.stride bytes into output. The bounds are only used by the compact layout, skin (indexed by
+    // Vertex::vertexID) only by the skinned formats
+    void       PackVertex(const Vertex& vertex, const SkinInfluences* skin, const Descriptor& descriptor, const VertexQuantizer::QuantizationBounds& bounds, unsigned char* output);
+
+    // @note Vertex count from which PackVertices splits the work between threads
+    constexpr size_t PARALLEL_PACK_THRESHOLD = 65536;
+
+    // Writes vertices.size() * descriptor.stride bytes into output. Every vertex owns its own slice, so big meshes get
+    // packed in parallel (threadCount 0 = every core)
+    void       PackVertices(const std::vector<Vertex>& vertices, const SkinInfluences* skin, const Descriptor& descriptor, const VertexQuantizer::QuantizationBounds& bounds, unsigned char* output, unsigned int threadCount = 0);
+}
@@ -0,0 +1,121 @@
+#include "VertexQuantizer.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+
+VertexQuantizer::QuantizationBounds VertexQuantizer::ComputeBounds(const std::vector<Vertex>& vertices, int uvSetCount)
+{
+    QuantizationBounds bounds;
+    if (vertices.empty()) { return bounds; }
+
+    for (int i = 0; i < 3; i++) { bounds.positionMin[i] = bounds.positionMax[i] = vertices[0].position[i]; }
+
+    for (int set = 0; set < uvSetCount; set++)
+    {
+        for (int i = 0; i < 2; i++) { bounds.uvMin[set][i] = bounds.uvMax[set][i] = vertices[0].uv[set][i]; }
+    }
+
+    for (const Vertex& vertex : vertices)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            bounds.positionMin[i] = std::min(bounds.positionMin[i], vertex.position[i]);
+            bounds.positionMax[i] = std::max(bounds.positionMax[i], vertex.position[i]);
+        }
+
+        for (int set = 0; set < uvSetCount; set++)
+        {
+            for (int i = 0; i < 2; i++)
+            {
+                bounds.uvMin[set][i] = std::min(bounds.uvMin[set][i], vertex.uv[set][i]);
+                bounds.uvMax[set][i] = std::max(bounds.uvMax[set][i], vertex.uv[set][i]);
+            }
+        }
+    }
+
+    return bounds;
+}
+
+
+uint16_t VertexQuantizer::QuantizeUnorm16(float value, float min, float max)
+{
+    // @note Flat axis (a plane or a single uv island on a line), everything sits on the min
+    float extent = max - min;
+    if (!(extent > 0.0f)) { return 0; }
+
+    float normalized = std::clamp((value - min) / extent, 0.0f, 1.0f);
+    return (uint16_t)std::lround(normalized * 65535.0f);
+}
+
+
+uint8_t VertexQuantizer::QuantizeUnorm8(float value)
+{
+    float normalized = std::clamp(value, 0.0f, 1.0f);
+    return (uint8_t)std::lround(normalized * 255.0f);
+}
+
+
+// @note "A Survey of Efficient Representations for Independent Unit Vectors" (Cigolle et al.)
+// The unit sphere gets projected onto an octahedron and the lower half is folded over the upper one
+void VertexQuantizer::EncodeOctahedral(const float normal[3], int16_t encoded[2])
+{
+    float x = normal[0], y = normal[1], z = normal[2];
+
+    float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (!(l1 > 0.0f)) { encoded[0] = 0; encoded[1] = 0; return; }
+
+    x /= l1; y /= l1; z /= l1;
+
+    if (z < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    encoded[0] = (int16_t)std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f);
+    encoded[1] = (int16_t)std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f);
+}
+
+
+void VertexQuantizer::QuantizeWeights(const float* weights, int count, uint8_t* quantized)
+{
+    float total = 0.0f;
+    for (int i = 0; i < count; i++) { total += std::max(weights[i], 0.0f); }
+
+    if (!(total > 0.0f))
+    {
+        std::memset(quantized, 0, (size_t)count);
+        return;
+    }
+
+    // Floor everything and hand the leftover units to the biggest remainders (the lowest slot wins the ties,
+    // which is the heaviest influence as they come sorted)
+    float remainders[MAX_INFLUENCES];
+    int   assigned = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        float scaled  = std::max(weights[i], 0.0f) / total * 255.0f;
+        float floored = std::floor(scaled);
+
+        quantized [i] = (uint8_t)floored;
+        remainders[i] = scaled - floored;
+        assigned     += quantized[i];
+    }
+
+    for (int left = 255 - assigned; left > 0; left--)
+    {
+        int best = 0;
+        for (int i = 1; i < count; i++)
+        {
+            if (remainders[i] > remainders[best]) { best = i; }
+        }
+
+        quantized [best]++;
+        remainders[best] = -1.0f;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Vertex.h"
+
+// @note Encoders of the compact MOF vertex layout (the stream layout itself lives in VertexFormat.h)
+// Positions and UVs get quantized against the bounds written in the header, so the runtime can rebuild the values:
+// value = min + (q / 65535) * (max - min)
+//
+namespace VertexQuantizer
+{
+    // @note Highest joint ID (already +1) a compact vertex can store
+    constexpr int MAX_COMPACT_JOINT = 255;
+
+    struct QuantizationBounds
+    {
+        float positionMin[3]              = { 0.0f, 0.0f, 0.0f };
+        float positionMax[3]              = { 0.0f, 0.0f, 0.0f };
+        float uvMin      [MAX_UV_SETS][2] = {};
+        float uvMax      [MAX_UV_SETS][2] = {};
+    };
+
+    QuantizationBounds ComputeBounds(const std::vector<Vertex>& vertices, int uvSetCount);
+
+    uint16_t QuantizeUnorm16 (float value, float min, float max);
+    uint8_t  QuantizeUnorm8  (float value);
+    void     EncodeOctahedral(const float normal[3], int16_t encoded[2]);
+
+    // Largest remainder rounding, so the quantized weights always add up to 255 (unless all of them are 0)
+    void     QuantizeWeights (const float* weights, int count, uint8_t* quantized);
+}
@@ -0,0 +1,347 @@
+#include "Welder.h"
+#include "Parallel.h"
+
+#include <cmath>
+#include <thread>
+#include <limits>
+#include <algorithm>
+
+
+WeldTable::WeldTable(size_t expectedKeys)
+{
+    // Keep the load factor under 50%
+    size_t capacity = 16;
+    while (capacity < expectedKeys * 2) { capacity <<= 1; }
+
+    slots.assign(capacity, Slot{ 0, -1 });
+    keys.reserve(expectedKeys);
+    mask = capacity - 1;
+}
+
+
+int WeldTable::FindOrInsert(const WeldKey& key, uint64_t hash)
+{
+    if ((keys.size() + 1) * 2 > slots.size()) { Grow(); }
+
+    uint32_t shortHash = (uint32_t)(hash >> 32);
+    size_t   slotIdx   = (size_t)hash & mask;
+
+    while (true)
+    {
+        Slot& slot = slots[slotIdx];
+
+        if (slot.index < 0)
+        {
+            slot.hash  = shortHash;
+            slot.index = (int32_t)keys.size();
+            keys.emplace_back(key);
+            return slot.index;
+        }
+
+        if (slot.hash == shortHash && keys[slot.index] == key) { return slot.index; }
+
+        slotIdx = (slotIdx + 1) & mask;
+    }
+}
+
+
+// @note Only happens if the table was created with a smaller estimation than the final amount of keys
+void WeldTable::Grow()
+{
+    std::vector<Slot> oldSlots = std::move(slots);
+
+    slots.assign(oldSlots.size() * 2, Slot{ 0, -1 });
+    mask = slots.size() - 1;
+
+    for (const Slot& slot : oldSlots)
+    {
+        if (slot.index < 0) { continue; }
+
+        size_t slotIdx = (size_t)Welder::HashKey(keys[slot.index]) & mask;
+        while (slots[slotIdx].index >= 0) { slotIdx = (slotIdx + 1) & mask; }
+        slots[slotIdx] = slot;
+    }
+}
+
+
+namespace
+{
+    constexpr size_t PARALLEL_MIN_CORNERS = 65536;
+
+    // @note llround turns -0.0 into 0, so both signs of zero weld together
+    inline int64_t QuantizePosition(float value, double step)
+    {
+        return (int64_t)std::llround((double)value / step);
+    }
+
+    inline int32_t QuantizeAttribute(float value, float step)
+    {
+        double cell = std::round((double)value / step);
+        cell = std::clamp(cell, (double)std::numeric_limits<int32_t>::min(), (double)std::numeric_limits<int32_t>::max());
+        return (int32_t)cell;
+    }
+
+    inline uint64_t Mix(uint64_t seed, uint64_t value)
+    {
+        // splitmix64 finalizer
+        value += 0x9e3779b97f4a7c15ULL + seed;
+        value  = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value  = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+}
+
+
+WeldKey Welder::MakeKey(const MeshArrays& meshArrays, size_t corner, bool skinned, const WeldSettings& settings)
+{
+    WeldKey key{};
+
+    int faceVertex = meshArrays.triangleCorners[corner];
+    int vertexID   = meshArrays.faceVertexIDs[faceVertex];
+    int normalID   = meshArrays.faceVertexNormalIDs[faceVertex];
+
+    for (int i = 0; i < 3; i++)
+    {
+        key.position[i] = QuantizePosition (meshArrays.points [vertexID * 3 + i], settings.positionStep);
+        key.normal  [i] = QuantizeAttribute(meshArrays.normals[normalID * 3 + i], settings.attributeStep);
+        key.color   [i] = meshArrays.HasColors() ? QuantizeAttribute(meshArrays.faceVertexColors[faceVertex * 3 + i], settings.attributeStep) 
+                                                 : QuantizeAttribute(1.0f, settings.attributeStep);
+    }
+
+    for (int set = 0; set < meshArrays.UVSetCount(); set++)
+    {
+        const UVSet& uvSet = meshArrays.uvSets[set];
+        int          uvID  = uvSet.faceVertexUVIDs[faceVertex];
+
+        key.uv[set][0] = (uvID >= 0) ? QuantizeAttribute(uvSet.us[uvID], settings.attributeStep) : 0;
+        key.uv[set][1] = (uvID >= 0) ? QuantizeAttribute(uvSet.vs[uvID], settings.attributeStep) : 0;
+    }
+
+    key.vertexID = skinned ? vertexID : -1;
+
+    return key;
+}
+
+
+uint64_t Welder::HashKey(const WeldKey& key)
+{
+    uint64_t hash = 0;
+
+    hash = Mix(hash, (uint64_t)key.position[0]);
+    hash = Mix(hash, (uint64_t)key.position[1]);
+    hash = Mix(hash, (uint64_t)key.position[2]);
+    hash = Mix(hash, ((uint64_t)(uint32_t)key.normal[0] << 32) | (uint32_t)key.normal[1]);
+    hash = Mix(hash, ((uint64_t)(uint32_t)key.normal[2] << 32) | (uint32_t)key.color [0]);
+    hash = Mix(hash, ((uint64_t)(uint32_t)key.color [1] << 32) | (uint32_t)key.color [2]);
+    for (int set = 0; set < MAX_UV_SETS; set++)
+    {
+        hash = Mix(hash, ((uint64_t)(uint32_t)key.uv[set][0] << 32) | (uint32_t)key.uv[set][1]);
+    }
+    hash = Mix(hash, (uint64_t)(uint32_t)key.vertexID);
+
+    return hash;
+}
+
+
+size_t Welder::WeldCorners(const MeshArrays& meshArrays, bool skinned, bool deduplicate, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners, unsigned int threadCount)
+{
+    size_t cornerCount = meshArrays.CornerCount();
+
+    // @note No welding, every corner is its own vertex so there's nothing to hash
+    if (!deduplicate)
+    {
+        indices      .resize(cornerCount);
+        uniqueCorners.resize(cornerCount);
+        for (size_t corner = 0; corner < cornerCount; corner++)
+        {
+            indices      [corner] = (int)corner;
+            uniqueCorners[corner] = (int)corner;
+        }
+        return 0;
+    }
+
+    // @note bench/WeldBenchmark: one thread of the parallel path costs ~1.3x the serial weld (the counting sort and the
+    // numbering passes), so it only pays off with at least 2 cores actually running. More threads than cores just queue up.
+    // Under ~64K corners the 6 rounds of thread spawns eat what's left of the gain
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    threadCount = std::min(Parallel::ThreadCount(threadCount), hardwareThreads);
+    if (threadCount < 2 || cornerCount < PARALLEL_MIN_CORNERS) { return WeldCornersSerial(meshArrays, skinned, settings, indices, uniqueCorners); }
+
+    return WeldCornersParallel(meshArrays, skinned, settings, indices, uniqueCorners, threadCount);
+}
+
+
+size_t Welder::WeldCornersSerial(const MeshArrays& meshArrays, bool skinned, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners)
+{
+    size_t cornerCount = meshArrays.CornerCount();
+
+    indices.resize(cornerCount);
+    uniqueCorners.clear();
+
+    // @note Usually there are a few more unique vertices than Maya vertices (seams and hard edges)
+    size_t     vertexCount = meshArrays.points.size() / 3;
+    size_t     expected    = std::min(cornerCount, vertexCount + vertexCount / 2);
+    WeldTable  table(expected);
+    uniqueCorners.reserve(expected);
+
+    for (size_t corner = 0; corner < cornerCount; corner++)
+    {
+        WeldKey key   = MakeKey(meshArrays, corner, skinned, settings);
+        int     index = table.FindOrInsert(key, HashKey(key));
+
+        if (index == (int)uniqueCorners.size()) { uniqueCorners.emplace_back((int)corner); }
+
+        indices[corner] = index;
+    }
+
+    return cornerCount - uniqueCorners.size();
+}
+
+
+// @note Deterministic parallel welding. Same output as WeldCornersSerial, byte by byte, for any amount of threads:
+// 1. Every corner is keyed and hashed once and the top bits of the hash pick one of the shards. Equal keys always land in
+//    the same shard
+// 2. The corners are bucketed per shard keeping their ascending order (stable counting sort, chunks merged in order)
+// 3. Each shard is welded on its own table with the keys and hashes of step 1. As corners go in ascending order, the
+//    first corner of every key is the smallest one, which is the one the serial version would have kept
+// 4. The unique corners are numbered in ascending corner order with a prefix sum, which is the serial first seen order
+size_t Welder::WeldCornersParallel(const MeshArrays& meshArrays, bool skinned, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners, unsigned int threadCount)
+{
+    const size_t   cornerCount = meshArrays.CornerCount();
+    const unsigned shardBits   = 6;
+    const unsigned shardCount  = 1u << shardBits;
+
+    // 1. Key and hash of every corner, kept for step 3. The top bits of the hash are the shard
+    struct HashedKey
+    {
+        WeldKey  key;
+        uint64_t hash;
+    };
+
+    std::vector<HashedKey> hashedKeys(cornerCount);
+    std::vector<size_t>    chunkShardCounts((size_t)threadCount * shardCount, 0);
+
+    Parallel::ForChunks(cornerCount, threadCount, [&](size_t begin, size_t end, unsigned int chunkIdx)
+    {
+        size_t* counts = &chunkShardCounts[(size_t)chunkIdx * shardCount];
+        for (size_t corner = begin; corner < end; corner++)
+        {
+            HashedKey& hashed = hashedKeys[corner];
+            hashed.key        = MakeKey(meshArrays, corner, skinned, settings);
+            hashed.hash       = HashKey(hashed.key);
+            counts[hashed.hash >> (64 - shardBits)]++;
+        }
+    });
+
+    // 2. Shard offsets, each chunk writes after the previous chunks of the same shard
+    std::vector<size_t> shardBegin(shardCount + 1, 0);
+    std::vector<size_t> chunkShardOffsets((size_t)threadCount * shardCount, 0);
+    {
+        size_t offset = 0;
+        for (unsigned shard = 0; shard < shardCount; shard++)
+        {
+            shardBegin[shard] = offset;
+            for (unsigned chunk = 0; chunk < threadCount; chunk++)
+            {
+                chunkShardOffsets[(size_t)chunk * shardCount + shard] = offset;
+                offset += chunkShardCounts[(size_t)chunk * shardCount + shard];
+            }
+        }
+        shardBegin[shardCount] = offset;
+    }
+
+    std::vector<int> shardedCorners(cornerCount);
+
+    Parallel::ForChunks(cornerCount, threadCount, [&](size_t begin, size_t end, unsigned int chunkIdx)
+    {
+        size_t* offsets = &chunkShardOffsets[(size_t)chunkIdx * shardCount];
+        for (size_t corner = begin; corner < end; corner++)
+        {
+            shardedCorners[offsets[hashedKeys[corner].hash >> (64 - shardBits)]++] = (int)corner;
+        }
+    });
+
+    // 3. Weld every shard, firstCorner ends up holding the smallest corner with the same key
+    std::vector<int> firstCorner(cornerCount);
+
+    Parallel::ForChunks(shardCount, threadCount, [&](size_t shardBeginIdx, size_t shardEndIdx, unsigned int)
+    {
+        std::vector<int> localFirstCorner;
+
+        for (size_t shard = shardBeginIdx; shard < shardEndIdx; shard++)
+        {
+            size_t    begin = shardBegin[shard];
+            size_t    end   = shardBegin[shard + 1];
+            WeldTable table((end - begin) / 2);
+
+            localFirstCorner.clear();
+
+            for (size_t s = begin; s < end; s++)
+            {
+                int              corner = shardedCorners[s];
+                const HashedKey& hashed = hashedKeys[corner];
+                int              local  = table.FindOrInsert(hashed.key, hashed.hash);
+
+                if (local == (int)localFirstCorner.size()) { localFirstCorner.emplace_back(corner); }
+
+                firstCorner[corner] = localFirstCorner[local];
+            }
+        }
+    });
+
+    shardedCorners.clear();
+    shardedCorners.shrink_to_fit();
+    hashedKeys.clear();
+    hashedKeys.shrink_to_fit();
+
+    // 4. Number the unique corners in ascending order
+    std::vector<size_t> chunkUniqueCounts(threadCount, 0);
+
+    Parallel::ForChunks(cornerCount, threadCount, [&](size_t begin, size_t end, unsigned int chunkIdx)
+    {
+        size_t uniques = 0;
+        for (size_t corner = begin; corner < end; corner++)
+        {
+            if (firstCorner[corner] == (int)corner) { uniques++; }
+        }
+        chunkUniqueCounts[chunkIdx] = uniques;
+    });
+
+    size_t uniqueCount = 0;
+    for (size_t& chunkCount : chunkUniqueCounts)
+    {
+        size_t count = chunkCount;
+        chunkCount   = uniqueCount;
+        uniqueCount += count;
+    }
+
+    indices      .resize(cornerCount);
+    uniqueCorners.resize(uniqueCount);
+
+    Parallel::ForChunks(cornerCount, threadCount, [&](size_t begin, size_t end, unsigned int chunkIdx)
+    {
+        size_t unique = chunkUniqueCounts[chunkIdx];
+        for (size_t corner = begin; corner < end; corner++)
+        {
+            if (firstCorner[corner] == (int)corner)
+            {
+                // Unique corners keep their own index for now, the duplicated ones get resolved below
+                indices      [corner] = (int)unique;
+                uniqueCorners[unique] = (int)corner;
+                unique++;
+            }
+        }
+    });
+
+    // The first corner of a key always comes before (or is) the corner itself, and it's already numbered
+    Parallel::ForChunks(cornerCount, threadCount, [&](size_t begin, size_t end, unsigned int)
+    {
+        for (size_t corner = begin; corner < end; corner++)
+        {
+            if (firstCorner[corner] != (int)corner) { indices[corner] = indices[firstCorner[corner]]; }
+        }
+    });
+
+    return cornerCount - uniqueCount;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "MeshArrays.h"
+
+// @note Vertex welding without std::unordered_map<Vertex, int>.
+// Every triangle corner is turned into a quantized key (so the hash and the comparison agree with each other, near
+// equal values land in the same cell and -0.0 welds with 0.0) and looked up once in a flat open addressing table.
+//
+struct WeldSettings
+{
+    // @note Values closer than a step usually share a cell, but two values right at both sides of a cell boundary won't.
+    // The steps are way coarser than the float precision of the attributes so that hardly ever happens
+    double positionStep  = 1e-5;   // Quantization step of the positions (Maya units)
+    float  attributeStep = 1e-5f;  // Quantization step of the normals, colors and UVs
+};
+
+struct WeldKey
+{
+    int64_t position[3];
+    int32_t normal  [3];
+    int32_t color   [3];
+    int32_t uv      [MAX_UV_SETS][2];
+    int32_t vertexID;              // Only used for skinned meshes, -1 otherwise
+
+    bool operator == (const WeldKey& other) const 
+    {
+        return position[0] == other.position[0] && position[1] == other.position[1] && position[2] == other.position[2] &&
+               normal  [0] == other.normal  [0] && normal  [1] == other.normal  [1] && normal  [2] == other.normal  [2] &&
+               color   [0] == other.color   [0] && color   [1] == other.color   [1] && color   [2] == other.color   [2] &&
+               std::equal(&uv[0][0], &uv[0][0] + MAX_UV_SETS * 2, &other.uv[0][0]) &&
+               vertexID    == other.vertexID;
+    }
+};
+
+
+// @note Linear probing over a power of two array of slots. The slots only hold the hash and the index of the unique 
+// vertex, the keys live in a separate contiguous array so probing stays inside a couple of cache lines.
+class WeldTable
+{
+public:
+    explicit WeldTable(size_t expectedKeys = 0);
+
+    // Returns the index of the key if it was already in the table, otherwise inserts it with the next index
+    int    FindOrInsert(const WeldKey& key, uint64_t hash);
+
+    size_t Size() const { return keys.size(); }
+
+private:
+    struct Slot
+    {
+        uint32_t hash;
+        int32_t  index;            // -1 = empty
+    };
+
+    void Grow();
+
+    std::vector<Slot>    slots;
+    std::vector<WeldKey> keys;
+    size_t               mask = 0;
+};
+
+
+namespace Welder
+{
+    WeldKey  MakeKey(const MeshArrays& meshArrays, size_t corner, bool skinned, const WeldSettings& settings);
+    uint64_t HashKey(const WeldKey& key);
+
+    // indices       -> one per triangle corner, index of its unique vertex
+    // uniqueCorners -> one per unique vertex, the first corner that generated it (Vertices keep their first seen order)
+    // threadCount   -> 0 uses every core, never more threads than cores. The output is exactly the same whatever the amount of threads
+    // Returns the amount of duplicated corners
+    size_t   WeldCorners(const MeshArrays& meshArrays, bool skinned, bool deduplicate, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners, unsigned int threadCount = 0);
+
+    size_t   WeldCornersSerial  (const MeshArrays& meshArrays, bool skinned, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners);
+    size_t   WeldCornersParallel(const MeshArrays& meshArrays, bool skinned, const WeldSettings& settings, std::vector<int>& indices, std::vector<int>& uniqueCorners, unsigned int threadCount);
+}
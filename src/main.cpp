@@ -23,6 +23,9 @@
 #include <QtWidgets/qcheckbox.h>
 #include <QtWidgets/qtabwidget.h>
 #include <QtWidgets/qtabbar.h>
+#include <QtWidgets/QDoubleSpinBox>
+#include <QtWidgets/qspinbox.h>
+#include <QtWidgets/qlineedit.h>
 
 #include <vector>
 #include <string>
@@ -48,7 +51,7 @@ struct CustomWindow : public QDialog
         setWindowTitle("Midnight File Exporter");
         QIcon* icon = new QIcon("C:/ScriptsMAYA/cpp/MOF_Plugin/MOF_Exporter/resources/icon6.png");
         setWindowIcon(*icon);
-        setFixedSize(360, 180); // slightly larger for tabs
+        setFixedSize(360, 510); // slightly larger for tabs
 
         // --- Main layout ---
         QVBoxLayout* mainLayout = new QVBoxLayout(this);
@@ -82,8 +85,46 @@ struct CustomWindow : public QDialog
         QCheckBox* checkBox = new QCheckBox("Deduplicate Vertices");     
         staticLayout->addWidget(checkBox, 0, Qt::AlignLeft);
 
+        QHBoxLayout* influencesLayout = new QHBoxLayout();
+        QLabel*      influencesLabel  = new QLabel("Max Influences:", this);
+        influencesLabel->setFont(labelFont);
+
+        QComboBox* influencesDropdown = new QComboBox(this);
+        influencesDropdown->addItem("4");
+        influencesDropdown->addItem("8");
+        influencesDropdown->setToolTip("Influences kept per vertex. The heaviest ones are kept and renormalised");
+
+        influencesLayout->addWidget(influencesLabel);
+        influencesLayout->addWidget(influencesDropdown);
+        staticLayout->addLayout(influencesLayout);
+
+        QHBoxLayout* layoutLayout = new QHBoxLayout();
+        QLabel*      layoutLabel  = new QLabel("Vertex Layout:", this);
+        layoutLabel->setFont(labelFont);
+
+        QComboBox* layoutDropdown = new QComboBox(this);
+        layoutDropdown->addItem("Float");
+        layoutDropdown->addItem("Compact");
+        layoutDropdown->setToolTip("Compact quantizes the vertices (16 bit positions and uvs, octahedral normals, 8 bit colors, joints and weights)\n20 bytes per static vertex, 28 (4 influences) or 36 (8 influences) per skinned one. Binary only");
+
+        layoutLayout->addWidget(layoutLabel);
+        layoutLayout->addWidget(layoutDropdown);
+        staticLayout->addLayout(layoutLayout);
+
+        QCheckBox* chunkedCheckBox = new QCheckBox("MOF v2 Container");
+        chunkedCheckBox->setToolTip("Versioned file with a chunk directory and 64 byte aligned sections, so the runtime can map it and use the vertices and indices in place. Binary only");
+        staticLayout->addWidget(chunkedCheckBox, 0, Qt::AlignLeft);
+
+        QCheckBox* optimizeCheckBox = new QCheckBox("Optimize Index Buffer");
+        optimizeCheckBox->setToolTip("Reorders the triangles for the GPU vertex cache and overdraw. The ACMR/ATVR before and after get printed in the script editor");
+        staticLayout->addWidget(optimizeCheckBox, 0, Qt::AlignLeft);
+
+        QCheckBox* reportCheckBox = new QCheckBox("Write Export Report");
+        reportCheckBox->setToolTip("Writes [file].report.json next to the exported file: time per stage, Maya API calls, vertex/triangle counts and bytes written");
+        staticLayout->addWidget(reportCheckBox, 0, Qt::AlignLeft);
+
         QPushButton* button = new QPushButton("Export Selected", this);
-        button->setToolTip("Select the model you want to export - This exporter detects if the model has any influences attach to it and generates \nthe MOF accordingly [From a 44 bytes vertex stride for static models up to 76 bytes for animated ones]");
+        button->setToolTip("Select the model you want to export - This exporter detects if the model has any influences attach to it and generates \nthe MOF accordingly [From a 44 bytes vertex stride for static models up to 76 (4 influences) or 108 (8 influences) bytes for animated ones]\nChannels without data (no color sets, no UV sets) are left out of the file, extra UV sets get added");
         staticLayout->addWidget(button);
 
         // --- Connect export button ---
@@ -106,7 +147,16 @@ struct CustomWindow : public QDialog
                 {
                     std::string path   = filePath.toUtf8().constData();
                     std::string format = choice.toUtf8().constData();
-                    MOF_Generator::ExportMesh(path, format, checkBox->isChecked());                    
+
+                    MeshExportSettings settings;
+                    settings.deduplicate     = checkBox->isChecked();
+                    settings.maxInfluences   = influencesDropdown->currentText().toInt();
+                    settings.optimizeIndices = optimizeCheckBox->isChecked();
+                    settings.vertexLayout    = (layoutDropdown->currentText() == "Compact") ? VertexLayout::Compact : VertexLayout::Float;
+                    settings.chunkedFile     = chunkedCheckBox->isChecked();
+                    settings.writeReport     = reportCheckBox->isChecked();
+
+                    MOF_Generator::ExportMesh(path, format, settings);                    
                 }
             }
         );
@@ -133,8 +183,133 @@ struct CustomWindow : public QDialog
         animDropHorLayout->addWidget(animDropdown);
 
         QCheckBox* animCheckBox = new QCheckBox("Deduplicate Keyframes");
+        animCheckBox->setToolTip("Keeps only the keys interpolation can't reproduce within the tolerance, per joint channel. Channels that never leave\ntheir rest value are left out. Writes a MAF v2 file with one track per animated channel");
         animVertLayout->addWidget(animCheckBox, 0, Qt::AlignLeft);
 
+        QHBoxLayout* toleranceLayout = new QHBoxLayout();
+        QLabel*      toleranceLabel  = new QLabel("Key Tolerance:", this);
+        toleranceLabel->setFont(labelFont);
+
+        KeyframeReducer::Tolerance defaultTolerance;
+
+        QDoubleSpinBox* positionToleranceBox = new QDoubleSpinBox(this);
+        positionToleranceBox->setDecimals(4);
+        positionToleranceBox->setRange(0.0, 10.0);
+        positionToleranceBox->setSingleStep(0.001);
+        positionToleranceBox->setValue(defaultTolerance.position);
+        positionToleranceBox->setSuffix(" cm");
+        positionToleranceBox->setToolTip("Largest distance between a sampled position and the reduced one. Also used for scale and shear (x0.1)");
+
+        QDoubleSpinBox* rotationToleranceBox = new QDoubleSpinBox(this);
+        rotationToleranceBox->setDecimals(3);
+        rotationToleranceBox->setRange(0.0, 10.0);
+        rotationToleranceBox->setSingleStep(0.01);
+        rotationToleranceBox->setValue(defaultTolerance.rotation * 180.0 / 3.14159265358979);
+        rotationToleranceBox->setSuffix(" deg");
+        rotationToleranceBox->setToolTip("Largest angle between a sampled rotation and the reduced one");
+
+        toleranceLayout->addWidget(toleranceLabel);
+        toleranceLayout->addWidget(positionToleranceBox);
+        toleranceLayout->addWidget(rotationToleranceBox);
+        animVertLayout->addLayout(toleranceLayout);
+
+        QCheckBox* compressCheckBox = new QCheckBox("Compress Keyframes");
+        compressCheckBox->setToolTip("Quantized keys: smallest three rotations and range reduced positions/scales, binary only (Ascii gets the decoded values).\nEvery track gets the fewest bits that keep the joints under the error threshold, measured in object space through the hierarchy");
+        animVertLayout->addWidget(compressCheckBox, 0, Qt::AlignLeft);
+
+        QHBoxLayout* compressLayout = new QHBoxLayout();
+        QLabel*      compressLabel  = new QLabel("Max Error:", this);
+        compressLabel->setFont(labelFont);
+
+        AnimationCompressor::Settings defaultCompression;
+
+        QDoubleSpinBox* errorThresholdBox = new QDoubleSpinBox(this);
+        errorThresholdBox->setDecimals(4);
+        errorThresholdBox->setRange(0.0001, 10.0);
+        errorThresholdBox->setSingleStep(0.001);
+        errorThresholdBox->setValue(defaultCompression.threshold);
+        errorThresholdBox->setSuffix(" cm");
+        errorThresholdBox->setToolTip("Largest object space distance between the sampled joints (and points 3 cm away from them) and the compressed ones");
+
+        QSpinBox* rotationBitsBox = new QSpinBox(this);
+        rotationBitsBox->setRange(AnimationCompressor::MIN_ROTATION_BITS, AnimationCompressor::MAX_ROTATION_BITS);
+        rotationBitsBox->setValue(defaultCompression.rotationBits);
+        rotationBitsBox->setSuffix(" bits");
+        rotationBitsBox->setToolTip("Most bits per rotation component, every rotation key takes 2 + 3 x bits");
+
+        compressLayout->addWidget(compressLabel);
+        compressLayout->addWidget(errorThresholdBox);
+        compressLayout->addWidget(rotationBitsBox);
+        animVertLayout->addLayout(compressLayout);
+
+        QHBoxLayout* segmentLayout = new QHBoxLayout();
+        QLabel*      segmentLabel  = new QLabel("Segment Frames:", this);
+        segmentLabel->setFont(labelFont);
+
+        QSpinBox* segmentFramesBox = new QSpinBox(this);
+        segmentFramesBox->setRange(0, 65536);
+        segmentFramesBox->setSingleStep(16);
+        segmentFramesBox->setValue(0);
+        segmentFramesBox->setSpecialValueText("Off");
+        segmentFramesBox->setToolTip("Binary files without deduplication/compression: stores the frames in blocks of this many, every joint channel\ncontiguous inside a block (track-major) so a player can load one block at a time. Off = one frame after the other");
+
+        segmentLayout->addWidget(segmentLabel);
+        segmentLayout->addWidget(segmentFramesBox);
+        animVertLayout->addLayout(segmentLayout);
+
+        QHBoxLayout* sampleRateLayout = new QHBoxLayout();
+        QLabel*      sampleRateLabel  = new QLabel("Sample Rate:", this);
+        sampleRateLabel->setFont(labelFont);
+
+        QDoubleSpinBox* sampleRateBox = new QDoubleSpinBox(this);
+        sampleRateBox->setDecimals(3);
+        sampleRateBox->setRange(0.0, 1000.0);
+        sampleRateBox->setSingleStep(1.0);
+        sampleRateBox->setValue(0.0);
+        sampleRateBox->setSuffix(" fps");
+        sampleRateBox->setSpecialValueText("Scene");
+        sampleRateBox->setToolTip("Samples per second of the exported animation, written in the MAF header. The joints are evaluated at exactly those times,\nin between frames too (a 120 fps scene at 30, a 24 fps one at 60). Scene = every frame of the scene");
+
+        sampleRateLayout->addWidget(sampleRateLabel);
+        sampleRateLayout->addWidget(sampleRateBox);
+        animVertLayout->addLayout(sampleRateLayout);
+
+        QCheckBox* curvesCheckBox = new QCheckBox("Export Animation Curves");
+        curvesCheckBox->setToolTip("Binary only: the joints keyed straight by animation curves get the keys and tangents they were authored with instead of\nbeing sampled. Constraints, expressions, IK, layers and weighted or cycling curves are still sampled (deduplicated when it's on)");
+        animVertLayout->addWidget(curvesCheckBox, 0, Qt::AlignLeft);
+
+        QHBoxLayout* paletteLayout = new QHBoxLayout();
+
+        QCheckBox* paletteCheckBox = new QCheckBox("Bake Matrix Palette");
+        paletteCheckBox->setToolTip("Binary only: writes the skinning matrices of every joint on every frame (object space transform times the inverse\nbind matrix, 3x4) instead of the local transforms, frames x joints, ready to upload as a buffer or texture");
+
+        QCheckBox* halfMatricesCheckBox = new QCheckBox("Half Precision");
+        halfMatricesCheckBox->setToolTip("Stores the palette in 16 bit floats, half the size. The translations lose precision far from the origin");
+
+        paletteLayout->addWidget(paletteCheckBox);
+        paletteLayout->addWidget(halfMatricesCheckBox);
+        animVertLayout->addLayout(paletteLayout);
+
+        QHBoxLayout* clipsLayout = new QHBoxLayout();
+        QLabel*      clipsLabel  = new QLabel("Clips:", this);
+        clipsLabel->setFont(labelFont);
+
+        QLineEdit* clipsLineEdit = new QLineEdit(this);
+        clipsLineEdit->setPlaceholderText("walk 0 30 loop; run 31 60 loop; idle 61 120");
+        clipsLineEdit->setToolTip("Named timeline ranges: name start end [loop], inclusive frames, separated by ';'. Every clip is sampled in the same pass.\nBinary files get one clip library with all of them, Ascii a file per clip. Empty = the playback range as a single clip");
+
+        QCheckBox* clipFilesCheckBox = new QCheckBox("File Per Clip");
+        clipFilesCheckBox->setToolTip("Writes every clip of the table to [file]_[clip].maf instead of one clip library");
+
+        clipsLayout->addWidget(clipsLabel);
+        clipsLayout->addWidget(clipsLineEdit);
+        clipsLayout->addWidget(clipFilesCheckBox);
+        animVertLayout->addLayout(clipsLayout);
+
+        QCheckBox* animReportCheckBox = new QCheckBox("Write Export Report");
+        animReportCheckBox->setToolTip("Writes [file].report.json next to the exported file: time per stage, Maya API calls, joint/frame counts and bytes written");
+        animVertLayout->addWidget(animReportCheckBox, 0, Qt::AlignLeft);
+
         QPushButton* exportMafButton = new QPushButton("Export Selected", this);
         exportMafButton->setToolTip("MAF file exporter. This file retrieves Joints hierarchy, joint Id's and keyframes data");
         animVertLayout->addWidget(exportMafButton);
@@ -151,6 +326,14 @@ struct CustomWindow : public QDialog
                     return;
                 }
 
+                std::vector<ClipRange> clips;
+                std::string            clipError;
+                if (!ClipTable::Parse(clipsLineEdit->text().toUtf8().constData(), clips, clipError))
+                {
+                    MGlobal::displayWarning(clipError.c_str());
+                    return;
+                }
+
                 QString choice = animDropdown->currentText();
                 QString filter = (choice == "Binary") ? "Binary Files (*.maf)" : "ASCII Files (*.maf)";
                 QString filePath = QFileDialog::getSaveFileName(this, "Export Midnight Object File", "", filter);
@@ -159,7 +342,25 @@ struct CustomWindow : public QDialog
                 {
                     std::string path = filePath.toUtf8().constData();
                     std::string format = choice.toUtf8().constData();
-                    MAF_Generator::ExportAnimation(path, format, animCheckBox->isChecked());
+
+                    AnimationExportSettings settings;
+                    settings.deduplicate              = animCheckBox->isChecked();
+                    settings.writeReport              = animReportCheckBox->isChecked();
+                    settings.keyTolerance.position    = (float)positionToleranceBox->value();
+                    settings.keyTolerance.rotation    = (float)(rotationToleranceBox->value() * 3.14159265358979 / 180.0);
+                    settings.keyTolerance.scale       = settings.keyTolerance.position * 0.1f;
+                    settings.compress                 = compressCheckBox->isChecked();
+                    settings.compression.threshold    = (float)errorThresholdBox->value();
+                    settings.compression.rotationBits = rotationBitsBox->value();
+                    settings.segmentFrames            = (uint32_t)segmentFramesBox->value();
+                    settings.sampleRate               = (float)sampleRateBox->value();
+                    settings.clips                    = clips;
+                    settings.clipFiles                = clipFilesCheckBox->isChecked();
+                    settings.animationCurves          = curvesCheckBox->isChecked();
+                    settings.matrixPalette            = paletteCheckBox->isChecked();
+                    settings.halfMatrices             = halfMatricesCheckBox->isChecked();
+
+                    MAF_Generator::ExportAnimation(path, format, settings);
                 }
             });
 
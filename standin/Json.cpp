@@ -0,0 +1,176 @@
+#include "Json.h"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace
+{
+    struct Parser
+    {
+        const std::string& text;
+        size_t             pos = 0;
+        std::string        error = {};
+
+        void SkipSpaces()
+        {
+            while (pos < text.size() && std::isspace((unsigned char)text[pos])) { pos++; }
+        }
+
+        bool Fail(const char* message)
+        {
+            if (error.empty()) { error = std::string(message) + " at offset " + std::to_string(pos); }
+            return false;
+        }
+
+        bool Expect(char c)
+        {
+            SkipSpaces();
+            if (pos >= text.size() || text[pos] != c) { return Fail((std::string("Expected '") + c + "'").c_str()); }
+            pos++;
+            return true;
+        }
+
+        bool Literal(const char* word)
+        {
+            size_t length = std::char_traits<char>::length(word);
+            if (text.compare(pos, length, word) != 0) { return Fail("Unknown literal"); }
+            pos += length;
+            return true;
+        }
+
+        bool ParseString(std::string& out)
+        {
+            if (!Expect('"')) { return false; }
+
+            out.clear();
+            while (pos < text.size() && text[pos] != '"')
+            {
+                char c = text[pos++];
+                if (c != '\\') { out += c; continue; }
+
+                if (pos >= text.size()) { break; }
+                char escaped = text[pos++];
+                switch (escaped)
+                {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u':
+                    {
+                        if (pos + 4 > text.size()) { return Fail("Truncated escape"); }
+                        out += (char)std::strtol(text.substr(pos, 4).c_str(), nullptr, 16);
+                        pos += 4;
+                    } break;
+                    default: out += escaped; break;
+                }
+            }
+
+            if (pos >= text.size()) { return Fail("Unterminated string"); }
+            pos++;
+            return true;
+        }
+
+        bool ParseValue(Json::Value& value, int depth)
+        {
+            if (depth > 64) { return Fail("Too deep"); }
+
+            SkipSpaces();
+            if (pos >= text.size()) { return Fail("Unexpected end"); }
+
+            char c = text[pos];
+            if (c == '{')
+            {
+                pos++;
+                value.type = Json::Type::Object;
+
+                SkipSpaces();
+                if (pos < text.size() && text[pos] == '}') { pos++; return true; }
+
+                while (true)
+                {
+                    std::pair<std::string, Json::Value> member;
+                    if (!ParseString(member.first) || !Expect(':') || !ParseValue(member.second, depth + 1)) { return false; }
+                    value.object.emplace_back(std::move(member));
+
+                    SkipSpaces();
+                    if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+                    return Expect('}');
+                }
+            }
+            if (c == '[')
+            {
+                pos++;
+                value.type = Json::Type::Array;
+
+                SkipSpaces();
+                if (pos < text.size() && text[pos] == ']') { pos++; return true; }
+
+                while (true)
+                {
+                    value.array.emplace_back();
+                    if (!ParseValue(value.array.back(), depth + 1)) { return false; }
+
+                    SkipSpaces();
+                    if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+                    return Expect(']');
+                }
+            }
+            if (c == '"') { value.type = Json::Type::String;  return ParseString(value.string); }
+            if (c == 't') { value.type = Json::Type::Boolean; value.boolean = true;  return Literal("true");  }
+            if (c == 'f') { value.type = Json::Type::Boolean; value.boolean = false; return Literal("false"); }
+            if (c == 'n') { value.type = Json::Type::Null;    return Literal("null"); }
+
+            const char* start = text.c_str() + pos;
+            char*       end   = nullptr;
+            value.number = std::strtod(start, &end);
+            if (end == start) { return Fail("Unexpected character"); }
+
+            value.type = Json::Type::Number;
+            pos += (size_t)(end - start);
+            return true;
+        }
+    };
+}
+
+
+const Json::Value* Json::Value::Find(const std::string& key) const
+{
+    for (const auto& member : object)
+    {
+        if (member.first == key) { return &member.second; }
+    }
+    return nullptr;
+}
+
+
+double Json::Value::NumberOr(const std::string& key, double fallback) const
+{
+    const Value* value = Find(key);
+    return (value && value->IsNumber()) ? value->number : fallback;
+}
+
+
+std::string Json::Value::StringOr(const std::string& key, const std::string& fallback) const
+{
+    const Value* value = Find(key);
+    return (value && value->IsString()) ? value->string : fallback;
+}
+
+
+bool Json::Parse(const std::string& text, Value& root, std::string& error)
+{
+    Parser parser{ text };
+    root = Value{};
+
+    bool parsed = parser.ParseValue(root, 0);
+    if (parsed)
+    {
+        parser.SkipSpaces();
+        if (parser.pos != text.size()) { parsed = parser.Fail("Trailing characters"); }
+    }
+
+    error = parser.error;
+    return parsed;
+}
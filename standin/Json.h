@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// @note Just enough JSON for the stand-in scene descriptions: objects, arrays, numbers, strings, booleans and null.
+// No \u escapes beyond ASCII, the scenes only carry joint names and file paths.
+//
+namespace Json
+{
+    enum class Type { Null, Boolean, Number, String, Array, Object };
+
+    struct Value
+    {
+        Type                                       type    = Type::Null;
+        bool                                       boolean = false;
+        double                                     number  = 0.0;
+        std::string                                string;
+        std::vector<Value>                         array;
+        std::vector<std::pair<std::string, Value>> object;
+
+        bool IsNull()   const { return type == Type::Null;   }
+        bool IsNumber() const { return type == Type::Number; }
+        bool IsString() const { return type == Type::String; }
+        bool IsArray()  const { return type == Type::Array;  }
+        bool IsObject() const { return type == Type::Object; }
+
+        // nullptr if this isn't an object or the key isn't there
+        const Value* Find(const std::string& key) const;
+
+        double      NumberOr(const std::string& key, double fallback) const;
+        std::string StringOr(const std::string& key, const std::string& fallback) const;
+    };
+
+    bool Parse(const std::string& text, Value& root, std::string& error);
+}
@@ -0,0 +1,181 @@
+#include "ObjLoader.h"
+#include "Triangulator.h"
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+    // OBJ indices start at 1 and can be relative to the end of the list (negative)
+    int ResolveIndex(int objIndex, size_t count)
+    {
+        if (objIndex > 0) { return (objIndex <= (int)count) ? objIndex - 1 : -1; }
+        if (objIndex < 0) { return ((int)count + objIndex >= 0) ? (int)count + objIndex : -1; }
+        return -1;
+    }
+
+    // v, v/vt, v//vn or v/vt/vn
+    bool ParseCorner(const std::string& token, int& v, int& vt, int& vn)
+    {
+        v = vt = vn = 0;
+
+        size_t firstSlash = token.find('/');
+        v = std::atoi(token.substr(0, firstSlash).c_str());
+        if (firstSlash == std::string::npos) { return v != 0; }
+
+        size_t secondSlash = token.find('/', firstSlash + 1);
+        std::string uvToken = token.substr(firstSlash + 1, secondSlash == std::string::npos ? std::string::npos : secondSlash - firstSlash - 1);
+        if (!uvToken.empty()) { vt = std::atoi(uvToken.c_str()); }
+        if (secondSlash != std::string::npos) { vn = std::atoi(token.substr(secondSlash + 1).c_str()); }
+
+        return v != 0;
+    }
+}
+
+
+bool ObjLoader::Load(const std::string& path, MeshArrays& meshArrays, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) { error = "Couldn't open " + path; return false; }
+
+    std::vector<float> colors;       // RGB per OBJ vertex
+    bool               hasColors = false;
+    UVSet              uvSet;
+    std::vector<float> normals;
+    std::vector<int>   faceVertexUVIDs;
+    std::vector<int>   faceVertexNormalIDs;
+    std::vector<int>   polygonStarts;
+    std::vector<int>   polygonCounts;
+
+    meshArrays = MeshArrays{};
+
+    std::string line;
+    int         lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+
+        std::istringstream stream(line);
+        std::string        keyword;
+        stream >> keyword;
+
+        if (keyword == "v")
+        {
+            float p[3] = { 0.0f, 0.0f, 0.0f }, c[3] = { 1.0f, 1.0f, 1.0f };
+            stream >> p[0] >> p[1] >> p[2];
+            if (stream >> c[0] >> c[1] >> c[2]) { hasColors = true; }
+
+            meshArrays.points.insert(meshArrays.points.end(), p, p + 3);
+            colors.insert(colors.end(), c, c + 3);
+        }
+        else if (keyword == "vt")
+        {
+            float u = 0.0f, v = 0.0f;
+            stream >> u >> v;
+            uvSet.us.emplace_back(u);
+            uvSet.vs.emplace_back(v);
+        }
+        else if (keyword == "vn")
+        {
+            float n[3] = { 0.0f, 0.0f, 1.0f };
+            stream >> n[0] >> n[1] >> n[2];
+            normals.insert(normals.end(), n, n + 3);
+        }
+        else if (keyword == "f")
+        {
+            size_t      vertexCount = meshArrays.points.size() / 3;
+            int         faceStart   = (int)meshArrays.faceVertexIDs.size();
+            std::string token;
+
+            while (stream >> token)
+            {
+                int v, vt, vn;
+                if (!ParseCorner(token, v, vt, vn)) { error = "Bad face corner at line " + std::to_string(lineNumber); return false; }
+
+                int vertexID = ResolveIndex(v, vertexCount);
+                if (vertexID < 0) { error = "Vertex index out of range at line " + std::to_string(lineNumber); return false; }
+
+                meshArrays.faceVertexIDs.emplace_back(vertexID);
+                faceVertexUVIDs    .emplace_back(vt ? ResolveIndex(vt, uvSet.us.size())      : -1);
+                faceVertexNormalIDs.emplace_back(vn ? ResolveIndex(vn, normals.size() / 3)   : -1);
+            }
+
+            int corners = (int)meshArrays.faceVertexIDs.size() - faceStart;
+            if (corners < 3) { error = "Face with less than 3 corners at line " + std::to_string(lineNumber); return false; }
+
+            polygonStarts.emplace_back(faceStart);
+            polygonCounts.emplace_back(corners);
+        }
+    }
+
+    if (polygonCounts.empty()) { error = path + " has no faces"; return false; }
+
+    Triangulator::Fan(polygonCounts, meshArrays.triangleCounts, meshArrays.triangleCorners);
+
+    // ==========================================================================================================
+    // Normals, the corners without one get the normal of their face
+    // ==========================================================================================================
+    meshArrays.normals = std::move(normals);
+    meshArrays.faceVertexNormalIDs.resize(meshArrays.faceVertexIDs.size());
+
+    for (size_t p = 0; p < polygonStarts.size(); p++)
+    {
+        int start = polygonStarts[p];
+        int end   = (p + 1 < polygonStarts.size()) ? polygonStarts[p + 1] : (int)meshArrays.faceVertexIDs.size();
+        int faceNormal = -1;
+
+        for (int fv = start; fv < end; fv++)
+        {
+            if (faceVertexNormalIDs[fv] >= 0) { meshArrays.faceVertexNormalIDs[fv] = faceVertexNormalIDs[fv]; continue; }
+
+            if (faceNormal < 0)
+            {
+                // Newell's method, works for any planar-ish polygon
+                float n[3] = { 0.0f, 0.0f, 0.0f };
+                for (int c = start; c < end; c++)
+                {
+                    const float* a = &meshArrays.points[(size_t)meshArrays.faceVertexIDs[c] * 3];
+                    const float* b = &meshArrays.points[(size_t)meshArrays.faceVertexIDs[(c + 1 < end) ? c + 1 : start] * 3];
+                    n[0] += (a[1] - b[1]) * (a[2] + b[2]);
+                    n[1] += (a[2] - b[2]) * (a[0] + b[0]);
+                    n[2] += (a[0] - b[0]) * (a[1] + b[1]);
+                }
+
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length > 0.0f) { n[0] /= length; n[1] /= length; n[2] /= length; }
+                else               { n[2] = 1.0f; }
+
+                faceNormal = (int)(meshArrays.normals.size() / 3);
+                meshArrays.normals.insert(meshArrays.normals.end(), n, n + 3);
+            }
+
+            meshArrays.faceVertexNormalIDs[fv] = faceNormal;
+        }
+    }
+
+    // ==========================================================================================================
+    // UVs and colors, both per face-vertex like Maya gives them
+    // ==========================================================================================================
+    bool hasUVs = false;
+    for (int uvID : faceVertexUVIDs) { hasUVs |= (uvID >= 0); }
+
+    if (hasUVs)
+    {
+        uvSet.faceVertexUVIDs = std::move(faceVertexUVIDs);
+        meshArrays.uvSets.emplace_back(std::move(uvSet));
+    }
+
+    if (hasColors)
+    {
+        meshArrays.faceVertexColors.resize(meshArrays.faceVertexIDs.size() * 3);
+        for (size_t fv = 0; fv < meshArrays.faceVertexIDs.size(); fv++)
+        {
+            for (int c = 0; c < 3; c++) { meshArrays.faceVertexColors[fv * 3 + c] = colors[(size_t)meshArrays.faceVertexIDs[fv] * 3 + c]; }
+        }
+    }
+
+    return true;
+}
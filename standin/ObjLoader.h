@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include "MeshArrays.h"
+
+// @note Wavefront OBJ into the same MeshArrays MOF_Generator::ExtractMeshArrays fills from Maya, so everything after the
+// extraction runs exactly the same. Reads v (with the optional r g b extension), vt, vn and f, the rest is ignored.
+//
+//  - OBJ vertices are the vertex IDs, in file order. Skin weights of the stand-in scene are indexed the same way
+//  - Polygons are fan triangulated, triangle corners point to face-vertex offsets like getTriangleOffsets
+//  - Faces without vn get their face normal
+//
+namespace ObjLoader
+{
+    bool Load(const std::string& path, MeshArrays& meshArrays, std::string& error);
+}
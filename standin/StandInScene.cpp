@@ -0,0 +1,161 @@
+#include "StandInScene.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "Json.h"
+#include "ObjLoader.h"
+
+namespace
+{
+    bool EndsWith(const std::string& text, const std::string& suffix)
+    {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    std::string Directory(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return (slash == std::string::npos) ? std::string() : path.substr(0, slash + 1);
+    }
+
+    void ReadComponents(const Json::Value& transform, const char* key, float* out, int count)
+    {
+        const Json::Value* value = transform.Find(key);
+        if (!value || !value->IsArray()) { return; }
+
+        for (int i = 0; i < count && i < (int)value->array.size(); i++)
+        {
+            if (value->array[i].IsNumber()) { out[i] = (float)value->array[i].number; }
+        }
+    }
+
+    Transform ReadTransform(const Json::Value* value)
+    {
+        Transform transform;
+        if (!value || !value->IsObject()) { return transform; }
+
+        ReadComponents(*value, "position", transform.position, 3);
+        ReadComponents(*value, "rotation", transform.rotation, 4);
+        ReadComponents(*value, "scale",    transform.scale,    3);
+        ReadComponents(*value, "shear",    transform.shear,    3);
+        return transform;
+    }
+
+    bool ReadSkeleton(const Json::Value& description, Skeleton& skeleton, std::string& error)
+    {
+        const Json::Value* root   = description.Find("root");
+        const Json::Value* joints = description.Find("joints");
+        if (!joints || !joints->IsArray()) { error = "The skeleton has no joints"; return false; }
+
+        skeleton.rootName     = root ? root->StringOr("name", "root") : "root";
+        skeleton.rootBindPose = ReadTransform(root ? root->Find("bind") : nullptr);
+
+        skeleton.joints.resize(joints->array.size());
+        for (size_t j = 0; j < joints->array.size(); j++)
+        {
+            const Json::Value& joint = joints->array[j];
+
+            skeleton.joints[j].name        = joint.StringOr("name", "joint" + std::to_string(j));
+            skeleton.joints[j].parentID    = (int)joint.NumberOr("parent", -1.0);
+            skeleton.joints[j].influenceID = (int)j;
+            skeleton.joints[j].bindPose    = ReadTransform(joint.Find("bind"));
+
+            if (skeleton.joints[j].parentID < -1 || skeleton.joints[j].parentID >= (int)joints->array.size()) { error = "Joint " + skeleton.joints[j].name + " has a parent out of range"; return false; }
+        }
+
+        // @note Parents can come after their children (Maya lists the influences in any order), so instead of asking for
+        // parent < index every joint has to reach the root in fewer steps than there are joints
+        for (size_t j = 0; j < skeleton.joints.size(); j++)
+        {
+            int    parent = skeleton.joints[j].parentID;
+            size_t steps  = 0;
+
+            while (parent >= 0 && steps++ < skeleton.joints.size()) { parent = skeleton.joints[parent].parentID; }
+
+            if (parent >= 0) { error = "Joint " + skeleton.joints[j].name + " is its own ancestor"; return false; }
+        }
+
+        skeleton.LinkChildren();
+        return true;
+    }
+
+    // @note Densifies the sparse lists into the same vertex major matrix MFnSkinCluster::getWeights returns, so the
+    // influences get pruned and normalised by the exact same code as in Maya
+    bool ReadWeights(const Json::Value& weights, size_t vertexCount, size_t jointCount, int maxInfluences, SkinInfluences& skin, std::string& error)
+    {
+        if (!weights.IsArray() || weights.array.size() != vertexCount) { error = "There must be one weight list per OBJ vertex"; return false; }
+
+        std::vector<double> weightMatrix(vertexCount * jointCount, 0.0);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            for (const Json::Value& influence : weights.array[v].array)
+            {
+                if (influence.array.size() != 2) { error = "Influences are [joint, weight] pairs"; return false; }
+
+                int joint = (int)influence.array[0].number;
+                if (joint < 0 || joint >= (int)jointCount) { error = "Influence out of range on vertex " + std::to_string(v); return false; }
+
+                weightMatrix[v * jointCount + joint] += influence.array[1].number;
+            }
+        }
+
+        SkinWeights::PackInfluences(weightMatrix.data(), (unsigned int)vertexCount, (unsigned int)jointCount, maxInfluences, skin);
+        return true;
+    }
+
+    bool ReadAnimation(const Json::Value& description, uint32_t jointCount, AnimationClip& clip, std::string& error)
+    {
+        const Json::Value* frames = description.Find("frames");
+        if (!frames || !frames->IsArray()) { error = "The animation has no frames"; return false; }
+
+        clip.frameRate  = (float)description.NumberOr("frameRate", 30.0);
+        clip.jointCount = jointCount;
+        clip.frameCount = (uint32_t)frames->array.size();
+        clip.transforms.resize((size_t)clip.frameCount * clip.jointCount);
+
+        for (uint32_t f = 0; f < clip.frameCount; f++)
+        {
+            const Json::Value& frame = frames->array[f];
+            if (frame.array.size() != jointCount) { error = "Frame " + std::to_string(f) + " needs a transform for the root and every joint"; return false; }
+
+            for (uint32_t j = 0; j < jointCount; j++) { clip.At(f, j) = ReadTransform(&frame.array[j]); }
+        }
+
+        return true;
+    }
+}
+
+
+bool StandInSceneLoader::Load(const std::string& path, int maxInfluences, StandInScene& scene, std::string& error)
+{
+    scene = StandInScene{};
+
+    if (EndsWith(path, ".obj")) { return ObjLoader::Load(path, scene.mesh, error); }
+
+    std::ifstream file(path);
+    if (!file.is_open()) { error = "Couldn't open " + path; return false; }
+
+    std::stringstream text;
+    text << file.rdbuf();
+
+    Json::Value description;
+    if (!Json::Parse(text.str(), description, error)) { error = path + ": " + error; return false; }
+
+    std::string meshPath = description.StringOr("mesh", "");
+    if (meshPath.empty()) { error = path + " doesn't say which mesh to load"; return false; }
+    if (!ObjLoader::Load(Directory(path) + meshPath, scene.mesh, error)) { return false; }
+
+    const Json::Value* skeleton = description.Find("skeleton");
+    if (!skeleton) { return true; }
+
+    if (!ReadSkeleton(*skeleton, scene.skeleton, error)) { return false; }
+
+    const Json::Value* weights = description.Find("weights");
+    if (weights && !ReadWeights(*weights, scene.mesh.points.size() / 3, scene.skeleton.joints.size(), maxInfluences, scene.skin, error)) { return false; }
+
+    const Json::Value* animation = description.Find("animation");
+    if (animation && !ReadAnimation(*animation, (uint32_t)scene.skeleton.joints.size() + 1, scene.animation, error)) { return false; }
+
+    return true;
+}
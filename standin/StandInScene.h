@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+#include "MeshArrays.h"
+#include "SkinWeights.h"
+#include "Skeleton.h"
+
+// @note Stand-in for the Maya scene, so the whole export pipeline can run (and be profiled) on Linux without Maya.
+// Either a plain .obj (static mesh) or a JSON description:
+//
+//  {
+//    "mesh":      "character.obj",                                   relative to the JSON file
+//    "skeleton":
+//    {
+//      "root":   { "name": "root", "bind": Transform },
+//      "joints": [ { "name": "hip", "parent": -1, "bind": Transform }, ... ]    parent -1 = the root, index order = influence ID
+//    },
+//    "weights":   [ [ [joint, weight], [joint, weight] ], ... ],     one list per OBJ vertex
+//    "animation": { "frameRate": 30, "frames": [ [ Transform, ... ], ... ] }   root first, then every joint
+//  }
+//
+//  Transform = { "position": [x, y, z], "rotation": [x, y, z, w], "scale": [x, y, z], "shear": [x, y, z] }, every key optional
+//
+struct StandInScene
+{
+    MeshArrays     mesh;
+    SkinInfluences skin;          // Empty for static meshes
+    Skeleton       skeleton;
+    AnimationClip  animation;     // frameCount 0 if the scene has no animation
+
+    bool Skinned() const { return !skin.Empty(); }
+};
+
+namespace StandInSceneLoader
+{
+    bool Load(const std::string& path, int maxInfluences, StandInScene& scene, std::string& error);
+}
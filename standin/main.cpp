@@ -0,0 +1,225 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <vector>
+
+#include "StandInScene.h"
+#include "MeshProcessor.h"
+#include "MOF_Writer.h"
+#include "MAF_Writer.h"
+#include "ExportReport.h"
+#include "MemoryTracker.h"
+
+// @note Runs the Maya-free half of the exporter on a stand-in scene (see StandInScene.h), with the same settings the
+// plugin window exposes. Handy to profile and debug the pipeline on Linux.
+//
+//  StandInExporter <scene.json | mesh.obj> <out.mof> [out.maf] [options]
+//
+static void PrintUsage()
+{
+    std::printf("Usage: StandInExporter <scene.json | mesh.obj> <out.mof> [out.maf] [options]\n"
+                "  --ascii            Ascii files instead of binary\n"
+                "  --dedup            Deduplicate the vertices\n"
+                "  --influences N     Max influences per vertex, 4 or 8\n"
+                "  --compact          Compact (quantized) vertex layout\n"
+                "  --optimize         Optimize the index buffer\n"
+                "  --v2               MOF v2 container (binary only)\n"
+                "  --threads N        Welding threads, 0 = every core\n"
+                "  --reduce [cm]      Keyframe reduction, MAF v2 tracks. Position tolerance, the rest scale with it (default 0.001)\n"
+                "  --compress [cm]    Quantized MAF v2 tracks. Object space error threshold (default 0.01)\n"
+                "  --rotation-bits N  Most bits per compressed rotation component, 4 to 20 (default 16)\n"
+                "  --segments N       Track-major MAF v2 blocks of N frames, without --reduce/--compress (binary only)\n"
+                "  --sample-rate F    Exported samples per second, fractional frames get interpolated (default the scene rate)\n"
+                "  --clips \"table\"    Clip table, \"walk 0 30 loop; run 31 60\" (ClipTable.h). One clip library, binary only\n"
+                "  --clip-files       A file per clip of the table, [out]_[clip].maf\n"
+                "  --palette          Skinning matrices of every joint and frame instead of the local transforms (binary only)\n"
+                "  --half-matrices    The palette in half floats\n"
+                "  --report           Stage timings and counters in <out.mof>.report.json\n");
+}
+
+
+static bool IsNumber(const char* arg)
+{
+    char* end = nullptr;
+    std::strtod(arg, &end);
+    return end != arg && *end == '\0';
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string             scenePath, meshPath, animationPath;
+    MeshExportSettings      settings;
+    AnimationExportSettings animationSettings;
+    bool                    ascii = false;
+    std::string             clipTable;
+
+    for (int a = 1; a < argc; a++)
+    {
+        const char* arg = argv[a];
+
+        if      (!std::strcmp(arg, "--ascii"))                      { ascii                 = true; }
+        else if (!std::strcmp(arg, "--dedup"))                      { settings.deduplicate  = true; }
+        else if (!std::strcmp(arg, "--compact"))                    { settings.vertexLayout = VertexLayout::Compact; }
+        else if (!std::strcmp(arg, "--optimize"))                   { settings.optimizeIndices = true; }
+        else if (!std::strcmp(arg, "--v2"))                         { settings.chunkedFile  = true; }
+        else if (!std::strcmp(arg, "--report"))                     { settings.writeReport  = true; }
+        else if (!std::strcmp(arg, "--influences") && a + 1 < argc) { settings.maxInfluences = std::atoi(argv[++a]); }
+        else if (!std::strcmp(arg, "--threads")    && a + 1 < argc) { settings.threadCount   = (unsigned int)std::atoi(argv[++a]); }
+        else if (!std::strcmp(arg, "--reduce"))
+        {
+            animationSettings.deduplicate = true;
+
+            // Optional position tolerance, the rotation and scale ones keep their default ratio to it
+            if (a + 1 < argc && IsNumber(argv[a + 1]))
+            {
+                KeyframeReducer::Tolerance defaults;
+                float                      position = (float)std::atof(argv[++a]);
+
+                animationSettings.keyTolerance.position = position;
+                animationSettings.keyTolerance.rotation = defaults.rotation * position / defaults.position;
+                animationSettings.keyTolerance.scale    = defaults.scale    * position / defaults.position;
+            }
+        }
+        else if (!std::strcmp(arg, "--compress"))
+        {
+            animationSettings.compress = true;
+            if (a + 1 < argc && IsNumber(argv[a + 1])) { animationSettings.compression.threshold = (float)std::atof(argv[++a]); }
+        }
+        else if (!std::strcmp(arg, "--rotation-bits") && a + 1 < argc) { animationSettings.compression.rotationBits = std::atoi(argv[++a]); }
+        else if (!std::strcmp(arg, "--segments")      && a + 1 < argc) { animationSettings.segmentFrames = (uint32_t)std::atoi(argv[++a]); }
+        else if (!std::strcmp(arg, "--clips")         && a + 1 < argc) { clipTable = argv[++a]; }
+        else if (!std::strcmp(arg, "--sample-rate")   && a + 1 < argc) { animationSettings.sampleRate = (float)std::atof(argv[++a]); }
+        else if (!std::strcmp(arg, "--clip-files"))                    { animationSettings.clipFiles = true; }
+        else if (!std::strcmp(arg, "--palette"))                       { animationSettings.matrixPalette = true; }
+        else if (!std::strcmp(arg, "--half-matrices"))                 { animationSettings.halfMatrices = true; }
+        else if (arg[0] == '-')                                     { PrintUsage(); return 1; }
+        else if (scenePath.empty())                                 { scenePath     = arg; }
+        else if (meshPath.empty())                                  { meshPath      = arg; }
+        else if (animationPath.empty())                             { animationPath = arg; }
+        else                                                        { PrintUsage(); return 1; }
+    }
+
+    if (scenePath.empty() || meshPath.empty()) { PrintUsage(); return 1; }
+
+    ExportReport        report;
+    ExportReport::Scope reportScope(report);
+    report.SetInfo("exporter", "StandIn");
+    report.SetInfo("scene",    scenePath);
+    report.SetInfo("file",     meshPath);
+
+    // ==========================================================================================================
+    // Scene
+    // ==========================================================================================================
+    StandInScene scene;
+    std::string  error;
+    {
+        ExportReport::ScopedTimer timer("extract");
+        if (!StandInSceneLoader::Load(scenePath, settings.maxInfluences, scene, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    // ==========================================================================================================
+    // Mesh
+    // ==========================================================================================================
+    MeshData          mesh;
+    MeshProcessReport processReport;
+    MeshProcessor::Process(scene.mesh, std::move(scene.skin), settings, mesh, processReport);
+    scene.mesh = MeshArrays{};
+
+    if (processReport.optimized)       { std::printf("Index buffer optimized in %.4f seconds | ACMR [ %.3f -> %.3f ] | ATVR [ %.3f -> %.3f ]\n", processReport.optimizeSeconds, processReport.cacheBefore.acmr, processReport.cacheAfter.acmr, processReport.cacheBefore.atvr, processReport.cacheAfter.atvr); }
+    if (processReport.compactFallback) { std::printf("The skin has too many influences for 8 bit joint IDs, the mesh is going to be written with the float layout\n"); }
+
+    const Skeleton* skeleton = mesh.Skinned() ? &scene.skeleton : nullptr;
+    bool            written  = false;
+
+    if      (ascii)                { written = MOF_Writer::WriteAscii  (meshPath, mesh, skeleton); }
+    else if (settings.chunkedFile) { written = MOF_Writer::WriteChunked(meshPath, mesh, skeleton); }
+    else                           { written = MOF_Writer::WriteBinary (meshPath, mesh, skeleton); }
+
+    if (!written) { std::fprintf(stderr, "Couldn't write %s\n", meshPath.c_str()); return 1; }
+
+    // ==========================================================================================================
+    // Animation
+    // ==========================================================================================================
+    if (!animationPath.empty())
+    {
+        if (scene.animation.frameCount == 0) { std::fprintf(stderr, "%s has no animation\n", scenePath.c_str()); return 1; }
+
+        if (!ClipTable::Parse(clipTable, animationSettings.clips, error)) { std::fprintf(stderr, "%s\n", error.c_str()); return 1; }
+
+        // The palettes against the bind pose of the scene skeleton, in clip order like the plugin
+        std::vector<Affine> inverseBind;
+        if (animationSettings.matrixPalette && !ascii)
+        {
+            std::vector<Transform> bindPose(scene.skeleton.joints.size() + 1);
+            bindPose[0] = scene.skeleton.rootBindPose;
+            for (size_t j = 0; j < scene.skeleton.joints.size(); j++) { bindPose[j + 1] = scene.skeleton.joints[j].bindPose; }
+
+            MatrixPalette::InverseBind(bindPose, scene.skeleton.ClipParents(), inverseBind);
+        }
+
+        const double   sceneRate   = scene.animation.frameRate;
+        const double   sampleRate  = animationSettings.sampleRate > 0.0f ? (double)animationSettings.sampleRate : sceneRate;
+        const uint32_t sceneFrames = scene.animation.frameCount;
+
+        ClipRange whole;
+        whole.end = (int32_t)sceneFrames - 1;
+
+        // The stand-in timeline is already sampled from frame 0, the sample times (the union of the clip ones with a clip
+        // table) get resampled out of it, where the plugin would evaluate the scene at them
+        std::vector<double> times = animationSettings.clips.empty() ? ClipTable::SampleTimes(whole, sceneRate, sampleRate)
+                                                                    : ClipTable::UnionTimes(animationSettings.clips, sceneRate, sampleRate);
+        if (times.front() < 0.0 || times.back() > (double)(sceneFrames - 1)) { std::fprintf(stderr, "The clip table goes outside of the [ %u ] frames of the scene\n", sceneFrames); return 1; }
+
+        AnimationClip sampled;
+        if (animationSettings.clips.empty() && sampleRate == sceneRate)
+        {
+            sampled = std::move(scene.animation);
+        }
+        else
+        {
+            sampled.frameRate = (float)sampleRate;
+            ClipTable::Resample(scene.animation, times, sampled);
+            scene.animation = AnimationClip{};
+
+            if (animationSettings.clips.empty()) { std::printf("Resampled [ %u ] frames at %.3f fps to [ %u ] at %.3f fps\n", sceneFrames, sceneRate, sampled.frameCount, sampleRate); }
+        }
+
+        // Same dispatch as the plugin, no curve joints in a stand-in scene
+        std::vector<ClipWriteReport> clipReports;
+        written = MAF_Writer::WriteAnimation(sampled, times, sceneRate, sampleRate, scene.skeleton.ClipParents(), animationSettings, !ascii, animationPath, {}, inverseBind, clipReports, settings.threadCount);
+
+        for (const ClipWriteReport& clipReport : clipReports)
+        {
+            if (!clipReport.range.name.empty()) { std::printf("Clip [ %s ] frames [ %d - %d ]%s\n", clipReport.range.name.c_str(), clipReport.range.start, clipReport.range.end, clipReport.range.loop ? " loop" : ""); }
+
+            switch (clipReport.encoding)
+            {
+                case ClipEncoding::Palette:    std::printf("Baked [ %zu ] %s skinning matrices\n", clipReport.matrices, animationSettings.halfMatrices ? "half" : "float"); break;
+                case ClipEncoding::Reduced:    std::printf("Reduced [ %u ] frames to [ %zu ] keys in [ %zu ] tracks\n", clipReport.frameCount, clipReport.keys, clipReport.tracks); break;
+                case ClipEncoding::Compressed: std::printf("Reduced [ %u ] frames to [ %zu ] keys in [ %zu ] tracks, compressed to [ %zu ] bytes | max object space error %.5f\n", clipReport.frameCount, clipReport.keys, clipReport.tracks, clipReport.quantizedBytes, clipReport.maxError); break;
+                case ClipEncoding::Segmented:  std::printf("Segments of [ %u ] frames\n", animationSettings.segmentFrames); break;
+                default:                       break;
+            }
+        }
+
+        if (!written) { std::fprintf(stderr, "Couldn't write %s\n", animationPath.c_str()); return 1; }
+
+        report.SetCount("frames", sceneFrames);
+    }
+
+    if (mesh.Skinned()) { report.SetCount("joints", scene.skeleton.joints.size() + 1); }
+
+    std::printf("Exported [ %zu ] vertices ( %zu duplicated ) and [ %zu ] triangles in %.4f seconds | %llu bytes | %.1f MB peak\n", mesh.vertices.size(), processReport.duplicated, mesh.indices.size() / 3, report.TotalSeconds(), (unsigned long long)report.GetCount("bytes_written"), MemoryTracker::ProcessPeakBytes() / 1e6);
+
+    if (settings.writeReport && !report.SaveJson(meshPath + ".report.json")) { std::fprintf(stderr, "Couldn't write %s.report.json\n", meshPath.c_str()); return 1; }
+
+    return 0;
+}